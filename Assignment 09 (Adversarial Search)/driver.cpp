@@ -0,0 +1,150 @@
+/*!*****************************************************************************
+\file	driver.cpp
+\author Jie Le Jet Ang
+\par	DP email: jielejet.ang\@digipen.edu.sg
+\par	Course: CS3183
+\par	Section: A
+\par	Programming Assignment 9
+\date	10-18-2026
+
+\brief
+		Driver for the additions to the adversarial search. Checks compare them
+		with the minimax<T> search they stand in for. Build it with the other
+		files of the assignment and its data.h; run it with no arguments for
+		every check, or with the names of the checks to run. The exit code is
+		the number of failed checks.
+*******************************************************************************/
+#include "perfect_play.h"
+#include "tree_export.h"
+
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+using namespace AI;
+
+namespace
+{
+	/*!*****************************************************************************
+	\brief
+		Checks the compile-time perfect-play table against minimax<Grid> on
+		every board, printing every mismatch.
+	\return
+		True if the table matches everywhere.
+	*******************************************************************************/
+	bool checkPerfect()
+	{
+		return PerfectPlay::verify(&std::cout) == 0;
+	}
+
+	/*!*****************************************************************************
+	\brief
+		Writes a tree in preorder in the text format of Move<T>::operator<<,
+		optionally with the spot and pruned flag of every node.
+	\param move
+		Root of the tree.
+	\param os
+		Text output stream.
+	\param details
+		Whether to add the spot and pruned flag.
+	*******************************************************************************/
+	void dump(const Move<Grid>& move, std::ostream& os, bool details)
+	{
+		os << move;
+		if (details)
+			os << move.getSpotIndex() << ' ' << move.isPruned() << '\n';
+		for (int i = 0; i < move.getNextCount(); ++i)
+			dump(move.at(i), os, details);
+	}
+
+	/*!*****************************************************************************
+	\brief
+		Checks the binary export on the alpha-beta tree of the empty board: the
+		imported tree and the text conversion must match the original, and a
+		dump that is cut short or has a wrong signature must not import.
+	\return
+		True if the round trip matches and every damaged dump is refused.
+	*******************************************************************************/
+	bool checkExport()
+	{
+		Move<Grid>* root = alpha_beta_pruning_all_branches(Grid{}, Grid::x, Grid::x, Grid::o, INT_MIN, INT_MAX);
+		std::ostringstream binary, expected, expectedDetails;
+		exportTree(binary, *root);
+		dump(*root, expected, false);
+		dump(*root, expectedDetails, true);
+		delete root;
+		const std::string bytes = binary.str();
+
+		std::istringstream is(bytes);
+		Move<Grid>* imported = importTree<Grid>(is);
+		if (!imported)
+			return false;
+		std::ostringstream importedDetails;
+		dump(*imported, importedDetails, true);
+		delete imported;
+
+		std::istringstream textInput(bytes);
+		std::ostringstream text;
+		binaryToText<Grid>(textInput, text);
+		if (importedDetails.str() != expectedDetails.str() || text.str() != expected.str())
+			return false;
+
+		for (std::size_t length = 0; length < bytes.size(); length += length < 64 ? 1 : 997)
+		{
+			std::istringstream truncated(bytes.substr(0, length));
+			Move<Grid>* partial = importTree<Grid>(truncated);
+			if (partial)
+			{
+				delete partial;
+				return false;
+			}
+		}
+		std::istringstream last(bytes.substr(0, bytes.size() - 1)), signature(std::string("BAD!") + bytes.substr(4));
+		Move<Grid>* partial = importTree<Grid>(last);
+		Move<Grid>* wrong = importTree<Grid>(signature);
+		bool refused = !partial && !wrong;
+		delete partial;
+		delete wrong;
+		return refused;
+	}
+
+	// A check of the driver
+	struct Test
+	{
+		const char* name;
+		bool (*run)();
+	};
+
+	const Test TESTS[] = {
+		{ "perfect", &checkPerfect },
+		{ "export", &checkExport },
+	};
+}
+
+/*!*****************************************************************************
+\brief
+	Runs every check, or the checks named on the command line, and prints the
+	result of every check.
+\param argc
+	Number of arguments.
+\param argv
+	The arguments.
+\return
+	Number of failed checks.
+*******************************************************************************/
+int main(int argc, char* argv[])
+{
+	int failed = 0;
+	for (const Test& test : TESTS)
+	{
+		bool named = argc == 1;
+		for (int a = 1; a < argc; ++a)
+			named = named || std::strcmp(argv[a], test.name) == 0;
+		if (!named)
+			continue;
+		bool passed = test.run();
+		std::cout << test.name << ": " << (passed ? "passed" : "FAILED") << "\n";
+		failed += passed ? 0 : 1;
+	}
+	return failed;
+}
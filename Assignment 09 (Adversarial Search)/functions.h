@@ -93,6 +93,19 @@ public:
 		squares[i] = c;
 	}
 
+	/*!*****************************************************************************
+	\brief
+		Returns the value of a specific cell in the grid.
+	\param i
+		The index of the cell (0-8).
+	\return
+		The character in the cell ('x', 'o', or ' ').
+	*******************************************************************************/
+	char get(int i) const
+	{
+		return squares[i];
+	}
+
     /*!*****************************************************************************
     \brief
         Clears a specific cell in the grid, setting it to empty.
@@ -207,6 +220,7 @@ namespace AI
 		std::vector<Move*>* next;  // All possible next moves
 		int bestMove;   // Index of the first move in member next that has the best score 
 		int spotIndex;  // Index of the move's spot (used for a visualization)
+		bool pruned;    // The move was cut off by alpha-beta pruning and not searched
 
 	public:
 		/*!*****************************************************************************
@@ -222,7 +236,7 @@ namespace AI
 			Index of the best move in the next list.
 		*******************************************************************************/
 		Move(T grid = {}, int score = 0, std::vector<Move*>* next = new std::vector<Move*>{}, int bestMove = -1)
-			: grid{ grid }, score{ score }, next{ next }, bestMove{ bestMove }, spotIndex{ -1 }
+			: grid{ grid }, score{ score }, next{ next }, bestMove{ bestMove }, spotIndex{ -1 }, pruned{ false }
 		{
 		}
 
@@ -254,6 +268,45 @@ namespace AI
 			return dummy;
 		}
 
+		/*!*****************************************************************************
+		\brief
+			Accesses the i-th move in the next moves list.
+		\param i
+			Index of the move to access.
+		\return
+			Reference to the Move at position i, or a static dummy object if out of range.
+		*******************************************************************************/
+		const Move& at(int i) const
+		{
+			if (i >= 0 && i < static_cast<int>(next->size()))
+				return *(*next)[i];
+			// Return a dummy static object on bad index
+			static const Move dummy;
+			return dummy;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the game state after this move.
+		\return
+			The move's grid.
+		*******************************************************************************/
+		const T& getGrid() const
+		{
+			return grid;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the number of possible next moves.
+		\return
+			Size of the next moves list.
+		*******************************************************************************/
+		int getNextCount() const
+		{
+			return static_cast<int>(next->size());
+		}
+
 		/*!*****************************************************************************
 		\brief
 			Returns the score for this move.
@@ -265,6 +318,28 @@ namespace AI
 			return score;
 		}
 
+		/*!*****************************************************************************
+		\brief
+			Returns the index of the best move in the next moves list.
+		\return
+			Index of the best move, or -1 for a terminal move.
+		*******************************************************************************/
+		int getBestMove() const
+		{
+			return bestMove;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the spot index (board position) where this move was made.
+		\return
+			Board index (0-8), or -1 for the root.
+		*******************************************************************************/
+		int getSpotIndex() const
+		{
+			return spotIndex;
+		}
+
 		/*!*****************************************************************************
 		\brief
 			Sets the spot index (board position) where this move was made.
@@ -276,6 +351,28 @@ namespace AI
 			spotIndex = i;
 		}
 
+		/*!*****************************************************************************
+		\brief
+			Returns whether this move was cut off by alpha-beta pruning.
+		\return
+			True for a pruned (unsearched) move.
+		*******************************************************************************/
+		bool isPruned() const
+		{
+			return pruned;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Marks this move as cut off by alpha-beta pruning.
+		\param p
+			True for a pruned (unsearched) move.
+		*******************************************************************************/
+		void setPruned(bool p)
+		{
+			pruned = p;
+		}
+
 		/*!*****************************************************************************
 		\brief
 			Stream insertion operator for pretty-printing a Move object.
@@ -387,10 +484,10 @@ namespace AI
 			if (pruned && !child)
 			{
 				// Create a dummy node representing a pruned branch.
-				// You may wish to add a "pruned" flag to your Move class.
 				// Here, score is just set to alpha or beta as appropriate.
 				int prunedScore = (player == maximizer) ? alpha : beta;
 				child = new Move<T>(newGrid, prunedScore, new std::vector<Move<T>*>(), -1);
+				child->setPruned(true);
 			}
 
 			child->setSpotIndex(spot);
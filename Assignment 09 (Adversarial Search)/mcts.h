@@ -0,0 +1,581 @@
+/*!*****************************************************************************
+\file	mcts.h
+\author Jie Le Jet Ang
+\par	DP email: jielejet.ang\@digipen.edu.sg
+\par	Course: CS3183
+\par	Section: A
+\par	Programming Assignment 9
+\date	10-18-2026
+
+\brief
+		This file contains a Monte Carlo Tree Search (UCT) engine for boards where
+		a full minimax search is too expensive. The engine works with the same
+		Grid-style state interface as minimax<T> (set, emptyIndices, winning and
+		copy construction), allocates its nodes from a pool, searches for a fixed
+		time budget per move, runs playouts on several threads using root
+		parallelization and keeps the searched subtree between consecutive moves.
+*******************************************************************************/
+#ifndef MCTS_H
+#define MCTS_H
+
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <utility>
+
+namespace AI
+{
+	/*!*****************************************************************************
+	\class MCTS
+	\brief
+		UCT search over game states of type T. Every worker thread owns a separate
+		tree (root parallelization), so no locking is needed while searching; the
+		root statistics of all workers are merged to pick the move.
+	\typeparam T
+		The type of the game state (e.g., Grid).
+	*******************************************************************************/
+	template<typename T>
+	class MCTS
+	{
+	public:
+		// Search settings
+		struct Config
+		{
+			int timeBudgetMs = 100;			// Time to search for one move
+			int maxIterations = 0;			// Playouts per worker, 0 means until the time budget runs out
+			int threads = 1;				// Number of workers (root parallelization)
+			std::size_t poolSize = 1 << 16;	// Node capacity of every worker's pool
+			double exploration = 1.41421356;// UCT exploration constant
+			std::uint64_t seed = 0x9E3779B97F4A7C15ull;
+		};
+
+		// Statistics of the last search
+		struct Stats
+		{
+			long long playouts = 0;		// Playouts of all workers
+			std::size_t nodes = 0;		// Nodes in use of all workers
+		};
+
+	private:
+		// A node of a search tree. Children of a node are allocated together and
+		// are contiguous in the pool.
+		struct Node
+		{
+			int parent;			// Index of the parent node, -1 for the root
+			int firstChild;		// Index of the first child, -1 while not expanded
+			int numChildren;	// Number of children
+			int spot;			// Board index of the move that leads to this node
+			int visits;			// Number of playouts through this node
+			double wins;		// Reward for the player who made the move into this node
+		};
+
+		// Bump allocator for the nodes of one tree
+		class NodePool
+		{
+			std::vector<Node> nodes;
+			std::size_t capacity;
+
+		public:
+			/*!*****************************************************************************
+			\brief
+				Constructs an empty pool that can hold capacity nodes.
+			\param capacity
+				Maximum number of nodes.
+			*******************************************************************************/
+			explicit NodePool(std::size_t capacity = 0)
+				: nodes{}, capacity{ capacity }
+			{
+				nodes.reserve(capacity);
+			}
+
+			/*!*****************************************************************************
+			\brief
+				Allocates count contiguous nodes.
+			\param count
+				Number of nodes to allocate.
+			\return
+				Index of the first node, or -1 if the pool is full.
+			*******************************************************************************/
+			int allocate(int count)
+			{
+				if (nodes.size() + count > capacity)
+					return -1;
+				int first = static_cast<int>(nodes.size());
+				nodes.resize(nodes.size() + count);
+				return first;
+			}
+
+			/*!*****************************************************************************
+			\brief
+				Releases all nodes.
+			*******************************************************************************/
+			void clear()
+			{
+				nodes.clear();
+			}
+
+			/*!*****************************************************************************
+			\brief
+				Accesses the node at index i.
+			\param i
+				Index of the node.
+			\return
+				Reference to the node.
+			*******************************************************************************/
+			Node& operator[](int i)
+			{
+				return nodes[i];
+			}
+
+			/*!*****************************************************************************
+			\brief
+				Returns the number of nodes in use.
+			\return
+				Number of allocated nodes.
+			*******************************************************************************/
+			std::size_t size() const
+			{
+				return nodes.size();
+			}
+
+			/*!*****************************************************************************
+			\brief
+				Swaps the contents of two pools.
+			\param rhs
+				Pool to swap with.
+			*******************************************************************************/
+			void swap(NodePool& rhs)
+			{
+				nodes.swap(rhs.nodes);
+				std::swap(capacity, rhs.capacity);
+			}
+		};
+
+		// One independent search of root parallelization
+		struct Worker
+		{
+			NodePool pool;
+			std::uint64_t rng;
+			long long playouts;
+		};
+
+		Config config;
+		char maximizer;
+		char minimizer;
+		T rootGrid;			// State at the root of every worker's tree
+		char rootPlayer;	// Player to move at the root
+		std::vector<Worker> workers;
+		Stats stats;
+
+		/*!*****************************************************************************
+		\brief
+			Returns the next pseudo-random number of a worker (xorshift64*).
+		\param state
+			The worker's generator state.
+		\return
+			A pseudo-random 64-bit value.
+		*******************************************************************************/
+		static std::uint64_t nextRandom(std::uint64_t& state)
+		{
+			state ^= state >> 12;
+			state ^= state << 25;
+			state ^= state >> 27;
+			return state * 0x2545F4914F6CDD1Dull;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the opponent of the given player.
+		\param player
+			The player ('x' or 'o').
+		\return
+			The other player.
+		*******************************************************************************/
+		char opponent(char player) const
+		{
+			return player == maximizer ? minimizer : maximizer;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Checks whether the game is over.
+		\param grid
+			State to check.
+		\param winner
+			Set to the winning player, or to 0 for a draw or unfinished game.
+		\return
+			True if the state is terminal.
+		*******************************************************************************/
+		bool terminal(T& grid, char& winner) const
+		{
+			winner = 0;
+			if (grid.winning(maximizer))
+				winner = maximizer;
+			else if (grid.winning(minimizer))
+				winner = minimizer;
+			else if (!grid.emptyIndices().empty())
+				return false;
+			return true;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Creates the root node of a worker's tree.
+		\param w
+			The worker.
+		*******************************************************************************/
+		void createRoot(Worker& w)
+		{
+			w.pool.clear();
+			int root = w.pool.allocate(1);
+			w.pool[root] = Node{ -1, -1, 0, -1, 0, 0.0 };
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Allocates the children of a leaf node, one per empty square.
+		\param w
+			The worker owning the tree.
+		\param node
+			Index of the node to expand.
+		\param grid
+			State at the node.
+		*******************************************************************************/
+		void expand(Worker& w, int node, const T& grid)
+		{
+			std::vector<int> empties = grid.emptyIndices();
+			int first = w.pool.allocate(static_cast<int>(empties.size()));
+			if (first < 0)
+				return; // Pool is full: keep playing out from this leaf
+			for (int i = 0; i < static_cast<int>(empties.size()); ++i)
+				w.pool[first + i] = Node{ node, -1, 0, empties[i], 0, 0.0 };
+			w.pool[node].firstChild = first;
+			w.pool[node].numChildren = static_cast<int>(empties.size());
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Selects the child of a node with the highest UCT value. Unvisited
+			children are taken first.
+		\param w
+			The worker owning the tree.
+		\param node
+			Index of the parent node.
+		\return
+			Index of the selected child.
+		*******************************************************************************/
+		int select(Worker& w, int node) const
+		{
+			const Node& parent = w.pool[node];
+			double logVisits = std::log(static_cast<double>(parent.visits));
+			int best = parent.firstChild;
+			double bestValue = -1.0;
+			for (int c = parent.firstChild; c < parent.firstChild + parent.numChildren; ++c)
+			{
+				const Node& child = w.pool[c];
+				if (child.visits == 0)
+					return c;
+				double value = child.wins / child.visits
+					+ config.exploration * std::sqrt(logVisits / child.visits);
+				if (value > bestValue)
+				{
+					bestValue = value;
+					best = c;
+				}
+			}
+			return best;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Plays random moves until the game is over.
+		\param w
+			The worker (its generator is used).
+		\param grid
+			State to play out from; modified in place.
+		\param player
+			Player to move.
+		\return
+			The winning player, or 0 for a draw.
+		*******************************************************************************/
+		char playout(Worker& w, T& grid, char player) const
+		{
+			char winner;
+			while (!terminal(grid, winner))
+			{
+				std::vector<int> empties = grid.emptyIndices();
+				grid.set(empties[nextRandom(w.rng) % empties.size()], player);
+				player = opponent(player);
+			}
+			return winner;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Runs one iteration (selection, expansion, playout, backpropagation) on
+			a worker's tree.
+		\param w
+			The worker.
+		*******************************************************************************/
+		void iterate(Worker& w)
+		{
+			T grid = rootGrid;
+			char player = rootPlayer;
+			int node = 0;
+			char winner;
+
+			// Selection
+			while (w.pool[node].numChildren > 0)
+			{
+				node = select(w, node);
+				grid.set(w.pool[node].spot, player);
+				player = opponent(player);
+			}
+
+			// Expansion
+			if (!terminal(grid, winner) && w.pool[node].visits > 0)
+			{
+				expand(w, node, grid);
+				if (w.pool[node].numChildren > 0)
+				{
+					node = select(w, node);
+					grid.set(w.pool[node].spot, player);
+					player = opponent(player);
+				}
+			}
+
+			// Simulation
+			winner = playout(w, grid, player);
+
+			// Backpropagation; the move into a node was made by the opponent of
+			// the player to move at that node
+			while (node >= 0)
+			{
+				Node& n = w.pool[node];
+				char mover = opponent(player);
+				++n.visits;
+				if (winner == mover)
+					n.wins += 1.0;
+				else if (winner == 0)
+					n.wins += 0.5;
+				player = mover;
+				node = n.parent;
+			}
+			++w.playouts;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Searches a worker's tree until the deadline or the iteration limit.
+		\param w
+			The worker.
+		\param deadline
+			Time at which the search stops.
+		*******************************************************************************/
+		void run(Worker& w, std::chrono::steady_clock::time_point deadline)
+		{
+			w.playouts = 0;
+			for (long long i = 0; config.maxIterations <= 0 || i < config.maxIterations; ++i)
+			{
+				// Reading the clock is not free: check it every few playouts
+				if ((i & 15) == 0 && std::chrono::steady_clock::now() >= deadline)
+					break;
+				iterate(w);
+			}
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Copies the subtree of a node into a new pool so that it becomes the
+			root of the worker's tree. Everything else is released.
+		\param w
+			The worker.
+		\param node
+			Index of the node that becomes the root.
+		*******************************************************************************/
+		void reroot(Worker& w, int node)
+		{
+			NodePool fresh(config.poolSize);
+			int root = fresh.allocate(1);
+			fresh[root] = w.pool[node];
+			fresh[root].parent = -1;
+			fresh[root].spot = -1;
+
+			// Breadth-first copy keeps the children of a node contiguous
+			std::vector<std::pair<int, int>> queue{ { node, root } };
+			for (std::size_t q = 0; q < queue.size(); ++q)
+			{
+				const Node& from = w.pool[queue[q].first];
+				int to = queue[q].second;
+				if (from.numChildren == 0)
+					continue;
+				int first = fresh.allocate(from.numChildren);
+				fresh[to].firstChild = first;
+				for (int i = 0; i < from.numChildren; ++i)
+				{
+					fresh[first + i] = w.pool[from.firstChild + i];
+					fresh[first + i].parent = to;
+					queue.push_back({ from.firstChild + i, first + i });
+				}
+			}
+			w.pool.swap(fresh);
+		}
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Constructs an MCTS engine.
+		\param maximizer
+			The player the engine searches for (usually 'x' or 'o').
+		\param minimizer
+			The opponent.
+		\param config
+			Search settings.
+		*******************************************************************************/
+		MCTS(char maximizer, char minimizer, Config config = {})
+			: config{ config }, maximizer{ maximizer }, minimizer{ minimizer },
+			rootGrid{}, rootPlayer{ maximizer }, workers{}, stats{}
+		{
+			int count = config.threads > 0 ? config.threads : 1;
+			for (int i = 0; i < count; ++i)
+			{
+				std::uint64_t seed = config.seed + 0x9E3779B97F4A7C15ull * (i + 1);
+				workers.push_back(Worker{ NodePool(config.poolSize), seed ? seed : 1, 0 });
+				createRoot(workers.back());
+			}
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Discards the trees and starts a new search at the given state.
+		\param grid
+			Current game state.
+		\param player
+			The player to move.
+		*******************************************************************************/
+		void reset(const T& grid, char player)
+		{
+			rootGrid = grid;
+			rootPlayer = player;
+			for (Worker& w : workers)
+				createRoot(w);
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Applies a played move (by either player) to the root. The subtree below
+			the move is kept, so the statistics gathered for it are reused by the
+			next search.
+		\param spot
+			Board index of the played move.
+		\return
+			True if the subtree was reused, false if the tree was started anew.
+		*******************************************************************************/
+		bool advance(int spot)
+		{
+			rootGrid.set(spot, rootPlayer);
+			rootPlayer = opponent(rootPlayer);
+
+			bool reused = true;
+			for (Worker& w : workers)
+			{
+				int child = -1;
+				const Node& root = w.pool[0];
+				for (int c = root.firstChild; c >= 0 && c < root.firstChild + root.numChildren; ++c)
+					if (w.pool[c].spot == spot)
+						child = c;
+				if (child >= 0)
+					reroot(w, child);
+				else
+				{
+					createRoot(w);
+					reused = false;
+				}
+			}
+			return reused;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Searches from the current root for the configured time budget and
+			returns the most visited move over all workers.
+		\return
+			Board index of the best move, or -1 if the game is over.
+		*******************************************************************************/
+		int search()
+		{
+			char winner;
+			T grid = rootGrid;
+			if (terminal(grid, winner))
+				return -1;
+
+			auto deadline = std::chrono::steady_clock::now()
+				+ std::chrono::milliseconds(config.timeBudgetMs);
+
+			std::vector<std::thread> threads;
+			for (std::size_t i = 1; i < workers.size(); ++i)
+				threads.emplace_back([this, i, deadline] { run(workers[i], deadline); });
+			run(workers[0], deadline);
+			for (std::thread& t : threads)
+				t.join();
+
+			// Merge the root children of all workers by the spot of their move
+			std::map<int, long long> visits;
+			stats = Stats{};
+			for (Worker& w : workers)
+			{
+				const Node& root = w.pool[0];
+				for (int c = root.firstChild; c >= 0 && c < root.firstChild + root.numChildren; ++c)
+					visits[w.pool[c].spot] += w.pool[c].visits;
+				stats.playouts += w.playouts;
+				stats.nodes += w.pool.size();
+			}
+
+			int bestSpot = -1;
+			long long bestVisits = -1;
+			for (auto& v : visits)
+				if (v.second > bestVisits)
+				{
+					bestVisits = v.second;
+					bestSpot = v.first;
+				}
+
+			// Nothing expanded yet (e.g. tiny budget): fall back to any legal move
+			if (bestSpot < 0)
+				bestSpot = grid.emptyIndices().front();
+			return bestSpot;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Starts a new search at the given state and returns the best move.
+		\param grid
+			Current game state.
+		\param player
+			The player to move.
+		\return
+			Board index of the best move, or -1 if the game is over.
+		*******************************************************************************/
+		int search(const T& grid, char player)
+		{
+			reset(grid, player);
+			return search();
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the statistics of the last search.
+		\return
+			Playout and node counts.
+		*******************************************************************************/
+		const Stats& getStats() const
+		{
+			return stats;
+		}
+	};
+} // end namespace
+
+#endif
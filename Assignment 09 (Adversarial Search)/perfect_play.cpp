@@ -0,0 +1,71 @@
+/*!*****************************************************************************
+\file	perfect_play.cpp
+\author Jie Le Jet Ang
+\par	DP email: jielejet.ang\@digipen.edu.sg
+\par	Course: CS3183
+\par	Section: A
+\par	Programming Assignment 9
+\date	10-18-2026
+
+\brief
+		This file contains the check of the compile-time perfect-play table
+		against the minimax<T> search.
+*******************************************************************************/
+#include "perfect_play.h"
+
+namespace AI
+{
+	namespace PerfectPlay
+	{
+		/*!*****************************************************************************
+		\brief
+			Compares the table with minimax<Grid> on every board that is not over
+			yet, for both players to move and both roles (maximizer and minimizer).
+		\param log
+			Optional stream that receives a line for every mismatch.
+		\return
+			Number of mismatching positions (0 if the table is correct).
+		*******************************************************************************/
+		int verify(std::ostream* log)
+		{
+			const char marks[3] = { Grid::_, Grid::x, Grid::o };
+			int mismatches = 0;
+
+			for (int index = 0; index < numBoards; ++index)
+			{
+				Grid grid;
+				for (int i = 0, rest = index; i < numSquares; ++i, rest /= 3)
+					grid.set(i, marks[rest % 3]);
+
+				if (grid.winning(Grid::x) || grid.winning(Grid::o) || grid.emptyIndices().empty())
+					continue;
+
+				// Both players to move, once as the maximizer and once as the minimizer
+				for (char player : { Grid::x, Grid::o })
+					for (bool maximizing : { true, false })
+					{
+						char opponent = player == Grid::x ? Grid::o : Grid::x;
+						char maximizer = maximizing ? player : opponent;
+						char minimizer = maximizing ? opponent : player;
+
+						Move<Grid>* root = minimax(grid, player, maximizer, minimizer);
+						int expectedSpot = root->at(root->getBestMove()).getSpotIndex();
+						int expectedScore = root->getScore();
+						delete root;
+
+						int score;
+						int spot = bestMove(grid, player, maximizer, minimizer, score);
+						if (spot != expectedSpot || score != expectedScore)
+						{
+							++mismatches;
+							if (log)
+								*log << grid << std::endl << player << " to move: table "
+								<< spot << "/" << score << ", minimax "
+								<< expectedSpot << "/" << expectedScore << std::endl;
+						}
+					}
+			}
+			return mismatches;
+		}
+	} // end namespace PerfectPlay
+} // end namespace
@@ -0,0 +1,217 @@
+/*!*****************************************************************************
+\file	perfect_play.h
+\author Jie Le Jet Ang
+\par	DP email: jielejet.ang\@digipen.edu.sg
+\par	Course: CS3183
+\par	Section: A
+\par	Programming Assignment 9
+\date	10-18-2026
+
+\brief
+		This file contains a perfect-play table for Tic-Tac-Toe that is solved at
+		compile time. All 3^9 boards are encoded in base 3 and solved for both
+		players to move, so the runtime decision for a Grid is a single indexed
+		load instead of a minimax call. Ties are broken the same way as
+		minimax<T> (the first empty square with the best score), so the table
+		gives the same move and score as the search.
+
+		Solving the table takes a few million constant-evaluation steps. GCC and
+		Clang accept this with their default limits; MSVC needs a higher limit,
+		e.g. /constexpr:steps10000000.
+*******************************************************************************/
+#ifndef PERFECT_PLAY_H
+#define PERFECT_PLAY_H
+
+#include "functions.h"
+
+namespace AI
+{
+	namespace PerfectPlay
+	{
+		// Number of boards (3^9) and squares of a board
+		constexpr int numBoards = 19683;
+		constexpr int numSquares = 9;
+
+		// Solved position: score for the player to move (+10 win, 0 draw, -10 loss)
+		// and the spot of the best move (-1 when the game is over)
+		struct Entry
+		{
+			signed char score = 0;
+			signed char spot = -1;
+		};
+
+		// Solved positions for 'x' to move ([0]) and 'o' to move ([1])
+		struct Table
+		{
+			Entry entries[2][numBoards] = {};
+		};
+
+		/*!*****************************************************************************
+		\brief
+			Returns the base-3 digit of a square: 0 empty, 1 'x', 2 'o'.
+		\param c
+			The character in the square.
+		\return
+			The digit of the square.
+		*******************************************************************************/
+		constexpr int digit(char c)
+		{
+			return c == Grid::x ? 1 : c == Grid::o ? 2 : 0;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Solves every board for both players to move. A move adds a digit to an
+			empty square, so every child has a larger index than its parent and
+			the boards can be solved from the last index down to the first. The
+			squares of every player are kept as 9-bit masks and the winning masks
+			are tabulated first, which keeps the number of constant-evaluation
+			steps low.
+		\return
+			The solved table.
+		*******************************************************************************/
+		constexpr Table generate()
+		{
+			constexpr int lines[8] = { 0007, 0070, 0700, 0111, 0222, 0444, 0421, 0124 };
+			bool winning[512] = {};
+			for (int mask = 0; mask < 512; ++mask)
+				for (int line : lines)
+					if ((mask & line) == line)
+						winning[mask] = true;
+
+			int pow3[numSquares] = {};
+			pow3[0] = 1;
+			for (int i = 1; i < numSquares; ++i)
+				pow3[i] = pow3[i - 1] * 3;
+
+			Table table{};
+			int squares[numSquares] = { 2, 2, 2, 2, 2, 2, 2, 2, 2 };
+			for (int index = numBoards - 1; index >= 0; --index)
+			{
+				int masks[3] = {};
+				for (int i = 0; i < numSquares; ++i)
+					masks[squares[i]] |= 1 << i;
+
+				for (int mover = 0; mover < 2; ++mover)
+				{
+					Entry& entry = table.entries[mover][index];
+					int self = mover + 1;
+					int other = 2 - mover;
+
+					// Terminal states; a board with two lines cannot be reached in play
+					if (winning[masks[other]])
+						entry = Entry{ -10, -1 };
+					else if (winning[masks[self]])
+						entry = Entry{ 10, -1 };
+					else if (masks[0] == 0)
+						entry = Entry{ 0, -1 };
+					else
+					{
+						int bestScore = -11;
+						int bestSpot = -1;
+						for (int i = 0; i < numSquares; ++i)
+						{
+							if (squares[i] != 0)
+								continue;
+							int score = -table.entries[1 - mover][index + self * pow3[i]].score;
+							if (score > bestScore)
+							{
+								bestScore = score;
+								bestSpot = i;
+							}
+						}
+						entry = Entry{ static_cast<signed char>(bestScore), static_cast<signed char>(bestSpot) };
+					}
+				}
+
+				// Digits of the next (smaller) index
+				for (int i = 0; i < numSquares && squares[i]-- == 0; ++i)
+					squares[i] = 2;
+			}
+			return table;
+		}
+
+		// The table, solved by the compiler
+		inline constexpr Table table = generate();
+
+		/*!*****************************************************************************
+		\brief
+			Computes the base-3 index of a grid.
+		\param grid
+			Game state.
+		\return
+			Index of the grid in the table.
+		*******************************************************************************/
+		inline int index(const Grid& grid)
+		{
+			int result = 0;
+			for (int i = numSquares - 1; i >= 0; --i)
+				result = result * 3 + digit(grid.get(i));
+			return result;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Looks up the best move for the player to move.
+		\param grid
+			Current game state.
+		\param player
+			The player making the move this turn ('x' or 'o').
+		\return
+			The solved entry; its score is for the player to move.
+		*******************************************************************************/
+		inline Entry lookup(const Grid& grid, char player)
+		{
+			return table.entries[player == Grid::x ? 0 : 1][index(grid)];
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the move and score minimax<T> would compute for the state, using
+			only the table.
+		\param grid
+			Current game state.
+		\param player
+			The player making the move this turn.
+		\param maximizer
+			The maximizing player.
+		\param minimizer
+			The minimizing player.
+		\param score
+			Set to the score for the maximizer (+10, 0 or -10).
+		\return
+			Board index of the best move, or -1 if the game is over.
+		*******************************************************************************/
+		inline int bestMove(Grid grid, char player, char maximizer, char minimizer, int& score)
+		{
+			// Same terminal test order as minimax
+			if (grid.winning(maximizer))
+			{
+				score = 10;
+				return -1;
+			}
+			if (grid.winning(minimizer))
+			{
+				score = -10;
+				return -1;
+			}
+
+			Entry entry = lookup(grid, player);
+			score = player == maximizer ? entry.score : -entry.score;
+			return entry.spot;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Compares the table with minimax<Grid> on every board that is not over
+			yet, for both players to move and both roles (maximizer and minimizer).
+		\param log
+			Optional stream that receives a line for every mismatch.
+		\return
+			Number of mismatching positions (0 if the table is correct).
+		*******************************************************************************/
+		int verify(std::ostream* log = nullptr);
+	} // end namespace PerfectPlay
+} // end namespace
+
+#endif
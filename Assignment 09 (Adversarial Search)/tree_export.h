@@ -0,0 +1,422 @@
+/*!*****************************************************************************
+\file	tree_export.h
+\author Jie Le Jet Ang
+\par	DP email: jielejet.ang\@digipen.edu.sg
+\par	Course: CS3183
+\par	Section: A
+\par	Programming Assignment 9
+\date	10-18-2026
+
+\brief
+		This file contains a compact binary export of Move<T> game trees for the
+		debugging viewer. Nodes are written in preorder with bit-packed boards,
+		scores delta-encoded against the parent's score, and a pruned-branch flag.
+		Trees are written and read as a stream, one node at a time, and a binary
+		dump can be converted back to the text format of Move<T>::operator<<.
+
+		Node record (all integers are LEB128 varints):
+			(number of next moves << 1) | pruned
+			best move + 1
+			spot index + 1
+			zigzag(score - parent's score)
+			board (BoardCodec<T>::bytes bytes)
+*******************************************************************************/
+#ifndef TREE_EXPORT_H
+#define TREE_EXPORT_H
+
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+#include "functions.h"
+
+namespace AI
+{
+	// Packs a game state into a fixed number of bytes. Specialize for every
+	// state type that is exported.
+	template<typename T>
+	struct BoardCodec;
+
+	// A Grid is a base-3 number with 9 digits (< 3^9), which fits in 2 bytes
+	template<>
+	struct BoardCodec<Grid>
+	{
+		static const int bytes = 2;
+
+		/*!*****************************************************************************
+		\brief
+			Packs a grid into 2 bytes.
+		\param grid
+			Grid to pack.
+		\param out
+			Destination of 2 bytes.
+		*******************************************************************************/
+		static void encode(const Grid& grid, unsigned char* out)
+		{
+			int value = 0;
+			for (int i = 8; i >= 0; --i)
+				value = value * 3 + (grid.get(i) == Grid::x ? 1 : grid.get(i) == Grid::o ? 2 : 0);
+			out[0] = static_cast<unsigned char>(value & 0xFF);
+			out[1] = static_cast<unsigned char>(value >> 8);
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Unpacks a grid from 2 bytes.
+		\param in
+			Source of 2 bytes.
+		\return
+			The unpacked grid.
+		*******************************************************************************/
+		static Grid decode(const unsigned char* in)
+		{
+			const char marks[3] = { Grid::_, Grid::x, Grid::o };
+			int value = in[0] | (in[1] << 8);
+			Grid grid;
+			for (int i = 0; i < 9; ++i, value /= 3)
+				grid.set(i, marks[value % 3]);
+			return grid;
+		}
+	};
+
+	// File signature of a binary tree dump
+	const char TREE_MAGIC[4] = { 'M', 'V', 'T', '1' };
+
+	/*!*****************************************************************************
+	\class TreeWriter
+	\brief
+		Writes Move<T> trees in preorder to a binary stream through a small
+		buffer, so the stream sees few large writes instead of one per value.
+	\typeparam T
+		The type of the game state (e.g., Grid).
+	*******************************************************************************/
+	template<typename T>
+	class TreeWriter
+	{
+		std::ostream& os;
+		std::vector<unsigned char> buffer;
+
+		/*!*****************************************************************************
+		\brief
+			Appends an unsigned varint to the buffer.
+		\param value
+			Value to append.
+		*******************************************************************************/
+		void putVarint(std::uint32_t value)
+		{
+			while (value >= 0x80)
+			{
+				buffer.push_back(static_cast<unsigned char>(value | 0x80));
+				value >>= 7;
+			}
+			buffer.push_back(static_cast<unsigned char>(value));
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Writes a node and its subtree.
+		\param move
+			The node.
+		\param parentScore
+			Score of the parent node (0 for the root).
+		*******************************************************************************/
+		void writeNode(const Move<T>& move, int parentScore)
+		{
+			int delta = move.getScore() - parentScore;
+			putVarint((static_cast<std::uint32_t>(move.getNextCount()) << 1) | (move.isPruned() ? 1u : 0u));
+			putVarint(static_cast<std::uint32_t>(move.getBestMove() + 1));
+			putVarint(static_cast<std::uint32_t>(move.getSpotIndex() + 1));
+			putVarint((static_cast<std::uint32_t>(delta) << 1) ^ static_cast<std::uint32_t>(delta >> 31));
+
+			std::size_t at = buffer.size();
+			buffer.resize(at + BoardCodec<T>::bytes);
+			BoardCodec<T>::encode(move.getGrid(), &buffer[at]);
+
+			if (buffer.size() >= 1 << 16)
+				flush();
+
+			for (int i = 0; i < move.getNextCount(); ++i)
+				writeNode(move.at(i), move.getScore());
+		}
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Constructs a writer and writes the file signature.
+		\param os
+			Binary output stream.
+		*******************************************************************************/
+		explicit TreeWriter(std::ostream& os)
+			: os{ os }, buffer{}
+		{
+			buffer.reserve((1 << 16) + 64);
+			buffer.insert(buffer.end(), TREE_MAGIC, TREE_MAGIC + 4);
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Flushes the remaining buffered data.
+		*******************************************************************************/
+		~TreeWriter()
+		{
+			flush();
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Writes a whole tree.
+		\param root
+			Root of the tree.
+		*******************************************************************************/
+		void write(const Move<T>& root)
+		{
+			writeNode(root, 0);
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Writes the buffered data to the stream.
+		*******************************************************************************/
+		void flush()
+		{
+			if (!buffer.empty())
+				os.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+			buffer.clear();
+		}
+	};
+
+	// A node as read back from a binary dump
+	template<typename T>
+	struct TreeRecord
+	{
+		T grid;			// State after the move
+		int score;		// Score of the move
+		int nextCount;	// Number of next moves (they follow in preorder)
+		int bestMove;	// Index of the best next move
+		int spotIndex;	// Index of the move's spot
+		bool pruned;	// The move was cut off by alpha-beta pruning
+		int depth;		// Depth of the node, 0 for the root
+	};
+
+	/*!*****************************************************************************
+	\class TreeReader
+	\brief
+		Reads a binary tree dump one node at a time in preorder, without building
+		the tree in memory.
+	\typeparam T
+		The type of the game state (e.g., Grid).
+	*******************************************************************************/
+	template<typename T>
+	class TreeReader
+	{
+		// An open node: its score and the number of children still to come
+		struct Open
+		{
+			int score;
+			int remaining;
+		};
+
+		std::istream& is;
+		std::vector<Open> stack;
+		bool good;
+
+		/*!*****************************************************************************
+		\brief
+			Reads an unsigned varint.
+		\param value
+			Set to the value read.
+		\return
+			True on success.
+		*******************************************************************************/
+		bool getVarint(std::uint32_t& value)
+		{
+			value = 0;
+			for (int shift = 0; shift < 35; shift += 7)
+			{
+				int c = is.get();
+				if (c == std::char_traits<char>::eof())
+					return false;
+				value |= static_cast<std::uint32_t>(c & 0x7F) << shift;
+				if (!(c & 0x80))
+					return true;
+			}
+			return false;
+		}
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Constructs a reader and checks the file signature.
+		\param is
+			Binary input stream.
+		*******************************************************************************/
+		explicit TreeReader(std::istream& is)
+			: is{ is }, stack{}, good{ false }
+		{
+			char magic[4] = {};
+			is.read(magic, 4);
+			good = is.gcount() == 4 && std::equal(magic, magic + 4, TREE_MAGIC);
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns whether the stream is a valid dump that has not failed yet.
+		\return
+			True while reading can continue.
+		*******************************************************************************/
+		bool valid() const
+		{
+			return good;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Reads the next node in preorder.
+		\param record
+			Set to the node read.
+		\return
+			True if a node was read, false at the end of the tree or on an error.
+		*******************************************************************************/
+		bool next(TreeRecord<T>& record)
+		{
+			if (!good)
+				return false;
+
+			std::uint32_t header, best, spot, zigzag;
+			unsigned char board[BoardCodec<T>::bytes];
+			if (!getVarint(header) || !getVarint(best) || !getVarint(spot) || !getVarint(zigzag))
+				return good = false;
+			is.read(reinterpret_cast<char*>(board), BoardCodec<T>::bytes);
+			if (is.gcount() != BoardCodec<T>::bytes)
+				return good = false;
+
+			int delta = static_cast<int>(zigzag >> 1) ^ -static_cast<int>(zigzag & 1);
+			record.score = (stack.empty() ? 0 : stack.back().score) + delta;
+			record.nextCount = static_cast<int>(header >> 1);
+			record.pruned = (header & 1) != 0;
+			record.bestMove = static_cast<int>(best) - 1;
+			record.spotIndex = static_cast<int>(spot) - 1;
+			record.grid = BoardCodec<T>::decode(board);
+			record.depth = static_cast<int>(stack.size());
+
+			// Close the parents whose children have all been read
+			if (!stack.empty())
+				--stack.back().remaining;
+			if (record.nextCount > 0)
+				stack.push_back(Open{ record.score, record.nextCount });
+			else
+				while (!stack.empty() && stack.back().remaining == 0)
+					stack.pop_back();
+
+			// The tree is complete once the root is closed
+			if (stack.empty())
+				good = false;
+			return true;
+		}
+	};
+
+	/*!*****************************************************************************
+	\brief
+		Writes a whole tree to a binary stream.
+	\param os
+		Binary output stream.
+	\param root
+		Root of the tree.
+	*******************************************************************************/
+	template<typename T>
+	void exportTree(std::ostream& os, const Move<T>& root)
+	{
+		TreeWriter<T> writer(os);
+		writer.write(root);
+	}
+
+	/*!*****************************************************************************
+	\brief
+		Rebuilds a tree from a binary stream.
+	\param is
+		Binary input stream.
+	\return
+		Root of the rebuilt tree, or nullptr if the stream is not a valid dump or
+		ends before the tree does.
+	*******************************************************************************/
+	template<typename T>
+	Move<T>* importTree(std::istream& is)
+	{
+		TreeReader<T> reader(is);
+		TreeRecord<T> record;
+		if (!reader.next(record))
+			return nullptr;
+
+		// Nodes are created top-down; each open node collects its children
+		struct Open
+		{
+			std::vector<Move<T>*>* next;
+			int remaining;
+		};
+
+		auto create = [](const TreeRecord<T>& r, std::vector<Move<T>*>* next)
+		{
+			Move<T>* move = new Move<T>(r.grid, r.score, next, r.bestMove);
+			move->setSpotIndex(r.spotIndex);
+			move->setPruned(r.pruned);
+			return move;
+		};
+
+		std::vector<Move<T>*>* rootNext = new std::vector<Move<T>*>();
+		Move<T>* root = create(record, rootNext);
+		std::vector<Open> stack;
+		if (record.nextCount > 0)
+			stack.push_back(Open{ rootNext, record.nextCount });
+
+		while (!stack.empty() && reader.next(record))
+		{
+			std::vector<Move<T>*>* next = new std::vector<Move<T>*>();
+			stack.back().next->push_back(create(record, next));
+			--stack.back().remaining;
+			if (record.nextCount > 0)
+				stack.push_back(Open{ next, record.nextCount });
+			else
+				while (!stack.empty() && stack.back().remaining == 0)
+					stack.pop_back();
+		}
+
+		// A truncated or corrupt dump leaves nodes waiting for children
+		if (!stack.empty())
+		{
+			delete root;
+			return nullptr;
+		}
+		return root;
+	}
+
+	/*!*****************************************************************************
+	\brief
+		Converts a binary dump to the text format of Move<T>::operator<<, one node
+		after another in preorder.
+	\param is
+		Binary input stream.
+	\param os
+		Text output stream.
+	\return
+		Number of nodes converted.
+	*******************************************************************************/
+	template<typename T>
+	long long binaryToText(std::istream& is, std::ostream& os)
+	{
+		TreeReader<T> reader(is);
+		TreeRecord<T> record;
+		long long count = 0;
+		while (reader.next(record))
+		{
+			os << record.grid << '\n'
+				<< record.score << '\n'
+				<< record.nextCount << '\n'
+				<< record.bestMove << '\n';
+			++count;
+		}
+		return count;
+	}
+} // end namespace
+
+#endif
@@ -0,0 +1,555 @@
+/*!*****************************************************************************
+\file       batch_tree.cpp
+\author     Jie Le Jet Ang
+\par        DP email: jielejet.ang@digipen.edu.sg
+\par        Course: CS3183
+\par        Section: A
+\par        Programming Assignment 10
+\date       10-18-2026
+
+\brief
+    Implements BatchTree: the group-at-a-time interpreter that ticks a shared
+    BehaviorTree for a block of agents, the split of a block into chunks on a
+    JobSystem, and the agents-per-millisecond throughput report.
+*******************************************************************************/
+#include "batch_tree.h"
+
+#include <chrono>
+#include <algorithm>
+
+namespace AI
+{
+    // Scratch buffers of one tree depth, reused across ticks
+    struct BatchTree::Frame
+    {
+        std::vector<std::uint32_t> ids;     // Agents passed to a child
+        std::vector<std::uint32_t> pos;     // Their positions in this node's group
+        std::vector<Status> res;            // Results of the child
+        std::vector<std::uint32_t> start;   // Resume point or chosen child of every agent of the group
+        std::vector<std::uint8_t> pending;  // Agents of the group that are not finished yet
+
+        /*!*****************************************************************************
+        \brief
+            Makes room for a group of agents.
+
+        \param count
+            Number of agents in the group.
+        *******************************************************************************/
+        void reserve(std::size_t count)
+        {
+            if (ids.size() < count)
+            {
+                ids.resize(count);
+                pos.resize(count);
+                res.resize(count);
+                start.resize(count);
+                pending.resize(count);
+            }
+        }
+    };
+
+    namespace
+    {
+        /*!*****************************************************************************
+        \brief
+            Computes the depth of the deepest node below a node.
+
+        \param nodes
+            The compiled nodes.
+
+        \param i
+            Index of the node.
+
+        \return
+            Depth of the subtree (0 for a leaf).
+        *******************************************************************************/
+        std::size_t subtreeDepth(const std::vector<FlatTree::FlatNode>& nodes, std::uint32_t i)
+        {
+            std::size_t depth = 0;
+            for (std::uint32_t c = nodes[i].first; c < nodes[i].first + nodes[i].count; ++c)
+                depth = std::max(depth, subtreeDepth(nodes, c) + 1);
+            return depth;
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Prepares batch ticking of a shared tree by binding batch actions to its leaves by task id, and notes whether
+        a leaf is left with neither a batch nor a bound action.
+
+    \param tree
+        The shared tree.
+
+    \param bindings
+        Batch actions by leaf task id.
+    *******************************************************************************/
+    BatchTree::BatchTree(const BehaviorTree& tree, const std::map<std::string, BatchAction>& bindings)
+        : tree{ tree }, batchActions{}, shared{ false }
+    {
+        const std::vector<SMART>& leaves = tree.getTree().getLeaves();
+        for (std::size_t leaf = 0; leaf < leaves.size(); ++leaf)
+        {
+            auto it = bindings.find(leaves[leaf]->getId());
+            batchActions.push_back(it != bindings.end() ? it->second : nullptr);
+            shared = shared || (!batchActions.back() && !tree.isBound(static_cast<std::int32_t>(leaf)));
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Creates the state block of a number of new agents.
+
+    \param agentCount
+        Number of agents.
+
+    \param seed
+        Seed of the agents' random streams.
+
+    \return
+        A block with all nodes of all agents not running.
+    *******************************************************************************/
+    AgentBlock BatchTree::createBlock(std::uint32_t agentCount, std::uint64_t seed) const
+    {
+        AgentBlock block;
+        block.agentCount = agentCount;
+        block.slots.assign(static_cast<std::size_t>(tree.getSlotCount()) * agentCount, 0);
+        block.user.assign(agentCount, nullptr);
+        block.boards.assign(agentCount, nullptr);
+        block.rngs.reserve(agentCount);
+        for (std::uint32_t a = 0; a < agentCount; ++a)
+            block.rngs.push_back(Rng::forAgent(seed, a));
+        block.status.assign(agentCount, Status::Failure);
+        return block;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Ticks every agent of a block once. The block is cut into chunks of consecutive agents; every chunk is ticked as
+        one group from the root, on the job system if one is given and no leaf calls the shared task. Each thread keeps
+        its own scratch frames.
+
+    \param block
+        The agents' state.
+
+    \param jobs
+        Job system to split the agents across.
+
+    \param chunkSize
+        Number of agents per job.
+    *******************************************************************************/
+    void BatchTree::tick(AgentBlock& block, JobSystem* jobs, std::size_t chunkSize) const
+    {
+        const std::vector<FlatTree::FlatNode>& nodes = tree.getTree().getNodes();
+        block.status.resize(block.agentCount);
+        if (nodes.empty())
+        {
+            std::fill(block.status.begin(), block.status.end(), Status::Failure);
+            return;
+        }
+
+        std::size_t depth = subtreeDepth(nodes, 0) + 1;
+        chunkSize = std::max<std::size_t>(chunkSize, 1);
+        std::size_t chunks = (block.agentCount + chunkSize - 1) / chunkSize;
+
+        auto tickChunk = [&](std::size_t chunk)
+        {
+            thread_local std::vector<Frame> frames;
+            thread_local std::vector<std::uint32_t> agents;
+            if (frames.size() < depth)
+                frames.resize(depth);
+
+            std::size_t begin = chunk * chunkSize;
+            std::size_t count = std::min<std::size_t>(chunkSize, block.agentCount - begin);
+            agents.resize(count);
+            for (std::size_t k = 0; k < count; ++k)
+                agents[k] = static_cast<std::uint32_t>(begin + k);
+            run(0, block, agents.data(), count, &block.status[begin], frames, 0);
+        };
+
+        if (jobs && chunks > 1 && !shared)
+            jobs->parallelFor(chunks, tickChunk);
+        else
+            for (std::size_t c = 0; c < chunks; ++c)
+                tickChunk(c);
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Executes the node at index i for a group of agents, with the same per-agent semantics as BehaviorTree::run.
+        Composites and Repeater hand each child the sub-group of agents that reach it, so every child, and in the end
+        every leaf, runs once per tick for all of those agents together. Leaves with a batch action get the whole
+        sub-group in one call. Loop decorators count their iteration budget per agent; a time budget is spent by the
+        whole group at once, since its agents run together.
+
+    \param i
+        Index of the node.
+
+    \param block
+        The agents' state.
+
+    \param agents
+        Indices of the agents in the group.
+
+    \param count
+        Number of agents in the group.
+
+    \param results
+        Receives the status of every agent of the group.
+
+    \param frames
+        Scratch buffers, one per tree depth.
+
+    \param depth
+        Depth of the node.
+    *******************************************************************************/
+    void BatchTree::run(std::uint32_t i, AgentBlock& block, const std::uint32_t* agents, std::size_t count,
+        Status* results, std::vector<Frame>& frames, std::size_t depth) const
+    {
+        const FlatTree::FlatNode& n = tree.getTree().getNodes()[i];
+        std::int32_t slotIndex = tree.getSlot(i);
+        std::uint32_t* slots = slotIndex >= 0 ? &block.slots[static_cast<std::size_t>(slotIndex) * block.agentCount] : nullptr;
+        Frame& f = frames[depth];
+        f.reserve(count);
+
+        switch (n.op)
+        {
+        case FlatTree::Op::Selector:
+        case FlatTree::Op::Sequence:
+        case FlatTree::Op::Repeater:
+        {
+            // Selector and Sequence go through their children, Repeater through its repetitions
+            bool repeat = n.op == FlatTree::Op::Repeater;
+            Status stop = n.op == FlatTree::Op::Selector ? Status::Success : Status::Failure;
+            Status fall = n.op == FlatTree::Op::Sequence || repeat ? Status::Success : Status::Failure;
+            const FlatTree::LoopPolicy* loop = repeat ? &tree.getTree().getLoop(n.param) : nullptr;
+            std::uint32_t steps = repeat ? (n.count ? static_cast<std::uint32_t>(std::max(loop->counter, 0)) : 0) : n.count;
+            LoopMeter meter{ repeat ? *loop : FlatTree::LoopPolicy{ 0, 0, 0 } };
+
+            std::size_t left = count;
+            for (std::size_t j = 0; j < count; ++j)
+            {
+                std::uint32_t s = slots[agents[j]];
+                f.start[j] = s ? s - 1 : 0;
+                f.pending[j] = 1;
+            }
+
+            for (std::uint32_t k = 0; k < steps && left > 0; ++k)
+            {
+                // A Repeater's time budget is shared by the group, its iteration budget counts every agent's runs
+                bool late = repeat && loop->microseconds && meter.spent();
+                std::size_t m = 0;
+                for (std::size_t j = 0; j < count; ++j)
+                    if (f.pending[j] && f.start[j] <= k)
+                    {
+                        std::uint32_t runs = k - f.start[j];
+                        if (repeat && runs && (late || (loop->iterations && runs >= loop->iterations)))
+                        {
+                            slots[agents[j]] = k + 1;
+                            results[j] = Status::Running;
+                            f.pending[j] = 0;
+                            --left;
+                            continue;
+                        }
+                        f.ids[m] = agents[j];
+                        f.pos[m++] = static_cast<std::uint32_t>(j);
+                    }
+                if (m == 0)
+                    continue;
+
+                run(repeat ? n.first : n.first + k, block, f.ids.data(), m, f.res.data(), frames, depth + 1);
+                meter.count();
+
+                for (std::size_t q = 0; q < m; ++q)
+                {
+                    std::uint32_t j = f.pos[q];
+                    Status s = f.res[q];
+                    if (s == Status::Running)
+                        slots[agents[j]] = k + 1;
+                    else if (!repeat && s == stop)
+                        slots[agents[j]] = 0;
+                    else
+                        continue;
+                    results[j] = s;
+                    f.pending[j] = 0;
+                    --left;
+                }
+            }
+
+            for (std::size_t j = 0; j < count; ++j)
+                if (f.pending[j])
+                {
+                    slots[agents[j]] = 0;
+                    results[j] = fall;
+                }
+            break;
+        }
+
+        case FlatTree::Op::RandomSelector:
+        {
+            if (n.count == 0)
+            {
+                std::fill(results, results + count, Status::Failure);
+                break;
+            }
+
+            // Every agent draws from its own stream, in the same order as when ticked alone
+            for (std::size_t j = 0; j < count; ++j)
+            {
+                std::uint32_t s = slots[agents[j]];
+                f.start[j] = s ? s - 1 : tree.getTree().pick(n, block.rngs[agents[j]]);
+            }
+
+            // Agents that picked the same child run it together
+            for (std::uint32_t k = 0; k < n.count; ++k)
+            {
+                std::size_t m = 0;
+                for (std::size_t j = 0; j < count; ++j)
+                    if (f.start[j] == k)
+                    {
+                        f.ids[m] = agents[j];
+                        f.pos[m++] = static_cast<std::uint32_t>(j);
+                    }
+                if (m == 0)
+                    continue;
+
+                run(n.first + k, block, f.ids.data(), m, f.res.data(), frames, depth + 1);
+
+                for (std::size_t q = 0; q < m; ++q)
+                {
+                    std::uint32_t j = f.pos[q];
+                    results[j] = f.res[q];
+                    slots[agents[j]] = f.res[q] == Status::Running ? k + 1 : 0;
+                }
+            }
+            break;
+        }
+
+        case FlatTree::Op::Parallel:
+        {
+            // Every child runs for the agents that are not done with it; the slot keeps two bits per child
+            const FlatTree::ParallelPolicy& policy = tree.getTree().getPolicy(n.param);
+            std::uint32_t kids = n.count < Parallel::PARALLEL_MAX ? n.count : Parallel::PARALLEL_MAX;
+            for (std::uint32_t k = 0; k < kids; ++k)
+            {
+                std::size_t m = 0;
+                for (std::size_t j = 0; j < count; ++j)
+                    if ((slots[agents[j]] >> 2 * k & 3) == 0)
+                    {
+                        f.ids[m] = agents[j];
+                        f.pos[m++] = static_cast<std::uint32_t>(j);
+                    }
+                if (m == 0)
+                    continue;
+
+                run(n.first + k, block, f.ids.data(), m, f.res.data(), frames, depth + 1);
+
+                for (std::size_t q = 0; q < m; ++q)
+                {
+                    std::uint32_t code = f.res[q] == Status::Success ? 1 : f.res[q] == Status::Failure ? 2 : 0;
+                    slots[f.ids[q]] |= code << 2 * k;
+                }
+            }
+
+            for (std::size_t j = 0; j < count; ++j)
+            {
+                std::uint32_t& slot = slots[agents[j]];
+                std::uint32_t successes = 0, failures = 0;
+                for (std::uint32_t k = 0; k < kids; ++k)
+                {
+                    std::uint32_t code = slot >> 2 * k & 3;
+                    successes += code == 1;
+                    failures += code == 2;
+                }
+                bool running = successes + failures < kids;
+                results[j] = successes >= policy.success ? Status::Success
+                    : failures >= policy.failure ? Status::Failure
+                    : running ? Status::Running
+                    : Status::Failure;
+                if (results[j] != Status::Running)
+                {
+                    for (std::uint32_t k = 0; k < kids; ++k)
+                        if ((slot >> 2 * k & 3) == 0)
+                            reset(n.first + k, block, agents[j]);
+                    slot = 0;
+                }
+            }
+            break;
+        }
+
+        case FlatTree::Op::Inverter:
+            if (n.count == 0)
+            {
+                std::fill(results, results + count, Status::Failure);
+                break;
+            }
+            run(n.first, block, agents, count, results, frames, depth + 1);
+            for (std::size_t j = 0; j < count; ++j)
+                results[j] = results[j] == Status::Success ? Status::Failure
+                    : results[j] == Status::Failure ? Status::Success
+                    : results[j];
+            break;
+
+        case FlatTree::Op::Succeeder:
+            if (n.count)
+                run(n.first, block, agents, count, results, frames, depth + 1);
+            for (std::size_t j = 0; j < count; ++j)
+                results[j] = n.count && results[j] == Status::Running ? Status::Running : Status::Success;
+            break;
+
+        case FlatTree::Op::Repeat_until_fail:
+        {
+            if (n.count == 0)
+            {
+                std::fill(results, results + count, Status::Success);
+                break;
+            }
+
+            // Agents whose child keeps succeeding run it again together while the budget lasts
+            LoopMeter meter{ tree.getTree().getLoop(n.param) };
+            std::size_t m = count;
+            for (std::size_t j = 0; j < count; ++j)
+            {
+                f.ids[j] = agents[j];
+                f.pos[j] = static_cast<std::uint32_t>(j);
+            }
+            while (m > 0)
+            {
+                run(n.first, block, f.ids.data(), m, f.res.data(), frames, depth + 1);
+                meter.count();
+                bool spent = !meter.limited() || meter.spent();
+                std::size_t next = 0;
+                for (std::size_t q = 0; q < m; ++q)
+                {
+                    std::uint32_t j = f.pos[q];
+                    if (f.res[q] == Status::Success && !spent)
+                    {
+                        f.ids[next] = f.ids[q];
+                        f.pos[next++] = j;
+                        continue;
+                    }
+                    results[j] = f.res[q] == Status::Failure ? Status::Success : Status::Running;
+                }
+                m = next;
+            }
+            break;
+        }
+
+        case FlatTree::Op::CheckState:
+            std::fill(results, results + count, n.param == State::Success ? Status::Success : Status::Failure);
+            break;
+
+        case FlatTree::Op::Condition:
+        {
+            const BlackboardOp& op = tree.getTree().getBoardOp(n.param);
+            for (std::size_t j = 0; j < count; ++j)
+            {
+                Blackboard* board = block.boards[agents[j]];
+                results[j] = board && op.test(*board) ? Status::Success : Status::Failure;
+            }
+            break;
+        }
+
+        case FlatTree::Op::Assign:
+        {
+            const BlackboardOp& op = tree.getTree().getBoardOp(n.param);
+            for (std::size_t j = 0; j < count; ++j)
+            {
+                Blackboard* board = block.boards[agents[j]];
+                results[j] = board ? Status::Success : Status::Failure;
+                if (board)
+                    op.assign(*board);
+            }
+            break;
+        }
+
+        case FlatTree::Op::Leaf:
+        default:
+            if (BatchAction action = batchActions[n.param])
+                action(block, agents, count, results);
+            else
+                for (std::size_t j = 0; j < count; ++j)
+                {
+                    TickContext context{ agents[j], block.user[agents[j]], block.boards[agents[j]], &block.rngs[agents[j]] };
+                    results[j] = tree.runLeaf(n.param, context);
+                }
+            break;
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Stops the running nodes of a subtree for one agent by clearing their slots, so the next tick starts them over.
+
+    \param i
+        Index of the subtree's root.
+
+    \param block
+        The agents' state.
+
+    \param agent
+        Index of the agent.
+    *******************************************************************************/
+    void BatchTree::reset(std::uint32_t i, AgentBlock& block, std::uint32_t agent) const
+    {
+        const FlatTree::FlatNode& n = tree.getTree().getNodes()[i];
+        std::int32_t slotIndex = tree.getSlot(i);
+        if (slotIndex >= 0)
+            block.slots[static_cast<std::size_t>(slotIndex) * block.agentCount + agent] = 0;
+        for (std::uint32_t c = n.first; c < n.first + n.count; ++c)
+            reset(c, block, agent);
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Measures how many agents per millisecond a tree can tick, after one warm-up tick that sizes the scratch buffers.
+
+    \param tree
+        The batch tree.
+
+    \param agentCount
+        Number of agents.
+
+    \param ticks
+        Number of ticks to average over.
+
+    \param jobs
+        Job system to split the agents across.
+
+    \return
+        Agents ticked per millisecond.
+    *******************************************************************************/
+    double measureThroughput(const BatchTree& tree, std::uint32_t agentCount, int ticks, JobSystem* jobs)
+    {
+        AgentBlock block = tree.createBlock(agentCount);
+        tree.tick(block, jobs);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < ticks; ++t)
+            tree.tick(block, jobs);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return ms > 0.0 ? static_cast<double>(agentCount) * ticks / ms : 0.0;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Writes the throughput of a tree at 1k, 10k and 100k agents, one line per agent count. Every measurement ticks
+        about a million agents in total.
+
+    \param os
+        Output stream for the report.
+
+    \param tree
+        The batch tree.
+
+    \param jobs
+        Job system to split the agents across.
+    *******************************************************************************/
+    void reportThroughput(std::ostream& os, const BatchTree& tree, JobSystem* jobs)
+    {
+        for (std::uint32_t agents : { 1000u, 10000u, 100000u })
+        {
+            int ticks = std::max(1, static_cast<int>(1000000 / agents));
+            os << agents << " agents: " << measureThroughput(tree, agents, ticks, jobs) << " agents/ms\n";
+        }
+    }
+} // end namespace
@@ -0,0 +1,189 @@
+/*!*****************************************************************************
+\file       batch_tree.h
+\author     Jie Le Jet Ang
+\par        DP email: jielejet.ang@digipen.edu.sg
+\par        Course: CS3183
+\par        Section: A
+\par        Programming Assignment 10
+\date       10-18-2026
+
+\brief
+	Declares BatchTree, which ticks one shared BehaviorTree over a whole block
+	of agents at once. Agent state is kept as a structure of arrays, agents are
+	split across a JobSystem in chunks, and within a chunk all agents that
+	reach the same node are ticked together, so leaf actions run in batches.
+	Batch and bound actions are called from several threads at once, for
+	different agents; a leaf with neither calls the tree's shared task, so a
+	tree with such a leaf is always ticked on the calling thread.
+*******************************************************************************/
+#ifndef BATCH_TREE_H
+#define BATCH_TREE_H
+
+#include <vector>
+#include <map>
+#include <string>
+#include <iostream>
+#include "behavior_tree.h"
+#include "job_system.h"
+
+namespace AI
+{
+	// State of many agents of one BehaviorTree, as a structure of arrays
+	struct AgentBlock
+	{
+		std::uint32_t agentCount = 0;
+		std::vector<std::uint32_t> slots;	// Slot s of agent a is slots[s * agentCount + a]
+		std::vector<void*> user;			// Game data of every agent
+		std::vector<Blackboard*> boards;	// Blackboard of every agent
+		std::vector<Rng> rngs;				// Random stream of every agent
+		std::vector<Status> status;			// Root status of every agent after the last tick
+	};
+
+	// Leaf action run for a batch of agents that reached the same leaf
+	//     agents holds count agent indices; results[k] receives the status of agents[k].
+	using BatchAction = void(*)(const AgentBlock& block, const std::uint32_t* agents, std::size_t count, Status* results);
+
+	// Batch ticking of a BehaviorTree
+	class BatchTree
+	{
+		const BehaviorTree& tree;
+		std::vector<BatchAction> batchActions;	// Batch action of every leaf, nullptr to run agents one by one
+		bool shared;							// A leaf has no batch or bound action and calls the shared task
+
+		struct Frame;
+
+		/*!*****************************************************************************
+		\brief
+			Executes the node at index i for a group of agents.
+
+		\param i
+			Index of the node.
+
+		\param block
+			The agents' state.
+
+		\param agents
+			Indices of the agents in the group.
+
+		\param count
+			Number of agents in the group.
+
+		\param results
+			Receives the status of every agent of the group.
+
+		\param frames
+			Scratch buffers, one per tree depth.
+
+		\param depth
+			Depth of the node.
+		*******************************************************************************/
+		void run(std::uint32_t i, AgentBlock& block, const std::uint32_t* agents, std::size_t count,
+			Status* results, std::vector<Frame>& frames, std::size_t depth) const;
+
+		/*!*****************************************************************************
+		\brief
+			Stops the running nodes of a subtree for one agent.
+
+		\param i
+			Index of the subtree's root.
+
+		\param block
+			The agents' state.
+
+		\param agent
+			Index of the agent.
+		*******************************************************************************/
+		void reset(std::uint32_t i, AgentBlock& block, std::uint32_t agent) const;
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Prepares batch ticking of a shared tree.
+
+		\param tree
+			The shared tree; must outlive this object.
+
+		\param bindings
+			Batch actions by leaf task id. Other leaves run agent by agent through
+			the tree's own actions, or its shared task if they have none.
+		*******************************************************************************/
+		BatchTree(const BehaviorTree& tree, const std::map<std::string, BatchAction>& bindings = {});
+
+		/*!*****************************************************************************
+		\brief
+			Creates the state block of a number of new agents.
+
+		\param agentCount
+			Number of agents.
+
+		\param seed
+			Seed of the agents' random streams; agent a gets Rng::forAgent(seed, a).
+
+		\return
+			A block with all nodes of all agents not running.
+		*******************************************************************************/
+		AgentBlock createBlock(std::uint32_t agentCount, std::uint64_t seed = 0) const;
+
+		/*!*****************************************************************************
+		\brief
+			Ticks every agent of a block once; each agent gets the same results as
+			BehaviorTree::tick with its own random stream, however the block is
+			split across threads. Job children of Parallel nodes run inline, since
+			the block itself is already split across the job system. A tree with a
+			leaf that has neither a batch nor a bound action is ticked on this
+			thread, job system or not, since every agent calls the same task.
+
+		\param block
+			The agents' state; the root status of every agent is stored in it.
+
+		\param jobs
+			Job system to split the agents across (nullptr ticks on this thread);
+			batch and bound actions must then be safe to call for different
+			agents at once.
+
+		\param chunkSize
+			Number of agents per job.
+		*******************************************************************************/
+		void tick(AgentBlock& block, JobSystem* jobs = nullptr, std::size_t chunkSize = 1024) const;
+	};
+
+	/*!*****************************************************************************
+	\brief
+		Measures how many agents per millisecond a tree can tick. The agents have
+		no game data (user pointers are nullptr).
+
+	\param tree
+		The batch tree.
+
+	\param agentCount
+		Number of agents.
+
+	\param ticks
+		Number of ticks to average over.
+
+	\param jobs
+		Job system to split the agents across (nullptr ticks on this thread).
+
+	\return
+		Agents ticked per millisecond.
+	*******************************************************************************/
+	double measureThroughput(const BatchTree& tree, std::uint32_t agentCount, int ticks, JobSystem* jobs);
+
+	/*!*****************************************************************************
+	\brief
+		Writes the throughput of a tree at 1k, 10k and 100k agents.
+
+	\param os
+		Output stream for the report.
+
+	\param tree
+		The batch tree.
+
+	\param jobs
+		Job system to split the agents across (nullptr ticks on this thread).
+	*******************************************************************************/
+	void reportThroughput(std::ostream& os, const BatchTree& tree, JobSystem* jobs);
+
+} // end namespace
+
+#endif
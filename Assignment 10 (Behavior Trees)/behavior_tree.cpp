@@ -0,0 +1,591 @@
+/*!*****************************************************************************
+\file       behavior_tree.cpp
+\author     Jie Le Jet Ang
+\par        DP email: jielejet.ang@digipen.edu.sg
+\par        Course: CS3183
+\par        Section: A
+\par        Programming Assignment 10
+\date       10-18-2026
+
+\brief
+    Implements BehaviorTree: binding of actions to the leaves of a compiled tree,
+    allocation of per-agent instance slots, the dependency masks of event-driven
+    mode, the resumable interpreter that ticks the shared tree for one agent,
+    and the Parallel node with its job children. The interpreter is a template
+    on whether it is instrumented, so ticks without a profiler or trace ring
+    carry no timing or recording code.
+*******************************************************************************/
+#include "behavior_tree.h"
+#include "profiler.h"
+#include "tick_log.h"
+
+#include <utility>
+
+namespace AI
+{
+    /*!*****************************************************************************
+    \brief
+        Copies an instance. Running jobs hold their record, so the copy gets records of its own: each takes the result
+        of a finished job, and a job that is still queued or running is left to its original record and counts as
+        failed in the copy.
+
+    \param other
+        The instance to copy.
+    *******************************************************************************/
+    AgentInstance::AgentInstance(const AgentInstance& other)
+        : slots{ other.slots }, cache{ other.cache }, stamps{ other.stamps }, jobs{}, rng{ other.rng }
+    {
+        jobs.reserve(other.jobs.size());
+        for (const std::shared_ptr<PendingJob>& job : other.jobs)
+        {
+            std::shared_ptr<PendingJob> copy = std::make_shared<PendingJob>();
+            if (!job->busy.load(std::memory_order_acquire))
+                copy->result = job->result;
+            jobs.push_back(std::move(copy));
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Copies an instance with new job records.
+
+    \param other
+        The instance to copy.
+
+    \return
+        Reference to this instance.
+    *******************************************************************************/
+    AgentInstance& AgentInstance::operator=(const AgentInstance& other)
+    {
+        if (this != &other)
+            *this = AgentInstance{ other };
+        return *this;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Builds a definition from a built tree by compiling it with FlatTree.
+
+    \param root
+        Root task of the tree.
+
+    \param bindings
+        Actions by leaf task id.
+
+    \param dependencies
+        Blackboard keys read by leaves, by leaf task id.
+    *******************************************************************************/
+    BehaviorTree::BehaviorTree(SMART root, const std::map<std::string, Action>& bindings,
+        const Dependencies& dependencies)
+        : BehaviorTree{ FlatTree{ root }, bindings, dependencies }
+    {
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Builds a definition from a compiled tree. Every node that has to remember something between ticks gets a slot
+        index, every leaf gets the action bound to its task id, and job children of Parallel nodes get a job record.
+        The inputs of every node are then gathered bottom up; the layout is breadth first, so children always come
+        after their parent and one backward pass is enough.
+
+    \param compiled
+        The compiled tree.
+
+    \param bindings
+        Actions by leaf task id.
+
+    \param dependencies
+        Blackboard keys read by leaves, by leaf task id.
+    *******************************************************************************/
+    BehaviorTree::BehaviorTree(FlatTree compiled, const std::map<std::string, Action>& bindings,
+        const Dependencies& dependencies)
+        : tree{ std::move(compiled) }, slotOf{}, actions{}, deps{}, volatiles{}, jobOf{}, slotCount{ 0 }, jobCount{ 0 }
+    {
+        for (const FlatTree::FlatNode& n : tree.getNodes())
+        {
+            bool stateful = n.op == FlatTree::Op::Selector || n.op == FlatTree::Op::Sequence
+                || n.op == FlatTree::Op::RandomSelector || n.op == FlatTree::Op::Repeater
+                || n.op == FlatTree::Op::Parallel;
+            slotOf.push_back(stateful ? static_cast<std::int32_t>(slotCount++) : -1);
+        }
+
+        for (const SMART& leaf : tree.getLeaves())
+        {
+            auto it = bindings.find(leaf->getId());
+            actions.push_back(it != bindings.end() ? it->second : nullptr);
+        }
+
+        // Job children must be leaves with a bound action; an unbound leaf calls a task shared by all agents
+        const std::vector<FlatTree::FlatNode>& nodes = tree.getNodes();
+        jobOf.assign(nodes.size(), -1);
+        for (const FlatTree::FlatNode& n : nodes)
+            if (n.op == FlatTree::Op::Parallel)
+                for (std::uint32_t k = 0; k < n.count; ++k)
+                {
+                    const FlatTree::FlatNode& child = nodes[n.first + k];
+                    if ((tree.getPolicy(n.param).jobs >> k & 1) && child.op == FlatTree::Op::Leaf && actions[child.param])
+                        jobOf[n.first + k] = static_cast<std::int32_t>(jobCount++);
+                }
+
+        deps.assign(nodes.size(), 0);
+        volatiles.assign(nodes.size(), 0);
+        for (std::size_t i = nodes.size(); i-- > 0;)
+        {
+            const FlatTree::FlatNode& n = nodes[i];
+            // An Assign depends on the key it writes, so it writes again once something else changed it
+            if (n.op == FlatTree::Op::Condition || n.op == FlatTree::Op::Assign)
+                deps[i] = Blackboard::maskOf(tree.getBoardOp(n.param).key);
+            // A RandomSelector draws a new pick on every tick, so it is never skipped
+            else if (n.op == FlatTree::Op::RandomSelector)
+                volatiles[i] = 1;
+            else if (n.op == FlatTree::Op::Leaf)
+            {
+                auto it = dependencies.find(tree.getLeaves()[n.param]->getId());
+                if (it == dependencies.end())
+                    volatiles[i] = 1;
+                else
+                    for (const BlackboardKey& key : it->second)
+                        deps[i] |= Blackboard::maskOf(key);
+            }
+            for (std::uint32_t c = n.first; c < n.first + n.count; ++c)
+            {
+                deps[i] |= deps[c];
+                volatiles[i] |= volatiles[c];
+            }
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Creates the instance block of a new agent.
+
+    \param eventDriven
+        True to keep a status cache for event-driven ticks.
+
+    \return
+        An instance with all nodes not running.
+    *******************************************************************************/
+    AgentInstance BehaviorTree::createInstance(bool eventDriven) const
+    {
+        AgentInstance instance;
+        instance.slots.assign(slotCount, 0);
+        for (std::uint32_t j = 0; j < jobCount; ++j)
+            instance.jobs.push_back(std::make_shared<PendingJob>());
+        if (eventDriven)
+        {
+            instance.cache.assign(tree.getNodes().size(), Status::Failure);
+            instance.stamps.assign(tree.getNodes().size(), 0);
+        }
+        return instance;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Ticks the tree for one agent, resuming its running nodes. A context without a random stream draws from the
+        instance's own, so the agent's picks do not depend on the thread that ticks it.
+
+    \param instance
+        The agent's instance block.
+
+    \param context
+        The agent's tick context.
+
+    \return
+        Resulting status of the root, Failure for an empty tree.
+    *******************************************************************************/
+    Status BehaviorTree::tick(AgentInstance& instance, TickContext& context) const
+    {
+        if (tree.getNodes().empty())
+            return Status::Failure;
+        Rng* given = context.rng;
+        if (!given)
+            context.rng = &instance.rng;
+
+        Status s;
+        if (!context.profiler && !context.trace)
+            s = run<false>(0, instance, context);
+        else
+        {
+            if (context.trace)
+                context.trace->stamp();
+            s = run<true>(0, instance, context);
+        }
+        context.rng = given;
+        return s;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Executes the node at index i for one agent. An instrumented run records the node's start and result in the
+        trace ring, and times the node including its children, taking off the time of the children it ran to give its
+        self time. A cached status counts as a tick of the node.
+
+    \param i
+        Index of the node.
+
+    \param instance
+        The agent's instance block.
+
+    \param context
+        The agent's tick context.
+
+    \return
+        Resulting status of the node.
+    *******************************************************************************/
+    template<bool Instrumented>
+    Status BehaviorTree::run(std::uint32_t i, AgentInstance& instance, TickContext& context) const
+    {
+        if (!Instrumented)
+            return cached<Instrumented>(i, instance, context);
+
+        Profiler* profiler = context.profiler;
+        TickRing* trace = context.trace;
+        if (trace)
+            trace->push(context.agent, i, TickEvent::Enter);
+        Profiler::Mark mark = profiler ? profiler->enter() : Profiler::Mark{};
+        Status s = cached<Instrumented>(i, instance, context);
+        if (profiler)
+            profiler->leave(i, s, mark);
+        if (trace)
+            trace->push(context.agent, i, static_cast<TickEvent>(s));
+        return s;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Executes the node at index i for one agent. An event-driven instance with a blackboard skips the node and
+        returns its cached status if the node was evaluated before, did not return Running, has no leaf with undeclared
+        inputs or RandomSelector, and none of the keys read in its subtree changed since the stamp of that evaluation.
+        The stamp is taken before the node runs, so values the subtree writes itself make it run again on the next tick,
+        and a node that resumed a running child is always evaluated again.
+
+    \param i
+        Index of the node.
+
+    \param instance
+        The agent's instance block.
+
+    \param context
+        The agent's tick context.
+
+    \return
+        Resulting status of the node.
+    *******************************************************************************/
+    template<bool Instrumented>
+    Status BehaviorTree::cached(std::uint32_t i, AgentInstance& instance, TickContext& context) const
+    {
+        if (instance.cache.empty() || !context.blackboard)
+            return evaluate<Instrumented>(i, instance, context);
+
+        const Blackboard& board = *context.blackboard;
+        std::uint32_t since = instance.stamps[i];
+        if (since && !volatiles[i] && instance.cache[i] != Status::Running && !board.changedSince(deps[i], since))
+            return instance.cache[i];
+
+        // A node that resumed a running child did not look at its earlier children, so its result is not cached
+        bool resumed = slotOf[i] >= 0 && instance.slots[slotOf[i]] != 0;
+        std::uint32_t stamp = board.getStamp();
+        Status s = evaluate<Instrumented>(i, instance, context);
+        instance.cache[i] = s;
+        instance.stamps[i] = resumed ? 0 : stamp;
+        return s;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Evaluates the node at index i for one agent. The slot of a composite holds the index of its running child plus
+        one and the slot of a Repeater holds the running (or next) repetition plus one; a node resumes from its slot and
+        clears it when it finishes. Running passes up through the decorators. Repeater and Repeat_until_fail run their
+        child until their per-tick budget is spent and then return Running, and a Repeat_until_fail without a budget runs
+        its child once per tick, so a loop cannot hang a frame; a profiled tick reports every stop at a configured
+        budget as an overrun. Condition and Assign use the agent's
+        blackboard from the context and fail without one. RandomSelector draws from the agent's random stream, so agents
+        with their own streams give the same picks on any thread.
+
+    \param i
+        Index of the node.
+
+    \param instance
+        The agent's instance block.
+
+    \param context
+        The agent's tick context.
+
+    \return
+        Resulting status of the node.
+    *******************************************************************************/
+    template<bool Instrumented>
+    Status BehaviorTree::evaluate(std::uint32_t i, AgentInstance& instance, TickContext& context) const
+    {
+        std::uint32_t* slots = instance.slots.data();
+        const FlatTree::FlatNode& n = tree.getNodes()[i];
+        std::uint32_t* slot = slotOf[i] >= 0 ? &slots[slotOf[i]] : nullptr;
+        std::uint32_t end = n.first + n.count;
+
+        switch (n.op)
+        {
+        case FlatTree::Op::Selector:
+        case FlatTree::Op::Sequence:
+        {
+            // Selector stops at the first Success, Sequence at the first Failure
+            Status stop = n.op == FlatTree::Op::Selector ? Status::Success : Status::Failure;
+            for (std::uint32_t c = n.first + (*slot ? *slot - 1 : 0); c < end; ++c)
+            {
+                Status s = run<Instrumented>(c, instance, context);
+                if (s == Status::Running)
+                {
+                    *slot = c - n.first + 1;
+                    return Status::Running;
+                }
+                if (s == stop)
+                {
+                    *slot = 0;
+                    return stop;
+                }
+            }
+            *slot = 0;
+            return stop == Status::Success ? Status::Failure : Status::Success;
+        }
+
+        case FlatTree::Op::RandomSelector:
+        {
+            if (n.count == 0)
+                return Status::Failure;
+            std::uint32_t c = n.first + (*slot ? *slot - 1 : tree.pick(n, *context.rng));
+            Status s = run<Instrumented>(c, instance, context);
+            *slot = s == Status::Running ? c - n.first + 1 : 0;
+            return s;
+        }
+
+        case FlatTree::Op::Parallel:
+            return parallel<Instrumented>(n, *slot, instance, context);
+
+        case FlatTree::Op::Inverter:
+        {
+            if (n.count == 0)
+                return Status::Failure;
+            Status s = run<Instrumented>(n.first, instance, context);
+            return s == Status::Success ? Status::Failure
+                : s == Status::Failure ? Status::Success
+                : s;
+        }
+
+        case FlatTree::Op::Succeeder:
+            if (n.count && run<Instrumented>(n.first, instance, context) == Status::Running)
+                return Status::Running;
+            return Status::Success;
+
+        case FlatTree::Op::Repeater:
+        {
+            const FlatTree::LoopPolicy& loop = tree.getLoop(n.param);
+            LoopMeter meter{ loop };
+            if (n.count)
+                for (std::int32_t k = *slot ? *slot - 1 : 0; k < loop.counter; ++k)
+                {
+                    if (meter.spent())
+                    {
+                        *slot = static_cast<std::uint32_t>(k) + 1;
+                        if (Instrumented && context.profiler)
+                            context.profiler->overrun(i, meter.excess());
+                        return Status::Running;
+                    }
+                    if (run<Instrumented>(n.first, instance, context) == Status::Running)
+                    {
+                        *slot = static_cast<std::uint32_t>(k) + 1;
+                        return Status::Running;
+                    }
+                    meter.count();
+                }
+            *slot = 0;
+            return Status::Success;
+        }
+
+        case FlatTree::Op::Repeat_until_fail:
+        {
+            if (n.count == 0)
+                return Status::Success;
+            LoopMeter meter{ tree.getLoop(n.param) };
+            for (;;)
+            {
+                Status s = run<Instrumented>(n.first, instance, context);
+                if (s != Status::Success)
+                    return s == Status::Failure ? Status::Success : Status::Running;
+                meter.count();
+                // Without a budget the loop yields after every run, which is not an overrun
+                if (!meter.limited())
+                    return Status::Running;
+                if (meter.spent())
+                {
+                    if (Instrumented && context.profiler)
+                        context.profiler->overrun(i, meter.excess());
+                    return Status::Running;
+                }
+            }
+        }
+
+        case FlatTree::Op::CheckState:
+            return n.param == State::Success ? Status::Success : Status::Failure;
+
+        case FlatTree::Op::Condition:
+            return context.blackboard && tree.getBoardOp(n.param).test(*context.blackboard)
+                ? Status::Success : Status::Failure;
+
+        case FlatTree::Op::Assign:
+            if (!context.blackboard)
+                return Status::Failure;
+            tree.getBoardOp(n.param).assign(*context.blackboard);
+            return Status::Success;
+
+        case FlatTree::Op::Leaf:
+        default:
+            return runLeaf(n.param, context);
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Executes a leaf for one agent. A bound action gets the agent's context; an unbound leaf calls the task of the
+        compiled tree, which is shared by all agents, with the agent's random stream. Task states other than Success and
+        Failure mean Running.
+
+    \param leaf
+        Index of the leaf in the compiled tree's leaves.
+
+    \param context
+        The agent's tick context.
+
+    \return
+        Resulting status of the leaf.
+    *******************************************************************************/
+    Status BehaviorTree::runLeaf(std::int32_t leaf, TickContext& context) const
+    {
+        if (Action action = actions[leaf])
+            return action(context);
+
+        State s = tick_child(*tree.getLeaves()[leaf], nullptr, 0, context.rng ? *context.rng : default_rng()).getState();
+        return s == State::Success ? Status::Success
+            : s == State::Failure ? Status::Failure
+            : Status::Running;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Evaluates a Parallel node for one agent. The slot keeps two bits per child: 0 when the child has to run (or is
+        running inline), 1 when it succeeded, 2 when it failed and 3 when its job is in flight. Every tick runs the
+        children that are not done; a job child is submitted to the context's job system and its result is picked up
+        on a later tick once the job has finished, so the tick never waits. The node succeeds when enough children
+        succeeded, fails when enough failed (success is checked first), and is Running while children that could still
+        reach a threshold are running. When it finishes, children that are still running are stopped; a job in flight
+        is left to finish and its result is ignored.
+
+    \param n
+        The node.
+
+    \param slot
+        The node's slot.
+
+    \param instance
+        The agent's instance block.
+
+    \param context
+        The agent's tick context.
+
+    \return
+        Resulting status of the node.
+    *******************************************************************************/
+    template<bool Instrumented>
+    Status BehaviorTree::parallel(const FlatTree::FlatNode& n, std::uint32_t& slot, AgentInstance& instance,
+        TickContext& context) const
+    {
+        const FlatTree::ParallelPolicy& policy = tree.getPolicy(n.param);
+        std::uint32_t count = n.count < Parallel::PARALLEL_MAX ? n.count : Parallel::PARALLEL_MAX;
+        std::uint32_t successes = 0, failures = 0;
+        bool running = false;
+
+        for (std::uint32_t k = 0; k < count; ++k)
+        {
+            std::uint32_t c = n.first + k, shift = 2 * k, code = slot >> shift & 3;
+            if (code == 1)
+            {
+                ++successes;
+                continue;
+            }
+            if (code == 2)
+            {
+                ++failures;
+                continue;
+            }
+
+            Status s;
+            if (jobOf[c] >= 0 && context.jobs)
+            {
+                std::shared_ptr<PendingJob> job = instance.jobs[jobOf[c]];
+                if (job->busy.load(std::memory_order_acquire))
+                {
+                    // In flight, or left over from an earlier run of this node
+                    running = true;
+                    continue;
+                }
+                if (code == 0)
+                {
+                    job->busy.store(true, std::memory_order_relaxed);
+                    job->rng = Rng{ context.rng->next64() };
+                    job->context = TickContext{ context.agent, context.user, nullptr, &job->rng, nullptr };
+                    Action action = actions[tree.getNodes()[c].param];
+                    context.jobs->submit([job, action]
+                        {
+                            job->result = action(job->context);
+                            job->busy.store(false, std::memory_order_release);
+                        });
+                    slot |= 3u << shift;
+                    running = true;
+                    continue;
+                }
+                s = job->result;
+            }
+            else
+                s = run<Instrumented>(c, instance, context);
+
+            code = s == Status::Success ? 1 : s == Status::Failure ? 2 : 0;
+            slot = (slot & ~(3u << shift)) | code << shift;
+            if (s == Status::Success)
+                ++successes;
+            else if (s == Status::Failure)
+                ++failures;
+            else
+                running = true;
+        }
+
+        Status result = successes >= policy.success ? Status::Success
+            : failures >= policy.failure ? Status::Failure
+            : running ? Status::Running
+            : Status::Failure;
+        if (result != Status::Running)
+        {
+            for (std::uint32_t k = 0; k < count; ++k)
+                if ((slot >> 2 * k & 3) == 0)
+                    reset(n.first + k, instance);
+            slot = 0;
+        }
+        return result;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Stops the running nodes of a subtree for one agent by clearing their slots, so the next tick starts them over.
+
+    \param i
+        Index of the subtree's root.
+
+    \param instance
+        The agent's instance block.
+    *******************************************************************************/
+    void BehaviorTree::reset(std::uint32_t i, AgentInstance& instance) const
+    {
+        const FlatTree::FlatNode& n = tree.getNodes()[i];
+        if (slotOf[i] >= 0)
+            instance.slots[slotOf[i]] = 0;
+        for (std::uint32_t c = n.first; c < n.first + n.count; ++c)
+            reset(c, instance);
+    }
+} // end namespace
@@ -0,0 +1,465 @@
+/*!*****************************************************************************
+\file       behavior_tree.h
+\author     Jie Le Jet Ang
+\par        DP email: jielejet.ang@digipen.edu.sg
+\par        Course: CS3183
+\par        Section: A
+\par        Programming Assignment 10
+\date       10-18-2026
+
+\brief
+	Declares BehaviorTree, a shared and immutable behavior tree definition with
+	real Running semantics. Composites remember which child is running and
+	resume there on the next tick; that state lives in a small per-agent
+	AgentInstance block, so one tree can drive any number of agents and long
+	actions never block a frame. In event-driven mode an agent only re-evaluates
+	the branches whose blackboard keys changed since they were last evaluated.
+	Parallel children marked as jobs run on a shared JobSystem; their results
+	are folded in on a later tick, so the ticking thread never waits for them.
+	A tick given a Profiler times every node it runs, and a tick given a
+	TickRing records every node it runs in binary for the tick log. Repeater
+	and Repeat_until_fail stop at their per-tick budget and go on next tick.
+*******************************************************************************/
+#ifndef BEHAVIOR_TREE_H
+#define BEHAVIOR_TREE_H
+
+#include <vector>
+#include <map>
+#include <string>
+#include <cstdint>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include "flat_tree.h"
+#include "job_system.h"
+
+namespace AI
+{
+	// Result of ticking a node; Running means "not done, tick me again"
+	enum class Status : std::uint8_t { Success, Failure, Running };
+
+	// Names of the statuses, for logging
+	const char* const STATUSES[] = { "Success", "Failure", "Running" };
+
+	class Profiler;
+	class TickRing;
+
+	// Data of the agent being ticked, passed to every action
+	struct TickContext
+	{
+		std::uint32_t agent = 0;			// Index of the agent
+		void* user = nullptr;				// Game data of the agent
+		Blackboard* blackboard = nullptr;	// Blackboard of the agent, read by Condition and Assign nodes
+		Rng* rng = nullptr;					// Random stream of the agent, nullptr to use its instance's
+		JobSystem* jobs = nullptr;			// Runs job children of Parallel nodes, nullptr to run them inline
+		Profiler* profiler = nullptr;		// Receives the timing of every node, nullptr to tick untimed
+		TickRing* trace = nullptr;			// Receives a record of every node, nullptr to tick unlogged
+	};
+
+	// Work done by a loop decorator in the current tick, against its budget
+	class LoopMeter
+	{
+		FlatTree::LoopPolicy loop;
+		std::uint32_t runs;
+		std::chrono::steady_clock::time_point start;	// Only read with a time budget
+
+		/*!*****************************************************************************
+		\brief
+			Returns the time since the meter was created.
+
+		\return
+			Elapsed nanoseconds.
+		*******************************************************************************/
+		std::uint64_t elapsed() const
+		{
+			return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now() - start).count());
+		}
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Starts metering a loop; the clock is only read if it has a time budget.
+
+		\param loop
+			The decorator's policy.
+		*******************************************************************************/
+		explicit LoopMeter(FlatTree::LoopPolicy loop)
+			: loop{ loop }, runs{ 0 }, start{}
+		{
+			if (loop.microseconds)
+				start = std::chrono::steady_clock::now();
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Counts a run of the child.
+		*******************************************************************************/
+		void count()
+		{
+			++runs;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Tells if the loop has a budget of its own.
+
+		\return
+			True if an iteration or time limit was configured.
+		*******************************************************************************/
+		bool limited() const
+		{
+			return loop.iterations || loop.microseconds;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Tells if the budget is spent. The child always runs at least once per
+			tick, so a loop makes progress whatever its budget.
+
+		\return
+			True if no more runs fit in this tick.
+		*******************************************************************************/
+		bool spent() const
+		{
+			if (runs == 0)
+				return false;
+			if (loop.iterations && runs >= loop.iterations)
+				return true;
+			return loop.microseconds && elapsed() >= loop.microseconds * 1000ull;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns how far the loop ran past its time budget.
+
+		\return
+			Nanoseconds past the budget, 0 without a time budget or within it.
+		*******************************************************************************/
+		std::uint64_t excess() const
+		{
+			if (!loop.microseconds)
+				return 0;
+			std::uint64_t t = elapsed(), budget = loop.microseconds * 1000ull;
+			return t > budget ? t - budget : 0;
+		}
+	};
+
+	// Leaf action bound to a leaf task by its id
+	using Action = Status(*)(TickContext& context);
+
+	// A job child of a Parallel node, submitted for one agent
+	//     The job gets a copy of the agent's context with a random stream of
+	//     its own and no blackboard, profiler or trace ring, since the rest
+	//     of the tree keeps running on the ticking thread.
+	struct PendingJob
+	{
+		std::atomic<bool> busy{ false };	// Set while the job is queued or running
+		Status result = Status::Failure;	// Written by the job before busy is cleared
+		Rng rng;
+		TickContext context;
+	};
+
+	// Per-agent state of a BehaviorTree
+	//     One slot per node that has to remember something between ticks
+	//     (running child, repetitions done). A slot of 0 means the node is
+	//     not running. Event-driven instances also keep the last status of
+	//     every node and the blackboard stamp it was evaluated at. A copy
+	//     gets job records of its own, so two agents never share a job.
+	struct AgentInstance
+	{
+		std::vector<std::uint32_t> slots;
+		std::vector<Status> cache;			// Last status of every node, empty unless event-driven
+		std::vector<std::uint32_t> stamps;	// Blackboard stamp of every node's last evaluation, 0 if never
+		std::vector<std::shared_ptr<PendingJob>> jobs;	// Record of every job child, kept alive by running jobs
+		Rng rng;							// Random stream used when the tick context has none
+
+		/*!*****************************************************************************
+		\brief
+			Constructs an instance of a tree with no nodes.
+		*******************************************************************************/
+		AgentInstance() = default;
+
+		/*!*****************************************************************************
+		\brief
+			Copies an instance with new job records holding the results of the
+			finished jobs; a job still in flight counts as failed in the copy.
+
+		\param other
+			The instance to copy.
+		*******************************************************************************/
+		AgentInstance(const AgentInstance& other);
+
+		/*!*****************************************************************************
+		\brief
+			Copies an instance with new job records, like the copy constructor.
+
+		\param other
+			The instance to copy.
+
+		\return
+			Reference to this instance.
+		*******************************************************************************/
+		AgentInstance& operator=(const AgentInstance& other);
+
+		AgentInstance(AgentInstance&&) = default;
+		AgentInstance& operator=(AgentInstance&&) = default;
+	};
+
+	// Blackboard keys read by leaves, by leaf task id
+	using Dependencies = std::map<std::string, std::vector<BlackboardKey>>;
+
+	// Shared behavior tree definition with Running semantics
+	class BehaviorTree
+	{
+		FlatTree tree;
+		std::vector<std::int32_t> slotOf;	// Slot index of every node, -1 for stateless nodes
+		std::vector<Action> actions;		// Action of every leaf, nullptr to call the leaf task
+		std::vector<std::uint64_t> deps;	// Blackboard keys read in every node's subtree, as a mask
+		std::vector<std::uint8_t> volatiles;	// Nodes whose subtree has a RandomSelector or a leaf with undeclared inputs
+		std::vector<std::int32_t> jobOf;	// Job record of every job child of a Parallel node, -1 for others
+		std::uint32_t slotCount;
+		std::uint32_t jobCount;
+
+		/*!*****************************************************************************
+		\brief
+			Executes the node at index i for one agent, timing and recording it
+			if Instrumented.
+
+		\param i
+			Index of the node.
+
+		\param instance
+			The agent's instance block.
+
+		\param context
+			The agent's tick context; holds the profiler or trace ring if
+			Instrumented.
+
+		\return
+			Resulting status of the node.
+		*******************************************************************************/
+		template<bool Instrumented>
+		Status run(std::uint32_t i, AgentInstance& instance, TickContext& context) const;
+
+		/*!*****************************************************************************
+		\brief
+			Executes the node at index i for one agent, or returns its cached
+			status in event-driven mode if none of its inputs changed.
+
+		\param i
+			Index of the node.
+
+		\param instance
+			The agent's instance block.
+
+		\param context
+			The agent's tick context.
+
+		\return
+			Resulting status of the node.
+		*******************************************************************************/
+		template<bool Instrumented>
+		Status cached(std::uint32_t i, AgentInstance& instance, TickContext& context) const;
+
+		/*!*****************************************************************************
+		\brief
+			Evaluates the node at index i for one agent.
+
+		\param i
+			Index of the node.
+
+		\param instance
+			The agent's instance block.
+
+		\param context
+			The agent's tick context.
+
+		\return
+			Resulting status of the node.
+		*******************************************************************************/
+		template<bool Instrumented>
+		Status evaluate(std::uint32_t i, AgentInstance& instance, TickContext& context) const;
+
+		/*!*****************************************************************************
+		\brief
+			Evaluates a Parallel node for one agent.
+
+		\param n
+			The node.
+
+		\param slot
+			The node's slot: two bits per child.
+
+		\param instance
+			The agent's instance block.
+
+		\param context
+			The agent's tick context.
+
+		\return
+			Resulting status of the node.
+		*******************************************************************************/
+		template<bool Instrumented>
+		Status parallel(const FlatTree::FlatNode& n, std::uint32_t& slot, AgentInstance& instance,
+			TickContext& context) const;
+
+		/*!*****************************************************************************
+		\brief
+			Stops the running nodes of a subtree for one agent.
+
+		\param i
+			Index of the subtree's root.
+
+		\param instance
+			The agent's instance block.
+		*******************************************************************************/
+		void reset(std::uint32_t i, AgentInstance& instance) const;
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Builds a definition from a built tree and binds actions to its leaves.
+
+		\param root
+			Root task of the tree.
+
+		\param bindings
+			Actions by leaf task id. Leaves without an action call their task, which
+			is shared by all agents.
+
+		\param dependencies
+			Blackboard keys read by leaves, by leaf task id, for event-driven
+			mode. A listed leaf is only re-evaluated when one of its keys changes
+			(an empty list makes it constant); unlisted leaves are evaluated on
+			every tick. Condition and Assign nodes declare their own key.
+		*******************************************************************************/
+		BehaviorTree(SMART root, const std::map<std::string, Action>& bindings = {},
+			const Dependencies& dependencies = {});
+
+		/*!*****************************************************************************
+		\brief
+			Builds a definition from a compiled tree, such as one restored from a
+			TreeLoader cache, and binds actions to its leaves.
+
+		\param compiled
+			The compiled tree.
+
+		\param bindings
+			Actions by leaf task id.
+
+		\param dependencies
+			Blackboard keys read by leaves, by leaf task id, for event-driven
+			mode.
+		*******************************************************************************/
+		BehaviorTree(FlatTree compiled, const std::map<std::string, Action>& bindings = {},
+			const Dependencies& dependencies = {});
+
+		/*!*****************************************************************************
+		\brief
+			Creates the instance block of a new agent.
+
+		\param eventDriven
+			True to re-evaluate only changed branches on ticks (the agent's
+			context must then carry its blackboard).
+
+		\return
+			An instance with all nodes not running.
+		*******************************************************************************/
+		AgentInstance createInstance(bool eventDriven = false) const;
+
+		/*!*****************************************************************************
+		\brief
+			Ticks the tree for one agent, resuming its running nodes. Event-driven
+			instances return the cached status of every branch whose inputs did
+			not change.
+
+		\param instance
+			The agent's instance block.
+
+		\param context
+			The agent's tick context. With a profiler every node is timed and with
+			a trace ring every node is recorded; without either the tick runs
+			code with no timing or recording in it.
+
+		\return
+			Resulting status of the root, Failure for an empty tree.
+		*******************************************************************************/
+		Status tick(AgentInstance& instance, TickContext& context) const;
+
+		/*!*****************************************************************************
+		\brief
+			Executes a leaf for one agent: its bound action, or its task if no
+			action is bound.
+
+		\param leaf
+			Index of the leaf in the compiled tree's leaves.
+
+		\param context
+			The agent's tick context.
+
+		\return
+			Resulting status of the leaf.
+		*******************************************************************************/
+		Status runLeaf(std::int32_t leaf, TickContext& context) const;
+
+		/*!*****************************************************************************
+		\brief
+			Tells if a leaf has a bound action. A leaf without one calls its task,
+			which is shared by all agents, so it must not run on two threads at
+			once.
+
+		\param leaf
+			Index of the leaf in the compiled tree's leaves.
+
+		\return
+			True if an action is bound to the leaf.
+		*******************************************************************************/
+		bool isBound(std::int32_t leaf) const
+		{
+			return actions[leaf] != nullptr;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the slot index of a node.
+
+		\param i
+			Index of the node.
+
+		\return
+			Slot index, or -1 if the node keeps no state between ticks.
+		*******************************************************************************/
+		std::int32_t getSlot(std::uint32_t i) const
+		{
+			return slotOf[i];
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the compiled tree.
+
+		\return
+			Reference to the flat tree.
+		*******************************************************************************/
+		const FlatTree& getTree() const
+		{
+			return tree;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the number of slots of an instance block.
+
+		\return
+			Slot count.
+		*******************************************************************************/
+		std::uint32_t getSlotCount() const
+		{
+			return slotCount;
+		}
+	};
+
+} // end namespace
+
+#endif
@@ -0,0 +1,297 @@
+/*!*****************************************************************************
+\file       blackboard.cpp
+\author     Jie Le Jet Ang
+\par        DP email: jielejet.ang@digipen.edu.sg
+\par        Course: CS3183
+\par        Section: A
+\par        Programming Assignment 10
+\date       10-18-2026
+
+\brief
+    Implements the blackboard: observer registration and notification, the
+    compiled comparisons and writes of Condition and Assign, and the object
+    tree versions of those two nodes.
+*******************************************************************************/
+#include "blackboard.h"
+
+#include <algorithm>
+
+namespace AI
+{
+    namespace
+    {
+        /*!*****************************************************************************
+        \brief
+            Applies a comparison to two values.
+
+        \param a
+            Left value.
+
+        \param compare
+            The comparison.
+
+        \param b
+            Right value.
+
+        \return
+            True if the comparison holds.
+        *******************************************************************************/
+        template<typename T>
+        bool compareValues(T a, Compare compare, T b)
+        {
+            switch (compare)
+            {
+            case Compare::Equal:        return a == b;
+            case Compare::NotEqual:     return a != b;
+            case Compare::Less:         return a < b;
+            case Compare::LessEqual:    return a <= b;
+            case Compare::Greater:      return a > b;
+            case Compare::GreaterEqual: return a >= b;
+            }
+            return false;
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Creates a blackboard with one zeroed cell per declared key, no observers and no changes.
+
+    \param schema
+        The declared keys.
+    *******************************************************************************/
+    Blackboard::Blackboard(const BlackboardSchema& schema)
+        : cells(schema.getSlotCount(), Cell{}), watches(schema.getSlotCount()), notifying{ 0 }, removed{ false },
+        stamp{ 1 }, changedAt{}
+    {
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Writes a raw cell. The cell is compared with the stored one as a value of the key's type, so observers only hear
+        about real changes.
+
+    \param key
+        The key.
+
+    \param value
+        The new value.
+    *******************************************************************************/
+    void Blackboard::setCell(BlackboardKey key, Cell value)
+    {
+        if (!key.valid())
+            return;
+        Cell& cell = cells[key.slot];
+        bool same = key.type == ValueType::Bool ? cell.b == value.b
+            : key.type == ValueType::Float ? cell.f == value.f
+            : cell.i == value.i;
+        if (same)
+            return;
+        cell = value;
+        changed(key.slot);
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Calls the observers of a slot in the order they were registered. Changes only call this for slots that have
+        observers, and the observers of a slot are kept in a list of their own, so a write calls them without scanning
+        other slots or allocating. The list is walked by index up to its length when the change happened: observers
+        registered by an observer are left for the next change, and an unwatched observer is only cleared, so the
+        indices hold until the outermost call returns and the cleared entries are dropped.
+
+    \param slot
+        Index of the slot that changed.
+    *******************************************************************************/
+    void Blackboard::notify(std::int32_t slot)
+    {
+        ++notifying;
+        for (std::size_t w = 0, count = watches[slot].size(); w < count; ++w)
+        {
+            Watch watch = watches[slot][w];
+            if (watch.observer)
+                watch.observer(*this, watch.key, watch.user);
+        }
+        if (--notifying == 0 && removed)
+        {
+            removed = false;
+            for (std::vector<Watch>& list : watches)
+                list.erase(std::remove_if(list.begin(), list.end(), [](const Watch& w)
+                    {
+                        return !w.observer;
+                    }), list.end());
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Registers an observer of a key at the end of its slot's list.
+
+    \param key
+        The key to watch; invalid keys are ignored.
+
+    \param observer
+        Function called after the key changed value.
+
+    \param user
+        Pointer passed back to the observer.
+    *******************************************************************************/
+    void Blackboard::watch(BlackboardKey key, Observer observer, void* user)
+    {
+        if (!key.valid() || !observer)
+            return;
+        watches[key.slot].push_back(Watch{ key, observer, user });
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Removes an observer registered with watch. During a change its entry is only cleared, since the list is being
+        walked; notify drops it afterwards.
+
+    \param key
+        The watched key.
+
+    \param observer
+        The observer.
+
+    \param user
+        The pointer it was registered with.
+    *******************************************************************************/
+    void Blackboard::unwatch(BlackboardKey key, Observer observer, void* user)
+    {
+        if (!key.valid())
+            return;
+        std::vector<Watch>& list = watches[key.slot];
+        auto it = std::find_if(list.begin(), list.end(), [&](const Watch& w)
+            {
+                return w.observer == observer && w.user == user;
+            });
+        if (it == list.end())
+            return;
+        if (notifying)
+        {
+            it->observer = nullptr;
+            removed = true;
+        }
+        else
+            list.erase(it);
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Compares the key's value with the operand as values of the key's type.
+
+    \param board
+        The blackboard to read.
+
+    \return
+        True if the comparison holds; false for an invalid key.
+    *******************************************************************************/
+    bool BlackboardOp::test(const Blackboard& board) const
+    {
+        if (!key.valid())
+            return false;
+        Cell value = board.getCell(key);
+        switch (key.type)
+        {
+        case ValueType::Bool:  return compareValues(value.b, compare, operand.b);
+        case ValueType::Float: return compareValues(value.f, compare, operand.f);
+        case ValueType::Int:
+        default:               return compareValues(value.i, compare, operand.i);
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Writes the operand to the key.
+
+    \param board
+        The blackboard to write.
+    *******************************************************************************/
+    void BlackboardOp::assign(Blackboard& board) const
+    {
+        board.setCell(key, operand);
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Describes the operation for logging: the slot, the operator and the operand.
+
+    \param test
+        True for a test, false for a write.
+
+    \return
+        The description.
+    *******************************************************************************/
+    std::string BlackboardOp::describe(bool test) const
+    {
+        static const char* const symbols[] = { "==", "!=", "<", "<=", ">", ">=" };
+
+        std::ostringstream os;
+        os << "#" << key.slot << (test ? symbols[static_cast<int>(compare)] : "=");
+        switch (key.type)
+        {
+        case ValueType::Bool:  os << (operand.b ? "true" : "false"); break;
+        case ValueType::Float: os << operand.f; break;
+        case ValueType::Int:
+        default:               os << operand.i; break;
+        }
+        return os.str();
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Executes the Condition node: Success if the value of its blackboard compares true with the constant, Failure
+        otherwise or without a blackboard.
+
+    \param log
+        Pointer to the Log stream for output.
+
+    \param depth
+        Depth of the node in the tree, used for indentation of the log output.
+
+    \param rng
+        Random stream of the agent (not used).
+
+    \return
+        Reference to this task after execution.
+    *******************************************************************************/
+    Task& Condition::tick(Log* log, int depth, Rng& rng)
+    {
+        UNUSED(rng);
+        if (log)
+            log_indent(log, depth) << "Condition(" << op.describe(true) << ")\n";
+        state = board && op.test(*board) ? State::Success : State::Failure;
+        log_result(log, depth, state);
+        return *this;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Executes the Assign node: writes the constant to its blackboard and succeeds, or fails without a blackboard.
+
+    \param log
+        Pointer to the Log stream for output.
+
+    \param depth
+        Depth of the node in the tree, used for indentation of the log output.
+
+    \param rng
+        Random stream of the agent (not used).
+
+    \return
+        Reference to this task after execution.
+    *******************************************************************************/
+    Task& Assign::tick(Log* log, int depth, Rng& rng)
+    {
+        UNUSED(rng);
+        if (log)
+            log_indent(log, depth) << "Assign(" << op.describe(false) << ")\n";
+        state = State::Failure;
+        if (board)
+        {
+            op.assign(*board);
+            state = State::Success;
+        }
+        log_result(log, depth, state);
+        return *this;
+    }
+} // end namespace
@@ -0,0 +1,657 @@
+/*!*****************************************************************************
+\file       blackboard.h
+\author     Jie Le Jet Ang
+\par        DP email: jielejet.ang@digipen.edu.sg
+\par        Course: CS3183
+\par        Section: A
+\par        Programming Assignment 10
+\date       10-18-2026
+
+\brief
+	Declares the typed blackboard shared by the nodes of an agent's tree. Keys
+	are declared by name in a BlackboardSchema when the tree is built and come
+	back as typed handles holding an integer slot, so nodes read and write the
+	agent's Blackboard by index without hashing strings. Observers can watch a
+	key and are called when its value changes, and every change is stamped so
+	event-driven trees can tell which keys changed since they last looked.
+	Condition and Assign are the nodes that test and write blackboard values.
+*******************************************************************************/
+#ifndef BLACKBOARD_H
+#define BLACKBOARD_H
+
+#include <vector>
+#include <map>
+#include <string>
+#include <cstdint>
+#include <type_traits>
+#include "functions.h"
+
+namespace AI
+{
+	// Types a blackboard value can have
+	enum class ValueType : std::uint8_t { Bool, Int, Float };
+
+	// Comparisons of a Condition node
+	enum class Compare : std::uint8_t { Equal, NotEqual, Less, LessEqual, Greater, GreaterEqual };
+
+	// Storage of one blackboard value
+	union Cell
+	{
+		bool b;
+		std::int32_t i;
+		float f;
+	};
+
+	/*!*****************************************************************************
+	\brief
+		Returns the ValueType of a C++ type (bool, std::int32_t or float).
+
+	\return
+		The matching value type.
+	*******************************************************************************/
+	template<typename T>
+	constexpr ValueType valueTypeOf()
+	{
+		static_assert(std::is_same<T, bool>::value || std::is_same<T, std::int32_t>::value
+			|| std::is_same<T, float>::value, "Blackboard values are bool, std::int32_t or float");
+		return std::is_same<T, bool>::value ? ValueType::Bool
+			: std::is_same<T, float>::value ? ValueType::Float
+			: ValueType::Int;
+	}
+
+	/*!*****************************************************************************
+	\brief
+		Reads a value of type T from a cell.
+
+	\param cell
+		The cell.
+
+	\return
+		The stored value.
+	*******************************************************************************/
+	template<typename T>
+	T cellGet(const Cell& cell)
+	{
+		if constexpr (std::is_same<T, bool>::value) return cell.b;
+		else if constexpr (std::is_same<T, float>::value) return cell.f;
+		else return cell.i;
+	}
+
+	/*!*****************************************************************************
+	\brief
+		Makes a cell holding a value of type T.
+
+	\param value
+		The value.
+
+	\return
+		The cell.
+	*******************************************************************************/
+	template<typename T>
+	Cell cellOf(T value)
+	{
+		Cell cell{};
+		if constexpr (std::is_same<T, bool>::value) cell.b = value;
+		else if constexpr (std::is_same<T, float>::value) cell.f = value;
+		else cell.i = value;
+		return cell;
+	}
+
+	// Untyped blackboard key: slot index and type
+	struct BlackboardKey
+	{
+		std::int32_t slot = -1;					// -1 for a key that was not found
+		ValueType type = ValueType::Int;
+
+		/*!*****************************************************************************
+		\brief
+			Checks if the key refers to a slot.
+
+		\return
+			True if the key is valid.
+		*******************************************************************************/
+		bool valid() const
+		{
+			return slot >= 0;
+		}
+	};
+
+	// Typed blackboard key
+	template<typename T>
+	struct Key : BlackboardKey
+	{
+	};
+
+	// Names and types of the keys of a blackboard, resolved to slots once
+	class BlackboardSchema
+	{
+		std::map<std::string, std::uint32_t> slots;	// Slot of every key name
+		std::vector<std::string> names;				// Name of every slot
+		std::vector<ValueType> types;				// Type of every slot
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Declares a key, or returns the existing key of that name.
+
+		\param name
+			Name of the key.
+
+		\return
+			The key, invalid if the name was declared with another type.
+		*******************************************************************************/
+		template<typename T>
+		Key<T> add(const std::string& name)
+		{
+			Key<T> key;
+			key.type = valueTypeOf<T>();
+			auto it = slots.find(name);
+			if (it == slots.end())
+			{
+				key.slot = static_cast<std::int32_t>(names.size());
+				slots.emplace(name, static_cast<std::uint32_t>(key.slot));
+				names.push_back(name);
+				types.push_back(key.type);
+			}
+			else if (types[it->second] == key.type)
+				key.slot = static_cast<std::int32_t>(it->second);
+			return key;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Looks up a declared key.
+
+		\param name
+			Name of the key.
+
+		\return
+			The key, invalid if it was not declared or has another type.
+		*******************************************************************************/
+		template<typename T>
+		Key<T> find(const std::string& name) const
+		{
+			Key<T> key;
+			key.type = valueTypeOf<T>();
+			auto it = slots.find(name);
+			if (it != slots.end() && types[it->second] == key.type)
+				key.slot = static_cast<std::int32_t>(it->second);
+			return key;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the number of declared keys.
+
+		\return
+			Slot count.
+		*******************************************************************************/
+		std::uint32_t getSlotCount() const
+		{
+			return static_cast<std::uint32_t>(names.size());
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the name of a slot.
+
+		\param slot
+			Index of the slot.
+
+		\return
+			Reference to the name.
+		*******************************************************************************/
+		const std::string& getName(std::uint32_t slot) const
+		{
+			return names[slot];
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the type of a slot.
+
+		\param slot
+			Index of the slot.
+
+		\return
+			The value type.
+		*******************************************************************************/
+		ValueType getType(std::uint32_t slot) const
+		{
+			return types[slot];
+		}
+	};
+
+	class Blackboard;
+
+	// Called after a watched key changed value
+	using Observer = void(*)(Blackboard& board, BlackboardKey key, void* user);
+
+	// Values of the keys of one agent
+	class Blackboard
+	{
+		// A registered observer
+		struct Watch
+		{
+			BlackboardKey key;
+			Observer observer;
+			void* user;
+		};
+
+		std::vector<Cell> cells;					// Value of every slot
+		std::vector<std::vector<Watch>> watches;	// Observers of every slot, in the order they were registered
+		std::uint32_t notifying;					// Depth of observer calls in progress
+		bool removed;								// An observer was unwatched during a call; its entry is cleared
+		std::uint32_t stamp;						// Number of changes so far, plus one
+		std::uint32_t changedAt[64];				// Stamp of the last change of every slot bit
+
+		/*!*****************************************************************************
+		\brief
+			Stamps a change of a slot and calls its observers.
+
+		\param slot
+			Index of the slot that changed.
+		*******************************************************************************/
+		void changed(std::int32_t slot)
+		{
+			changedAt[slot & 63] = ++stamp;
+			if (!watches[slot].empty())
+				notify(slot);
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Calls the observers of a slot without allocating; observers may watch
+			and unwatch keys.
+
+		\param slot
+			Index of the slot that changed.
+		*******************************************************************************/
+		void notify(std::int32_t slot);
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Creates a blackboard with every declared key zeroed.
+
+		\param schema
+			The declared keys.
+		*******************************************************************************/
+		explicit Blackboard(const BlackboardSchema& schema);
+
+		/*!*****************************************************************************
+		\brief
+			Reads a value.
+
+		\param key
+			The key.
+
+		\return
+			The value, or a zero value for an invalid key.
+		*******************************************************************************/
+		template<typename T>
+		T get(Key<T> key) const
+		{
+			return key.valid() ? cellGet<T>(cells[key.slot]) : T{};
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Writes a value and notifies the key's observers if the value changed.
+
+		\param key
+			The key; nothing is written for an invalid key.
+
+		\param value
+			The new value, converted to the key's type.
+		*******************************************************************************/
+		template<typename T>
+		void set(Key<T> key, std::common_type_t<T> value)
+		{
+			if (!key.valid())
+				return;
+			Cell& cell = cells[key.slot];
+			if (cellGet<T>(cell) == value)
+				return;
+			cell = cellOf<T>(value);
+			changed(key.slot);
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Writes a raw cell, as compiled Assign nodes do, and notifies the key's
+			observers if the value changed.
+
+		\param key
+			The key; nothing is written for an invalid key.
+
+		\param value
+			The new value, of the key's type.
+		*******************************************************************************/
+		void setCell(BlackboardKey key, Cell value);
+
+		/*!*****************************************************************************
+		\brief
+			Returns the raw cell of a valid key.
+
+		\param key
+			The key.
+
+		\return
+			The stored cell.
+		*******************************************************************************/
+		Cell getCell(BlackboardKey key) const
+		{
+			return cells[key.slot];
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Registers an observer of a key.
+
+		\param key
+			The key to watch.
+
+		\param observer
+			Function called after the key changed value; registered during a
+			change, it is first called on the next change.
+
+		\param user
+			Pointer passed back to the observer.
+		*******************************************************************************/
+		void watch(BlackboardKey key, Observer observer, void* user = nullptr);
+
+		/*!*****************************************************************************
+		\brief
+			Removes an observer registered with watch; removed during a change, it
+			is not called for the rest of it.
+
+		\param key
+			The watched key.
+
+		\param observer
+			The observer.
+
+		\param user
+			The pointer it was registered with.
+		*******************************************************************************/
+		void unwatch(BlackboardKey key, Observer observer, void* user = nullptr);
+
+		/*!*****************************************************************************
+		\brief
+			Raises an event on a key: its observers are called and event-driven
+			trees that depend on it re-evaluate, without changing its value.
+
+		\param key
+			The key; invalid keys are ignored.
+		*******************************************************************************/
+		void raise(BlackboardKey key)
+		{
+			if (key.valid())
+				changed(key.slot);
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the stamp of the latest change; it grows with every change.
+
+		\return
+			The current stamp (at least 1).
+		*******************************************************************************/
+		std::uint32_t getStamp() const
+		{
+			return stamp;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Checks if any key of a dependency mask changed after a stamp. Slots
+			share the 64 bits of the mask modulo 64, so a large schema may report
+			a change of a neighbouring key, never miss one.
+
+		\param mask
+			Dependency mask made with maskOf.
+
+		\param since
+			Stamp to compare with.
+
+		\return
+			True if one of the keys changed after the stamp.
+		*******************************************************************************/
+		bool changedSince(std::uint64_t mask, std::uint32_t since) const
+		{
+			for (int b = 0; mask; ++b, mask >>= 1)
+				if ((mask & 1) && changedAt[b] > since)
+					return true;
+			return false;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the dependency mask bit of a key.
+
+		\param key
+			The key.
+
+		\return
+			The bit, 0 for an invalid key.
+		*******************************************************************************/
+		static std::uint64_t maskOf(BlackboardKey key)
+		{
+			return key.valid() ? std::uint64_t{ 1 } << (key.slot & 63) : 0;
+		}
+	};
+
+	// Compiled blackboard test or write: key, comparison and operand
+	struct BlackboardOp
+	{
+		BlackboardKey key;
+		Compare compare = Compare::Equal;
+		Cell operand{};
+
+		/*!*****************************************************************************
+		\brief
+			Compares the key's value with the operand.
+
+		\param board
+			The blackboard to read.
+
+		\return
+			True if the comparison holds; false for an invalid key.
+		*******************************************************************************/
+		bool test(const Blackboard& board) const;
+
+		/*!*****************************************************************************
+		\brief
+			Writes the operand to the key.
+
+		\param board
+			The blackboard to write.
+		*******************************************************************************/
+		void assign(Blackboard& board) const;
+
+		/*!*****************************************************************************
+		\brief
+			Describes the operation for logging, e.g. "#2<30" or "#0=true".
+
+		\param test
+			True for a test, false for a write.
+
+		\return
+			The description.
+		*******************************************************************************/
+		std::string describe(bool test) const;
+	};
+
+	// Succeeds if a blackboard value compares true with a constant
+	class Condition : public Node
+	{
+		BlackboardOp op;
+		Blackboard* board;
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Constructs a Condition node.
+
+		\param key
+			The key to read.
+
+		\param compare
+			The comparison.
+
+		\param value
+			The constant the value is compared with, converted to the key's type.
+
+		\param board
+			Blackboard read when the node is ticked as an object (compiled trees
+			read the agent's blackboard instead).
+		*******************************************************************************/
+		template<typename T>
+		Condition(Key<T> key, Compare compare, std::common_type_t<T> value, Blackboard* board = nullptr)
+			: Node{ "Condition" }, op{ key, compare, cellOf<T>(value) }, board{ board }
+		{
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Virtual override for executing the Condition node; tests the value and
+			logs the result.
+
+		\param log
+			Pointer to the Log stream for output (can be nullptr).
+
+		\param depth
+			Depth of the node in the tree, used for log indentation.
+
+		\param rng
+			Random stream of the agent, drawn from by RandomSelector nodes.
+
+		\return
+			Reference to this task after execution.
+		*******************************************************************************/
+		virtual Task& tick(Log* log, int depth, Rng& rng) override;
+
+		/*!*****************************************************************************
+		\brief
+			Returns the kind of the node.
+
+		\return
+			NodeKind::Condition.
+		*******************************************************************************/
+		virtual NodeKind kind() const override
+		{
+			return NodeKind::Condition;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the compiled test.
+
+		\return
+			Reference to the test.
+		*******************************************************************************/
+		const BlackboardOp& getOp() const
+		{
+			return op;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the blackboard read when the node is ticked as an object.
+
+		\return
+			Pointer to the blackboard (can be nullptr).
+		*******************************************************************************/
+		Blackboard* getBoard() const
+		{
+			return board;
+		}
+	};
+
+	// Writes a constant to a blackboard value and succeeds
+	class Assign : public Node
+	{
+		BlackboardOp op;
+		Blackboard* board;
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Constructs an Assign node.
+
+		\param key
+			The key to write.
+
+		\param value
+			The value written, converted to the key's type.
+
+		\param board
+			Blackboard written when the node is ticked as an object (compiled trees
+			write the agent's blackboard instead).
+		*******************************************************************************/
+		template<typename T>
+		Assign(Key<T> key, std::common_type_t<T> value, Blackboard* board = nullptr)
+			: Node{ "Assign" }, op{ key, Compare::Equal, cellOf<T>(value) }, board{ board }
+		{
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Virtual override for executing the Assign node; writes the value and
+			logs the result.
+
+		\param log
+			Pointer to the Log stream for output (can be nullptr).
+
+		\param depth
+			Depth of the node in the tree, used for log indentation.
+
+		\param rng
+			Random stream of the agent, drawn from by RandomSelector nodes.
+
+		\return
+			Reference to this task after execution.
+		*******************************************************************************/
+		virtual Task& tick(Log* log, int depth, Rng& rng) override;
+
+		/*!*****************************************************************************
+		\brief
+			Returns the kind of the node.
+
+		\return
+			NodeKind::Assign.
+		*******************************************************************************/
+		virtual NodeKind kind() const override
+		{
+			return NodeKind::Assign;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the compiled write.
+
+		\return
+			Reference to the write.
+		*******************************************************************************/
+		const BlackboardOp& getOp() const
+		{
+			return op;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the blackboard written when the node is ticked as an object.
+
+		\return
+			Pointer to the blackboard (can be nullptr).
+		*******************************************************************************/
+		Blackboard* getBoard() const
+		{
+			return board;
+		}
+	};
+
+} // end namespace
+
+#endif
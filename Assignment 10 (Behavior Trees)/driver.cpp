@@ -0,0 +1,1143 @@
+/*!*****************************************************************************
+\file       driver.cpp
+\author     Jie Le Jet Ang
+\par        DP email: jielejet.ang@digipen.edu.sg
+\par        Course: CS3183
+\par        Section: A
+\par        Programming Assignment 10
+\date       10-18-2026
+
+\brief
+    Driver for the behavior tree runtimes. Checks compare the runtimes with
+    each other on the same trees and benchmarks print their measurements.
+    Build it with the other files of the assignment and its data.h; run it
+    with no arguments for every check, or with the names of the checks and
+    benchmarks to run. The exit code is the number of failed checks.
+*******************************************************************************/
+#include "batch_tree.h"
+#include "profiler.h"
+#include "static_tree.h"
+#include "tick_log.h"
+#include "tree_loader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+using namespace AI;
+
+namespace
+{
+    /*!*****************************************************************************
+    \brief
+        Batch action that succeeds for agents with an odd index and fails for the others.
+
+    \param block
+        The agents' state.
+
+    \param agents
+        Indices of the agents.
+
+    \param count
+        Number of agents.
+
+    \param results
+        Receives the status of every agent.
+    *******************************************************************************/
+    void oddAgents(const AgentBlock& block, const std::uint32_t* agents, std::size_t count, Status* results)
+    {
+        UNUSED(block);
+        for (std::size_t k = 0; k < count; ++k)
+            results[k] = agents[k] & 1 ? Status::Success : Status::Failure;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Batch action that always succeeds.
+
+    \param block
+        The agents' state.
+
+    \param agents
+        Indices of the agents.
+
+    \param count
+        Number of agents.
+
+    \param results
+        Receives the status of every agent.
+    *******************************************************************************/
+    void allAgents(const AgentBlock& block, const std::uint32_t* agents, std::size_t count, Status* results)
+    {
+        UNUSED(block);
+        UNUSED(agents);
+        for (std::size_t k = 0; k < count; ++k)
+            results[k] = Status::Success;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Action that succeeds for agents with an odd index and fails for the others.
+
+    \param context
+        The agent's tick context.
+
+    \return
+        Success or Failure.
+    *******************************************************************************/
+    Status oddAgent(TickContext& context)
+    {
+        return context.agent & 1 ? Status::Success : Status::Failure;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Action that succeeds for agents with an even index and fails for the others.
+
+    \param context
+        The agent's tick context.
+
+    \return
+        Success or Failure.
+    *******************************************************************************/
+    Status evenAgent(TickContext& context)
+    {
+        return context.agent & 1 ? Status::Failure : Status::Success;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Action that keeps an agent running for a random while: Running for a third of its ticks, drawn from the
+        agent's random stream, and Success otherwise.
+
+    \param context
+        The agent's tick context.
+
+    \return
+        Running or Success.
+    *******************************************************************************/
+    Status sometimesRunning(TickContext& context)
+    {
+        return context.rng->below(3) == 0 ? Status::Running : Status::Success;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Action whose result is drawn from the script of the agent, the Rng its context's user pointer points to:
+        Success, Failure or Running with equal odds.
+
+    \param context
+        The agent's tick context.
+
+    \return
+        The drawn status.
+    *******************************************************************************/
+    Status scripted(TickContext& context)
+    {
+        std::uint32_t k = static_cast<Rng*>(context.user)->below(3);
+        return k == 0 ? Status::Success : k == 1 ? Status::Failure : Status::Running;
+    }
+
+    // Game data of an agent in the running check
+    struct Walker
+    {
+        int starts = 0;		// Runs of the first leaf
+        int steps = 0;		// Ticks the walk leaf still returns Running
+        int walks = 0;		// Runs of the walk leaf
+        int rests = 0;		// Runs of the rest leaf
+        int arrivals = 0;	// Runs of the last leaf
+    };
+
+    /*!*****************************************************************************
+    \brief
+        Action that counts a start of the agent's walk.
+
+    \param context
+        The agent's tick context; its user pointer is the agent's Walker.
+
+    \return
+        Success.
+    *******************************************************************************/
+    Status startWalk(TickContext& context)
+    {
+        ++static_cast<Walker*>(context.user)->starts;
+        return Status::Success;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Action that walks for as many ticks as the agent has steps left.
+
+    \param context
+        The agent's tick context; its user pointer is the agent's Walker.
+
+    \return
+        Running while steps are left, then Success.
+    *******************************************************************************/
+    Status walk(TickContext& context)
+    {
+        Walker& walker = *static_cast<Walker*>(context.user);
+        ++walker.walks;
+        return walker.steps-- > 0 ? Status::Running : Status::Success;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Action that rests for one tick: Running on every odd run and Success on every even one.
+
+    \param context
+        The agent's tick context; its user pointer is the agent's Walker.
+
+    \return
+        Running or Success.
+    *******************************************************************************/
+    Status rest(TickContext& context)
+    {
+        return ++static_cast<Walker*>(context.user)->rests % 2 ? Status::Running : Status::Success;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Action that counts an arrival of the agent.
+
+    \param context
+        The agent's tick context; its user pointer is the agent's Walker.
+
+    \return
+        Success.
+    *******************************************************************************/
+    Status arrive(TickContext& context)
+    {
+        ++static_cast<Walker*>(context.user)->arrivals;
+        return Status::Success;
+    }
+
+    // Static leaf action running scripted
+    struct Scripted
+    {
+        /*!*****************************************************************************
+        \brief
+            Runs the action.
+
+        \param context
+            The agent's tick context.
+
+        \return
+            The drawn status.
+        *******************************************************************************/
+        static Status run(TickContext& context)
+        {
+            return scripted(context);
+        }
+    };
+
+    // Leaf task that counts its ticks; unsafe to tick from two threads at once
+    class Counter : public Task
+    {
+    public:
+        int ticks = 0;
+
+        /*!*****************************************************************************
+        \brief
+            Constructs the task.
+        *******************************************************************************/
+        Counter()
+            : Task{ "Counter", State::Success }
+        {
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Counts a tick.
+
+        \param log
+            Pointer to the Log stream for output (can be nullptr).
+
+        \param level
+            Indentation string for formatting log output.
+
+        \return
+            Reference to this task.
+        *******************************************************************************/
+        virtual Task& operator()(Log* log = nullptr, std::string level = "") override
+        {
+            ++ticks;
+            return Task::operator()(log, level);
+        }
+    };
+
+    /*!*****************************************************************************
+    \brief
+        Observer that counts the changes it is called for.
+
+    \param board
+        The blackboard (not used).
+
+    \param key
+        The key that changed (not used).
+
+    \param user
+        The int that counts the calls.
+    *******************************************************************************/
+    void countChange(Blackboard& board, BlackboardKey key, void* user)
+    {
+        UNUSED(board);
+        UNUSED(key);
+        ++*static_cast<int*>(user);
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Observer that stops countChange with the same user pointer from watching the key.
+
+    \param board
+        The blackboard.
+
+    \param key
+        The key that changed.
+
+    \param user
+        The pointer countChange was registered with.
+    *******************************************************************************/
+    void unwatchCounter(Blackboard& board, BlackboardKey key, void* user)
+    {
+        board.unwatch(key, &countChange, user);
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Observer that hands the key over to countChange with the same user pointer: it unwatches itself and watches
+        countChange instead.
+
+    \param board
+        The blackboard.
+
+    \param key
+        The key that changed.
+
+    \param user
+        The pointer to register countChange with.
+    *******************************************************************************/
+    void watchCounter(Blackboard& board, BlackboardKey key, void* user)
+    {
+        board.unwatch(key, &watchCounter, user);
+        board.watch(key, &countChange, user);
+    }
+
+    // Custom composite that succeeds if more than half of its children succeed
+    class Majority : public Node
+    {
+        std::vector<SMART> children;
+
+    public:
+        /*!*****************************************************************************
+        \brief
+            Constructs the node.
+
+        \param children
+            Child tasks.
+        *******************************************************************************/
+        explicit Majority(const std::vector<SMART>& children)
+            : Node{ "Majority" }, children{ children }
+        {
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Ticks every child and succeeds if more than half of them succeeded.
+
+        \param log
+            Pointer to the Log stream for output (can be nullptr).
+
+        \param depth
+            Depth of the node in the tree, used for log indentation.
+
+        \param rng
+            Random stream of the agent.
+
+        \return
+            Reference to this task after execution.
+        *******************************************************************************/
+        virtual Task& tick(Log* log, int depth, Rng& rng) override
+        {
+            if (log) log_indent(log, depth) << "Majority()\n";
+
+            std::size_t successes = 0;
+            for (const SMART& child : children)
+                if (tick_child(*child, log, depth + 1, rng).getState() == State::Success)
+                    ++successes;
+            state = 2 * successes > children.size() ? State::Success : State::Failure;
+
+            log_result(log, depth, state);
+            return *this;
+        }
+    };
+
+    /*!*****************************************************************************
+    \brief
+        Makes a Majority node; it needs at least one child.
+
+    \param spec
+        The definition.
+
+    \param schema
+        Schema of the blackboard keys.
+
+    \param error
+        Receives the message on failure.
+
+    \return
+        The node, or an empty pointer on failure.
+    *******************************************************************************/
+    SMART makeMajority(const NodeSpec& spec, BlackboardSchema&, std::string& error)
+    {
+        if (spec.children.empty() || !spec.args.empty())
+        {
+            error = "Majority takes children and no arguments";
+            return {};
+        }
+        return SMART(new Majority(spec.children));
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Returns the log of a compiled tree over 50 ticks, with a random stream of a fixed seed and a blackboard whose
+        health is low.
+
+    \param tree
+        The tree.
+
+    \param schema
+        Schema the tree was loaded with.
+
+    \return
+        The log.
+    *******************************************************************************/
+    std::string logOf(FlatTree& tree, BlackboardSchema& schema)
+    {
+        Blackboard board(schema);
+        board.set(schema.find<float>("health"), 10.0f);
+        Rng stream{ 3 };
+        Log log;
+        for (int t = 0; t < 50; ++t)
+            tree(&log, &board, &stream);
+        return log.str();
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Checks the compiled cache of TreeLoader: trees restored from it, custom composites with their children
+        included, run like the trees it was written from; a cache with a child range patched out of the node array is
+        a miss that load parses again; and Parallel nodes with too many children and RandomSelector nodes with a
+        weight count other than their child count are refused.
+
+    \return
+        True if every part behaves.
+    *******************************************************************************/
+    bool checkCache()
+    {
+        const char* sourcePath = "driver_cache.bt";
+        const char* cachePath = "driver_cache.btc";
+        const std::string text = R"(# guard
+tree guard = Selector {
+    Sequence { Condition(health < 30.0) Assign(fleeing = true) flee }
+    Majority { hide Majority { "look around" Inverter { listen } wait } RandomSelector(1, 3) { a b } }
+    Parallel(1, 1, 0, 1) { sense path }
+    Repeater(3) { Inverter { CheckState(door, Success, Failure) } }
+}
+tree idle = Sequence { wait }
+)";
+        std::ofstream(sourcePath, std::ios::binary) << text;
+        std::remove(cachePath);
+
+        BlackboardSchema parsedSchema, cachedSchema, missSchema;
+        TreeLoader parsed(parsedSchema), cached(cachedSchema), miss(missSchema);
+        for (TreeLoader* loader : { &parsed, &cached, &miss })
+            loader->registerType("Majority", &makeMajority);
+        std::map<std::string, FlatTree> parsedTrees, cachedTrees, missTrees;
+        bool passed = parsed.load(sourcePath, cachePath, parsedTrees)
+            && cached.loadCache(cachePath, cachedTrees, hashText(text))
+            && cachedTrees.size() == 2
+            && logOf(parsedTrees["guard"], parsedSchema) == logOf(cachedTrees["guard"], cachedSchema);
+
+        // Child range of the root of the first tree ("guard"), the first node of the node array: the offset of the
+        // array is the fifth entry of the section table past the magic and hash, and a node's first child follows its
+        // op, a padding byte and its count
+        std::string image;
+        {
+            std::ifstream file(cachePath, std::ios::binary);
+            image.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+        std::uint32_t nodes = 0;
+        if (image.size() >= 4 + 8 + 5 * 8)
+            std::memcpy(&nodes, &image[4 + 8 + 4 * 8], sizeof(nodes));
+        std::size_t at = nodes + 1 + 1 + 2;
+        const std::uint32_t first = 100000;
+        if (nodes == 0 || image.size() < at + sizeof(first))
+            passed = false;
+        else
+        {
+            std::memcpy(&image[at], &first, sizeof(first));
+            std::ofstream(cachePath, std::ios::binary) << image;
+            passed = passed && !miss.loadCache(cachePath, missTrees, hashText(text))
+                && miss.load(sourcePath, cachePath, missTrees)
+                && logOf(parsedTrees["guard"], parsedSchema) == logOf(missTrees["guard"], missSchema);
+        }
+
+        std::string wide = "tree wide = Parallel(1, 1) {";
+        for (int k = 0; k <= Parallel::PARALLEL_MAX; ++k)
+            wide += " t" + std::to_string(k);
+        wide += " }";
+        std::map<std::string, SMART> roots;
+        passed = passed && !parsed.parse(wide, roots) && !parsed.parse("tree r = RandomSelector(1, 2) { a }", roots);
+
+        std::remove(sourcePath);
+        std::remove(cachePath);
+        return passed;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Times loading 5000 small trees, each with a custom composite, cold (parsed, then cached and restored once) and
+        warm (restored from the cache), and prints both. The warm load must restore every tree and take at most a
+        third of the cold one.
+
+    \return
+        True if the warm load restored every tree in time.
+    *******************************************************************************/
+    bool checkWarmLoad()
+    {
+        const char* sourcePath = "driver_warm.bt";
+        const char* cachePath = "driver_warm.btc";
+        const int treeCount = 5000;
+        std::string text;
+        for (int k = 0; k < treeCount; ++k)
+            text += "tree t" + std::to_string(k) + " = Selector {\n"
+                "    Sequence { Condition(health < 30.0) Assign(fleeing = true) flee }\n"
+                "    Majority { hide \"look around\" Inverter { listen } }\n"
+                "    RandomSelector(1, 3) { idle patrol } Repeat_until_fail(4, 200) { search" + std::to_string(k % 50)
+                + " }\n}\n";
+        std::ofstream(sourcePath, std::ios::binary) << text;
+        std::remove(cachePath);
+
+        BlackboardSchema coldSchema, warmSchema;
+        TreeLoader cold(coldSchema), warm(warmSchema);
+        cold.registerType("Majority", &makeMajority);
+        warm.registerType("Majority", &makeMajority);
+        std::map<std::string, FlatTree> coldTrees, warmTrees;
+
+        auto start = std::chrono::steady_clock::now();
+        bool passed = cold.load(sourcePath, cachePath, coldTrees);
+        auto parsed = std::chrono::steady_clock::now();
+        passed = passed && warm.loadCache(cachePath, warmTrees, hashText(text));
+        auto restored = std::chrono::steady_clock::now();
+        std::remove(sourcePath);
+        std::remove(cachePath);
+
+        double coldTime = std::chrono::duration<double, std::milli>(parsed - start).count();
+        double warmTime = std::chrono::duration<double, std::milli>(restored - parsed).count();
+        std::cout << "  " << treeCount << " trees: cold " << coldTime << " ms, warm " << warmTime << " ms\n";
+        return passed && warmTrees.size() == static_cast<std::size_t>(treeCount) && warmTime * 3 <= coldTime;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Checks Parallel nodes: with empty children the object tree and the FlatTree give the same log, children past
+        PARALLEL_MAX are counted as dropped, and agents whose instances were copied from one prototype each fold in
+        the results of their own job children. The job children run on a job system and every agent is ticked until
+        it finishes, which must be with its own result.
+
+    \return
+        True if the logs match, the dropped children are counted and every agent finished with its own result.
+    *******************************************************************************/
+    bool checkParallel()
+    {
+        SMART a(new Task("A", State::Success)), b(new Task("B", State::Failure));
+        SMART root(new Selector{ SMART(new Parallel({ a, nullptr, b, nullptr, a }, 2, 2)),
+            SMART(new Parallel({ nullptr, b }, 1, 1)) });
+        Log objectLog, flatLog;
+        (*root)(&objectLog);
+        FlatTree{ root }(&flatLog);
+        if (objectLog.str() != flatLog.str())
+            return false;
+
+        std::vector<SMART> many(Parallel::PARALLEL_MAX + 2, a);
+        many[3] = nullptr;
+        if (Parallel(many, 0, 1, {}).getDropped() != 1 || Parallel({ a, nullptr, b }).getDropped() != 0)
+            return false;
+
+        SMART job(new Task("Odd"));
+        BehaviorTree tree(SMART(new Parallel({ job, job }, 2, 1, { true, true })), { { "Odd", &oddAgent } });
+        const std::uint32_t agentCount = 64;
+        std::vector<AgentInstance> instances(agentCount, tree.createInstance());
+        std::vector<Status> results(agentCount, Status::Running);
+        JobSystem jobs;
+        for (int t = 0; t < 10000; ++t)
+        {
+            bool running = false;
+            for (std::uint32_t agent = 0; agent < agentCount; ++agent)
+                if (results[agent] == Status::Running)
+                {
+                    TickContext context{ agent, nullptr, nullptr, nullptr, &jobs };
+                    results[agent] = tree.tick(instances[agent], context);
+                    running = running || results[agent] == Status::Running;
+                }
+            if (!running)
+                break;
+            std::this_thread::yield();
+        }
+        for (std::uint32_t agent = 0; agent < agentCount; ++agent)
+        {
+            TickContext context{ agent };
+            if (results[agent] != oddAgent(context))
+                return false;
+        }
+        return true;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Checks BatchTree against BehaviorTree::tick agent by agent, with the same random streams, over ticks where
+        agents keep running: every root status must match. With a job system, a tree whose Counter leaf has no
+        action is ticked on one thread, so the shared task sees every tick; with Counter bound to a batch action the
+        block is split across the job system and must still match.
+
+    \return
+        True if every status and tick count matches.
+    *******************************************************************************/
+    bool checkBatch()
+    {
+        std::shared_ptr<Counter> counter(new Counter);
+        SMART root(new Selector{
+            SMART(new Sequence{ SMART(new RandomSelector{ SMART(new Task("Alert")), SMART(new Task("Patrol")),
+                counter }), SMART(new Task("Wait")), SMART(new Repeater(counter, 2)) }),
+            SMART(new Succeeder(counter)) });
+        BehaviorTree tree(root, { { "Alert", &oddAgent }, { "Patrol", &oddAgent }, { "Wait", &sometimesRunning } });
+        BatchTree shared(tree, { { "Alert", &oddAgents } });
+        BatchTree split(tree, { { "Alert", &oddAgents }, { "Counter", &allAgents } });
+
+        const std::uint32_t agentCount = 5000;
+        const std::uint64_t seed = 9;
+        JobSystem jobs(4);
+        for (const BatchTree* batch : { &shared, &split })
+        {
+            AgentBlock block = batch->createBlock(agentCount, seed);
+            std::vector<AgentInstance> instances(agentCount, tree.createInstance());
+            std::vector<Rng> rngs;
+            for (std::uint32_t agent = 0; agent < agentCount; ++agent)
+                rngs.push_back(Rng::forAgent(seed, agent));
+
+            for (int t = 0; t < 20; ++t)
+            {
+                counter->ticks = 0;
+                batch->tick(block, &jobs, 64);
+                int batchTicks = counter->ticks;
+
+                counter->ticks = 0;
+                for (std::uint32_t agent = 0; agent < agentCount; ++agent)
+                {
+                    TickContext context{ agent, nullptr, nullptr, &rngs[agent] };
+                    if (tree.tick(instances[agent], context) != block.status[agent])
+                        return false;
+                }
+                if (batch == &shared && batchTicks != counter->ticks)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Checks the typed blackboard: values round-trip through their keys, a name declared again with another type
+        gives an invalid key, observers are called for real changes and raised events only, watches made or removed by
+        an observer apply as documented.
+
+    \return
+        True if every part behaves.
+    *******************************************************************************/
+    bool checkBlackboard()
+    {
+        BlackboardSchema schema;
+        Key<bool> alive = schema.add<bool>("alive");
+        Key<std::int32_t> ammo = schema.add<std::int32_t>("ammo");
+        Key<float> health = schema.add<float>("health");
+        Blackboard board(schema);
+        board.set(alive, true);
+        board.set(ammo, 12);
+        board.set(health, 3);
+        bool passed = board.get(alive) && board.get(ammo) == 12 && board.get(health) == 3.0f
+            && !schema.add<float>("ammo").valid() && !schema.find<bool>("health").valid()
+            && schema.find<std::int32_t>("ammo").slot == ammo.slot && board.get(schema.find<float>("none")) == 0.0f;
+
+        int ammoChanges = 0, healthChanges = 0, handedOver = 0;
+        board.watch(ammo, &countChange, &ammoChanges);
+        board.set(ammo, 5);
+        board.set(ammo, 5);
+        board.raise(ammo);
+        BlackboardOp{ ammo, Compare::Equal, cellOf<std::int32_t>(7) }.assign(board);
+        passed = passed && ammoChanges == 3 && board.get(ammo) == 7;
+
+        board.watch(health, &unwatchCounter, &healthChanges);
+        board.watch(health, &countChange, &healthChanges);
+        board.watch(health, &watchCounter, &handedOver);
+        board.set(health, 50.0f);
+        passed = passed && healthChanges == 0 && handedOver == 0;
+        board.set(health, 40.0f);
+        passed = passed && healthChanges == 0 && handedOver == 1;
+
+        for (std::int32_t k = 0; k < 1000; ++k)
+            board.set(ammo, k);
+        return passed && ammoChanges == 3 + 1000 && healthChanges == 0 && handedOver == 1;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Checks event-driven instances against instances that evaluate every node, over random seeds: each agent has a
+        blackboard per instance, both given the same random changes before every tick, and its own random stream per
+        instance. The tree has a RandomSelector over leaves with no inputs, which must still pick again on every tick,
+        and a leaf that keeps running. Every root status must match.
+
+    \return
+        True if every status matches.
+    *******************************************************************************/
+    bool checkEvents()
+    {
+        BlackboardSchema schema;
+        Key<float> health = schema.add<float>("health");
+        Key<bool> alert = schema.add<bool>("alert");
+        Key<bool> fleeing = schema.add<bool>("fleeing");
+        SMART root(new Selector{
+            SMART(new Sequence{ SMART(new Condition(health, Compare::Less, 30.0f)),
+                SMART(new Assign(fleeing, true)), SMART(new Task("Flee")) }),
+            SMART(new Sequence{ SMART(new Condition(alert, Compare::Equal, true)),
+                SMART(new RandomSelector{ SMART(new Task("Shoot")), SMART(new Task("Miss")) }) }),
+            SMART(new Sequence{ SMART(new Task("Look")), SMART(new Task("Wait")) }) });
+        BehaviorTree tree(root,
+            { { "Flee", &oddAgent }, { "Shoot", &oddAgent }, { "Miss", &evenAgent }, { "Look", &evenAgent },
+                { "Wait", &sometimesRunning } },
+            { { "Flee", { fleeing } }, { "Shoot", {} }, { "Miss", {} }, { "Look", {} } });
+
+        const std::uint32_t agentCount = 16;
+        for (std::uint64_t seed = 1; seed <= 20; ++seed)
+        {
+            Rng changes{ seed };
+            std::vector<Blackboard> eventBoards(agentCount, Blackboard(schema)), fullBoards = eventBoards;
+            std::vector<AgentInstance> eventInstances(agentCount, tree.createInstance(true));
+            std::vector<AgentInstance> fullInstances(agentCount, tree.createInstance());
+            std::vector<Rng> eventRngs, fullRngs;
+            for (std::uint32_t agent = 0; agent < agentCount; ++agent)
+            {
+                eventRngs.push_back(Rng::forAgent(seed, agent));
+                fullRngs.push_back(Rng::forAgent(seed, agent));
+            }
+
+            for (int t = 0; t < 60; ++t)
+                for (std::uint32_t agent = 0; agent < agentCount; ++agent)
+                {
+                    for (std::vector<Blackboard>* boards : { &eventBoards, &fullBoards })
+                    {
+                        Blackboard& board = (*boards)[agent];
+                        if (t % 7 == 0)
+                            board.set(fleeing, false);
+                        board.set(health, t % 20 < 5 ? 10.0f : 80.0f);
+                        board.set(alert, (t + agent) % 9 < 6);
+                    }
+                    if (changes.below(4) == 0)
+                    {
+                        eventBoards[agent].raise(alert);
+                        fullBoards[agent].raise(alert);
+                    }
+                    TickContext eventContext{ agent, nullptr, &eventBoards[agent], &eventRngs[agent] };
+                    TickContext fullContext{ agent, nullptr, &fullBoards[agent], &fullRngs[agent] };
+                    if (tree.tick(eventInstances[agent], eventContext) != tree.tick(fullInstances[agent], fullContext))
+                        return false;
+                }
+        }
+        return true;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Checks loop budgets on a Repeat_until_fail whose child never fails. In a BehaviorTree the node without a budget
+        runs its child once per tick with no overrun, and the node with a budget of 3 runs it 3 times per tick with an
+        overrun on every tick. In the object tree an iteration or time budget stops the node with an Undefined state,
+        and the FlatTree gives the same log.
+
+    \return
+        True if every run count, overrun count and state matches.
+    *******************************************************************************/
+    bool checkLoops()
+    {
+        std::shared_ptr<Counter> counter(new Counter);
+        BehaviorTree plain(SMART(new Repeat_until_fail(counter)));
+        BehaviorTree budgeted(SMART(new Repeat_until_fail(counter, { 3, 0 })));
+        bool passed = true;
+        for (const BehaviorTree* tree : { &plain, &budgeted })
+        {
+            Profiler profiler(*tree);
+            AgentInstance instance = tree->createInstance();
+            counter->ticks = 0;
+            for (int t = 0; t < 5; ++t)
+            {
+                TickContext context{ 0, nullptr, nullptr, nullptr, nullptr, &profiler };
+                passed = passed && tree->tick(instance, context) == Status::Running;
+            }
+            std::uint64_t overruns = tree == &plain ? 0 : 5;
+            passed = passed && counter->ticks == (tree == &plain ? 5 : 15) && profiler.getNode(0).overruns == overruns;
+        }
+
+        counter->ticks = 0;
+        SMART loop(new Repeat_until_fail(counter, { 4, 0 }));
+        Log objectLog, flatLog;
+        passed = passed && (*loop)(&objectLog).getState() == State::Undefined && counter->ticks == 4
+            && FlatTree{ loop }(&flatLog) == State::Undefined && objectLog.str() == flatLog.str();
+
+        SMART timed(new Repeat_until_fail(counter, { 0, 200 }));
+        return passed && (*timed)().getState() == State::Undefined && FlatTree{ timed }() == State::Undefined;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Checks Running and resuming: one BehaviorTree drives agents that walk for a different number of ticks, each
+        with its own instance block. A Sequence resumes at its running child, so an agent that walks n ticks finishes
+        walking on tick n + 1 with the first leaf run once. A Selector then resumes at a Repeater that rests twice, one
+        tick each, and resumes at its running repetition, so the agent arrives on tick n + 3 having walked n + 1 times
+        and rested 4 times.
+
+    \return
+        True if every agent finished on its tick with every leaf run the expected number of times.
+    *******************************************************************************/
+    bool checkRunning()
+    {
+        BehaviorTree tree(SMART(new Sequence{ SMART(new Task("Start")),
+            SMART(new Selector{ SMART(new Inverter(SMART(new Task("Walk")))),
+                SMART(new Repeater(SMART(new Task("Rest")), 2)) }),
+            SMART(new Task("Arrive")) }),
+            { { "Start", &startWalk }, { "Walk", &walk }, { "Rest", &rest }, { "Arrive", &arrive } });
+
+        const std::uint32_t agentCount = 64;
+        std::vector<Walker> walkers(agentCount);
+        std::vector<AgentInstance> instances(agentCount, tree.createInstance());
+        std::vector<int> finished(agentCount, 0);
+        for (std::uint32_t agent = 0; agent < agentCount; ++agent)
+            walkers[agent].steps = static_cast<int>(agent % 7);
+        for (int t = 1; t <= 10; ++t)
+            for (std::uint32_t agent = 0; agent < agentCount; ++agent)
+                if (!finished[agent])
+                {
+                    TickContext context{ agent, &walkers[agent] };
+                    Status s = tree.tick(instances[agent], context);
+                    if (s == Status::Failure)
+                        return false;
+                    if (s == Status::Success)
+                        finished[agent] = t;
+                }
+
+        for (std::uint32_t agent = 0; agent < agentCount; ++agent)
+        {
+            const Walker& walker = walkers[agent];
+            int steps = static_cast<int>(agent % 7);
+            if (finished[agent] != steps + 3 || walker.starts != 1 || walker.walks != steps + 1 || walker.rests != 4
+                || walker.arrivals != 1)
+                return false;
+        }
+        return true;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Checks the Profiler: agents are profiled in two halves, as two threads would, and all together. The merged
+        halves must give the totals of the whole run node by node; the root counts every tick with the statuses the
+        ticks returned; every node's statuses add up to its ticks and its self time is within its total; the folded
+        stacks add up to the self times; ticks without a profiler leave the totals alone and clear empties them.
+
+    \return
+        True if every total matches.
+    *******************************************************************************/
+    bool checkProfiler()
+    {
+        BehaviorTree tree(SMART(new Selector{
+            SMART(new Sequence{ SMART(new Task("Alert")), SMART(new Repeater(SMART(new Task("Patrol")), 3)) }),
+            SMART(new Task("Idle")) }),
+            { { "Alert", &oddAgent }, { "Patrol", &sometimesRunning }, { "Idle", &evenAgent } });
+
+        const std::uint32_t agentCount = 100;
+        const int tickCount = 10;
+        Profiler halves[2] = { Profiler(tree), Profiler(tree) }, whole(tree);
+        std::uint64_t statuses[3] = {};
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            std::vector<AgentInstance> instances(agentCount, tree.createInstance());
+            std::vector<Rng> rngs;
+            for (std::uint32_t agent = 0; agent < agentCount; ++agent)
+                rngs.push_back(Rng::forAgent(5, agent));
+            for (int t = 0; t < tickCount; ++t)
+                for (std::uint32_t agent = 0; agent < agentCount; ++agent)
+                {
+                    Profiler* profiler = pass ? &whole : &halves[agent < agentCount / 2 ? 0 : 1];
+                    TickContext context{ agent, nullptr, nullptr, &rngs[agent], nullptr, profiler };
+                    Status s = tree.tick(instances[agent], context);
+                    if (pass)
+                        ++statuses[static_cast<int>(s)];
+                }
+        }
+        halves[0].merge(halves[1]);
+
+        const NodeProfile& root = whole.getNode(0);
+        bool passed = whole.getNodeCount() == tree.getTree().getNodes().size()
+            && root.ticks == std::uint64_t{ agentCount } * tickCount
+            && std::equal(statuses, statuses + 3, root.statuses);
+        std::uint64_t self = 0;
+        for (std::uint32_t i = 0; i < whole.getNodeCount(); ++i)
+        {
+            const NodeProfile& n = whole.getNode(i), & m = halves[0].getNode(i);
+            passed = passed && n.ticks == m.ticks && std::equal(n.statuses, n.statuses + 3, m.statuses)
+                && n.statuses[0] + n.statuses[1] + n.statuses[2] == n.ticks && n.self <= n.total;
+            self += n.self;
+        }
+
+        std::stringstream folded;
+        whole.writeFlameGraph(folded);
+        std::string line;
+        std::uint64_t stacked = 0;
+        while (std::getline(folded, line))
+            stacked += std::stoull(line.substr(line.rfind(' ') + 1));
+        passed = passed && stacked == self;
+
+        std::uint64_t ticks = root.ticks;
+        AgentInstance instance = tree.createInstance();
+        TickContext context{ 1 };
+        tree.tick(instance, context);
+        passed = passed && root.ticks == ticks;
+        whole.clear();
+        return passed && whole.getNode(0).ticks == 0 && whole.getNode(0).total == 0;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Checks the binary tick log against the text log of the object tree. Agents are ticked by a BehaviorTree whose
+        leaves call their tasks, writing to the rings of two ticking threads, and by the object tree writing to a Log,
+        with random streams of the same seed. The records are drained, saved and loaded, and every agent's decoded
+        text must match its object tree log. A ring too small for a tick drops records and counts them.
+
+    \return
+        True if every agent's text matches and the dropped records are counted.
+    *******************************************************************************/
+    bool checkTickLog()
+    {
+        const char* path = "driver_ticks.btl";
+        SMART a(new Task("A", State::Success)), b(new Task("B", State::Failure));
+        SMART root(new Selector{
+            SMART(new Sequence{ SMART(new RandomSelector{ a, b, SMART(new Inverter(b)) }), SMART(new Repeater(a, 2)),
+                SMART(new Parallel({ a, b, a }, 2, 2)) }),
+            SMART(new Sequence{ SMART(new Repeat_until_fail(b)), SMART(new Succeeder(b)), b }),
+            SMART(new CheckState(*a, State::Success)) });
+        BehaviorTree tree(root);
+
+        const std::uint32_t agentCount = 8;
+        const int tickCount = 20;
+        TickLog log;
+        TickRing* rings[2] = { &log.createRing(), &log.createRing() };
+        std::vector<AgentInstance> instances(agentCount, tree.createInstance());
+        std::vector<std::string> expected(agentCount);
+        for (std::uint32_t agent = 0; agent < agentCount; ++agent)
+        {
+            Rng treeStream = Rng::forAgent(1, agent), objectStream = Rng::forAgent(1, agent);
+            Log objectLog;
+            for (int t = 0; t < tickCount; ++t)
+            {
+                TickContext context{ agent, nullptr, nullptr, &treeStream, nullptr, nullptr, rings[(agent + t) % 2] };
+                tree.tick(instances[agent], context);
+                static_cast<Node&>(*root).tick(&objectLog, 0, objectStream);
+            }
+            expected[agent] = objectLog.str();
+        }
+
+        std::vector<TickRecord> drained, loaded;
+        std::vector<std::string> labels;
+        log.drain(drained);
+        bool passed = !drained.empty() && log.getDropped() == 0 && saveTickLog(path, tree.getTree(), drained)
+            && loadTickLog(path, labels, loaded);
+        std::remove(path);
+        for (std::uint32_t agent = 0; passed && agent < agentCount; ++agent)
+        {
+            std::stringstream text;
+            decodeTickLog(loaded, labels, text, agent);
+            passed = text.str() == expected[agent];
+        }
+
+        TickLog tiny(8);
+        AgentInstance instance = tree.createInstance();
+        TickContext context{ 0, nullptr, nullptr, nullptr, nullptr, nullptr, &tiny.createRing() };
+        tree.tick(instance, context);
+        std::vector<TickRecord> kept;
+        return passed && tiny.drain(kept) == 8 && tiny.getDropped() > 0;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Checks a static tree against the BehaviorTree of the same shape, with every composite and decorator in it. Both
+        copies of an agent draw their leaf results from scripts with the same seed, Running included, and their
+        RandomSelector picks from streams with the same seed; every root status must match on every tick.
+
+    \return
+        True if every status matches.
+    *******************************************************************************/
+    bool checkStatic()
+    {
+        using Leaf = Static::Act<Scripted>;
+        using Root = Static::Selector<
+            Static::Sequence<Leaf, Static::Inverter<Leaf>, Static::Repeater<3, Leaf, 2>>,
+            Static::RandomSelector<Leaf, Static::Sequence<Leaf, Leaf>, Static::Succeeder<Leaf>>,
+            Static::Parallel<2, 2, Leaf, Leaf, Leaf>,
+            Static::Repeat_until_fail<Leaf, 2>>;
+
+        SMART leaf(new Task("Leaf"));
+        SMART root(new Selector{
+            SMART(new Sequence{ leaf, SMART(new Inverter(leaf)), SMART(new Repeater(leaf, 3, { 2, 0 })) }),
+            SMART(new RandomSelector{ leaf, SMART(new Sequence{ leaf, leaf }), SMART(new Succeeder(leaf)) }),
+            SMART(new Parallel({ leaf, leaf, leaf }, 2, 2)),
+            SMART(new Repeat_until_fail(leaf, { 2, 0 })) });
+        BehaviorTree tree(root, { { "Leaf", &scripted } });
+
+        const std::uint32_t agentCount = 200;
+        for (std::uint64_t seed = 1; seed <= 10; ++seed)
+        {
+            std::vector<Static::StaticTree<Root>::Memory> memories(agentCount);
+            std::vector<AgentInstance> instances(agentCount, tree.createInstance());
+            std::vector<Rng> staticScripts, treeScripts, staticPicks, treePicks;
+            for (std::uint32_t agent = 0; agent < agentCount; ++agent)
+            {
+                staticScripts.push_back(Rng::forAgent(seed, agent));
+                treeScripts.push_back(Rng::forAgent(seed, agent));
+                staticPicks.push_back(Rng::forAgent(seed + 100, agent));
+                treePicks.push_back(Rng::forAgent(seed + 100, agent));
+            }
+
+            for (int t = 0; t < 50; ++t)
+                for (std::uint32_t agent = 0; agent < agentCount; ++agent)
+                {
+                    TickContext staticContext{ agent, &staticScripts[agent], nullptr, &staticPicks[agent] };
+                    TickContext treeContext{ agent, &treeScripts[agent], nullptr, &treePicks[agent] };
+                    if (Static::StaticTree<Root>::tick(memories[agent], staticContext)
+                        != tree.tick(instances[agent], treeContext))
+                        return false;
+                }
+        }
+        return true;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Prints the agents ticked per millisecond at 1k, 10k and 100k agents by BatchTree, on this thread and on a
+        job system sized to the hardware threads. The tree is a guard: a Sequence that checks a condition and
+        patrols a few times, falling back to an idle action.
+
+    \return
+        True.
+    *******************************************************************************/
+    bool benchThroughput()
+    {
+        SMART root(new Selector{
+            SMART(new Sequence{ SMART(new Task("Alert")), SMART(new Repeater(SMART(new Task("Patrol")), 3)),
+                SMART(new Inverter(SMART(new Task("Alert")))) }),
+            SMART(new Succeeder(SMART(new Task("Idle")))) });
+        BehaviorTree tree(root);
+        BatchTree batch(tree, { { "Alert", &oddAgents }, { "Patrol", &allAgents }, { "Idle", &allAgents } });
+
+        std::cout << "One thread:\n";
+        reportThroughput(std::cout, batch, nullptr);
+        JobSystem jobs;
+        std::cout << "Job system:\n";
+        reportThroughput(std::cout, batch, &jobs);
+        return true;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Checks that the object tree and the compiled FlatTree pick the same RandomSelector children, weighted or not
+        and with empty children, when they draw from streams with the same seed: their logs over 200 ticks must match.
+
+    \return
+        True if the logs match.
+    *******************************************************************************/
+    bool checkRandomPicks()
+    {
+        SMART a(new Task("A", State::Success)), b(new Task("B", State::Failure)), c(new Task("C", State::Success));
+        SMART root(new Sequence{
+            SMART(new RandomSelector{ a, nullptr, b, c }),
+            SMART(new RandomSelector({ b, c, nullptr, a }, { 1.0f, 3.0f, 5.0f, 6.0f })),
+            SMART(new Succeeder(SMART(new RandomSelector{ c, b }))) });
+        FlatTree flat(root);
+
+        Rng objectStream{ 7 }, flatStream{ 7 };
+        Log objectLog, flatLog;
+        for (int t = 0; t < 200; ++t)
+        {
+            static_cast<Node&>(*root).tick(&objectLog, 0, objectStream);
+            flat(&flatLog, nullptr, &flatStream);
+        }
+        return objectLog.str() == flatLog.str();
+    }
+
+    // A check or benchmark of the driver
+    struct Test
+    {
+        const char* name;
+        bool (*run)();
+        bool benchmark;	// Only run when named
+    };
+
+    const Test TESTS[] = {
+        { "random", &checkRandomPicks, false },
+        { "cache", &checkCache, false },
+        { "warmload", &checkWarmLoad, false },
+        { "parallel", &checkParallel, false },
+        { "batch", &checkBatch, false },
+        { "blackboard", &checkBlackboard, false },
+        { "events", &checkEvents, false },
+        { "loops", &checkLoops, false },
+        { "running", &checkRunning, false },
+        { "profiler", &checkProfiler, false },
+        { "static", &checkStatic, false },
+        { "ticklog", &checkTickLog, false },
+        { "throughput", &benchThroughput, true },
+    };
+}
+
+/*!*****************************************************************************
+\brief
+    Runs every check, or the checks and benchmarks named on the command line, and prints the result of every check.
+
+\param argc
+    Number of arguments.
+
+\param argv
+    The arguments.
+
+\return
+    Number of failed checks.
+*******************************************************************************/
+int main(int argc, char* argv[])
+{
+    int failed = 0;
+    for (const Test& test : TESTS)
+    {
+        bool named = argc == 1 && !test.benchmark;
+        for (int a = 1; a < argc; ++a)
+            named = named || std::strcmp(argv[a], test.name) == 0;
+        if (!named)
+            continue;
+        bool passed = test.run();
+        if (!test.benchmark)
+            std::cout << test.name << ": " << (passed ? "passed" : "FAILED") << "\n";
+        failed += passed ? 0 : 1;
+    }
+    return failed;
+}
@@ -0,0 +1,320 @@
+/*!*****************************************************************************
+\file       flat_tree.cpp
+\author     Jie Le Jet Ang
+\par        DP email: jielejet.ang@digipen.edu.sg
+\par        Course: CS3183
+\par        Section: A
+\par        Programming Assignment 10
+\date       10-18-2026
+
+\brief
+    Implements FlatTree: the compiler that lays a built behavior tree out as an
+    array with contiguous child ranges, and the opcode interpreter that ticks it
+    with the same results and log output as the object tree.
+*******************************************************************************/
+#include "flat_tree.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace AI
+{
+    /*!*****************************************************************************
+    \brief
+        Compiles a built tree. Nodes are laid out breadth first: when a node is visited its children are appended to the
+        array together, which gives every node a contiguous child range. Known node kinds become opcodes; any other task
+        (including custom Node types) becomes a Leaf that is called through its operator().
+
+    \param root
+        Root task of the tree.
+    *******************************************************************************/
+    FlatTree::FlatTree(SMART root)
+        : nodes{}, leaves{}, boardOps{}, boards{}, aliases{}, policies{}, loops{}, labels{}
+    {
+        if (!root)
+            return;
+
+        std::vector<SMART> tasks{ root };
+        nodes.push_back(FlatNode{});
+        labels.push_back({});
+
+        std::vector<SMART> children;
+        for (std::size_t i = 0; i < tasks.size(); ++i)
+        {
+            SMART task = tasks[i];
+            FlatNode n{ Op::Leaf, 0, 0, 0 };
+            std::string label = task->getId();
+
+            children.clear();
+            Node* node = dynamic_cast<Node*>(task.get());
+            NodeKind kind = node ? node->kind() : NodeKind::Custom;
+            switch (kind)
+            {
+            case NodeKind::Selector:          n.op = Op::Selector;          label = "Selector()";          break;
+            case NodeKind::Sequence:          n.op = Op::Sequence;          label = "Sequence()";          break;
+            case NodeKind::RandomSelector:
+            {
+                std::vector<float> weights;
+                static_cast<RandomSelector*>(node)->getWeights(weights);
+                n.op = Op::RandomSelector;
+                n.param = -1;
+                if (!weights.empty())
+                {
+                    n.param = static_cast<std::int32_t>(aliases.size());
+                    aliases.emplace_back(weights);
+                }
+                label = "RandomSelector()";
+                break;
+            }
+            case NodeKind::Parallel:
+            {
+                Parallel* parallel = static_cast<Parallel*>(node);
+                int success = parallel->getSuccessThreshold(), failure = parallel->getFailureThreshold();
+                n.op = Op::Parallel;
+                n.param = static_cast<std::int32_t>(policies.size());
+                policies.push_back(ParallelPolicy{ static_cast<std::uint16_t>(success),
+                    static_cast<std::uint16_t>(failure), parallel->getJobMask() });
+                label = "Parallel(" + std::to_string(success) + "," + std::to_string(failure) + ")";
+                break;
+            }
+            case NodeKind::Inverter:          n.op = Op::Inverter;          label = "Inverter()";          break;
+            case NodeKind::Succeeder:         n.op = Op::Succeeder;         label = "Succeeder()";         break;
+            case NodeKind::Repeat_until_fail:
+            {
+                LoopBudget budget = static_cast<Repeat_until_fail*>(node)->getBudget();
+                n.op = Op::Repeat_until_fail;
+                n.param = static_cast<std::int32_t>(loops.size());
+                loops.push_back(LoopPolicy{ 0, static_cast<std::uint32_t>(std::max(budget.iterations, 0)),
+                    static_cast<std::uint32_t>(std::max(budget.microseconds, 0)) });
+                label = "Repeat_until_fail()";
+                break;
+            }
+            case NodeKind::Repeater:
+            {
+                Repeater* repeater = static_cast<Repeater*>(node);
+                int counter = repeater->getCounter();
+                LoopBudget budget = repeater->getBudget();
+                n.op = Op::Repeater;
+                n.param = static_cast<std::int32_t>(loops.size());
+                loops.push_back(LoopPolicy{ counter, static_cast<std::uint32_t>(std::max(budget.iterations, 0)),
+                    static_cast<std::uint32_t>(std::max(budget.microseconds, 0)) });
+                label = "Repeater(" + std::to_string(counter) + ")";
+                break;
+            }
+            case NodeKind::CheckState:
+            {
+                // The checked task is a copy owned by the node, so the result never changes
+                CheckState* check = static_cast<CheckState*>(node);
+                Task checktask = check->getCheckTask();
+                n.op = Op::CheckState;
+                n.param = checktask.getState() == check->getCheckState() ? State::Success : State::Failure;
+                label = "CheckState(" + checktask.getId() + "," + STATES[check->getCheckState()] + ")";
+                break;
+            }
+            case NodeKind::Condition:
+            {
+                // The key was resolved to a slot when the node was built, so the test is stored as is
+                Condition* condition = static_cast<Condition*>(node);
+                n.op = Op::Condition;
+                n.param = static_cast<std::int32_t>(boardOps.size());
+                boardOps.push_back(condition->getOp());
+                boards.push_back(condition->getBoard());
+                label = "Condition(" + condition->getOp().describe(true) + ")";
+                break;
+            }
+            case NodeKind::Assign:
+            {
+                Assign* assign = static_cast<Assign*>(node);
+                n.op = Op::Assign;
+                n.param = static_cast<std::int32_t>(boardOps.size());
+                boardOps.push_back(assign->getOp());
+                boards.push_back(assign->getBoard());
+                label = "Assign(" + assign->getOp().describe(false) + ")";
+                break;
+            }
+            case NodeKind::Custom:
+            default:
+                n.param = static_cast<std::int32_t>(leaves.size());
+                leaves.push_back(task);
+                break;
+            }
+
+            if (n.op != Op::Leaf)
+                node->getChildren(children);
+            n.first = static_cast<std::uint32_t>(nodes.size());
+            n.count = static_cast<std::uint16_t>(children.size());
+            for (const SMART& child : children)
+            {
+                tasks.push_back(child);
+                nodes.push_back(FlatNode{});
+                labels.push_back({});
+            }
+
+            nodes[i] = n;
+            labels[i] = label;
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Ticks the whole tree once.
+
+    \param log
+        Pointer to the Log stream for output.
+
+    \param board
+        Blackboard read and written by Condition and Assign nodes.
+
+    \param rng
+        Random stream drawn from by RandomSelector nodes, nullptr for the calling thread's default stream.
+
+    \return
+        Resulting state of the root, Failure for an empty tree.
+    *******************************************************************************/
+    State FlatTree::operator()(Log* log, Blackboard* board, Rng* rng)
+    {
+        if (nodes.empty())
+            return State::Failure;
+        return run(0, log, 0, board, rng ? *rng : default_rng());
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Executes the node at index i with the semantics of the matching object tree node: Selector stops at the first
+        Success, Sequence stops at the first Failure, RandomSelector runs one child picked from the random stream (so it
+        draws the same numbers as the object tree, weighted or not), Parallel runs every child and succeeds if enough of them
+        succeeded, Inverter swaps Success and Failure, Succeeder always succeeds, Repeater runs its child counter times
+        and Repeat_until_fail runs its child until it fails or its budget is spent, ending Undefined in the latter case.
+        Condition and Assign test and write a blackboard slot directly and fail without a blackboard.
+
+    \param i
+        Index of the node.
+
+    \param log
+        Pointer to the Log stream for output.
+
+    \param depth
+        Depth of the node in the tree, used for indentation of the log output.
+
+    \param board
+        Blackboard read and written by Condition and Assign nodes (nullptr uses the one each node was built with).
+
+    \param rng
+        Random stream drawn from by RandomSelector nodes.
+
+    \return
+        Resulting state of the node.
+    *******************************************************************************/
+    State FlatTree::run(std::uint32_t i, Log* log, int depth, Blackboard* board, Rng& rng)
+    {
+        const FlatNode& n = nodes[i];
+        if (n.op == Op::Leaf)
+            return tick_child(*leaves[n.param], log, depth, rng).getState();
+
+        if (log) log_indent(log, depth) << labels[i] << "\n";
+
+        State s = State::Success;
+        std::uint32_t end = n.first + n.count;
+        switch (n.op)
+        {
+        case Op::Selector:
+            s = State::Failure;
+            for (std::uint32_t c = n.first; c < end; ++c)
+                if (run(c, log, depth + 1, board, rng) == State::Success)
+                {
+                    s = State::Success;
+                    break;
+                }
+            break;
+
+        case Op::Sequence:
+            for (std::uint32_t c = n.first; c < end; ++c)
+                if (run(c, log, depth + 1, board, rng) == State::Failure)
+                {
+                    s = State::Failure;
+                    break;
+                }
+            break;
+
+        case Op::RandomSelector:
+            if (n.count == 0)
+                s = State::Failure;
+            else
+                s = run(n.first + pick(n, rng), log, depth + 1, board, rng);
+            break;
+
+        case Op::Parallel:
+        {
+            std::uint32_t successes = 0;
+            for (std::uint32_t c = n.first; c < end; ++c)
+                if (run(c, log, depth + 1, board, rng) == State::Success)
+                    ++successes;
+            s = successes >= policies[n.param].success ? State::Success : State::Failure;
+            break;
+        }
+
+        case Op::Inverter:
+            if (n.count == 0)
+                s = State::Failure;
+            else
+            {
+                s = run(n.first, log, depth + 1, board, rng);
+                s = (s == State::Success) ? State::Failure
+                    : (s == State::Failure) ? State::Success
+                    : s;
+            }
+            break;
+
+        case Op::Succeeder:
+            if (n.count)
+                run(n.first, log, depth + 1, board, rng);
+            break;
+
+        case Op::Repeater:
+            if (n.count)
+                for (int k = 0; k < loops[n.param].counter; ++k)
+                    run(n.first, log, depth + 1, board, rng);
+            break;
+
+        case Op::Repeat_until_fail:
+            if (n.count)
+            {
+                const LoopPolicy& loop = loops[n.param];
+                auto start = std::chrono::steady_clock::now();
+                for (std::uint32_t runs = 1; run(n.first, log, depth + 1, board, rng) != State::Failure; ++runs)
+                    if ((loop.iterations && runs >= loop.iterations) || (loop.microseconds
+                        && std::chrono::steady_clock::now() - start >= std::chrono::microseconds(loop.microseconds)))
+                    {
+                        s = State::Undefined;
+                        break;
+                    }
+            }
+            break;
+
+        case Op::CheckState:
+            s = static_cast<State>(n.param);
+            break;
+
+        case Op::Condition:
+        case Op::Assign:
+        {
+            Blackboard* b = board ? board : boards[n.param];
+            s = State::Failure;
+            if (b && n.op == Op::Condition)
+                s = boardOps[n.param].test(*b) ? State::Success : State::Failure;
+            else if (b)
+            {
+                boardOps[n.param].assign(*b);
+                s = State::Success;
+            }
+            break;
+        }
+
+        default:
+            break;
+        }
+
+        log_result(log, depth, s);
+        return s;
+    }
+} // end namespace
@@ -0,0 +1,242 @@
+/*!*****************************************************************************
+\file       flat_tree.h
+\author     Jie Le Jet Ang
+\par        DP email: jielejet.ang@digipen.edu.sg
+\par        Course: CS3183
+\par        Section: A
+\par        Programming Assignment 10
+\date       10-18-2026
+
+\brief
+	Declares FlatTree, which compiles a built behavior tree (Selector, Sequence,
+	RandomSelector, Parallel, Inverter, Succeeder, Repeater, Repeat_until_fail,
+	CheckState, Condition and Assign nodes) into a contiguous array of nodes with child ranges, and
+	ticks it with an opcode switch instead of virtual calls through std::list
+	children. Results and log output are identical to the object tree.
+*******************************************************************************/
+#ifndef FLAT_TREE_H
+#define FLAT_TREE_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "blackboard.h"
+
+namespace AI
+{
+	// Behavior tree compiled into an array
+	//     The children of every node are stored next to each other, so a node
+	//     refers to them by the index of its first child and a count. Tasks
+	//     that are not one of the known nodes are kept as leaves and called
+	//     through their operator().
+	class FlatTree
+	{
+	public:
+		// Opcodes of the compiled nodes
+		enum class Op : std::uint8_t { Selector, Sequence, RandomSelector, Parallel, Inverter, Succeeder,
+			Repeater, Repeat_until_fail, CheckState, Condition, Assign, Leaf };
+
+		// A compiled node
+		struct FlatNode
+		{
+			Op op;					// What the node does
+			std::uint16_t count;	// Number of children
+			std::uint32_t first;	// Index of the first child
+			std::int32_t param;		// Repeater/Repeat_until_fail: index in loops, CheckState: result,
+									// Condition/Assign: index in boardOps,
+									// RandomSelector: index in aliases (-1 if unweighted),
+									// Parallel: index in policies, Leaf: index in leaves
+		};
+
+		// Repetitions and per-tick budget of a Repeater or Repeat_until_fail node
+		struct LoopPolicy
+		{
+			std::int32_t counter;		// Repetitions of a Repeater, 0 for Repeat_until_fail
+			std::uint32_t iterations;	// Runs of the child per tick, 0 for no limit
+			std::uint32_t microseconds;	// Time per tick, 0 for no limit
+		};
+
+		// Thresholds and job children of a Parallel node
+		struct ParallelPolicy
+		{
+			std::uint16_t success;	// Children that must succeed
+			std::uint16_t failure;	// Children that must fail
+			std::uint32_t jobs;		// Bit k set if child k runs as a job
+		};
+
+	private:
+		std::vector<FlatNode> nodes;		// Node 0 is the root
+		std::vector<SMART> leaves;			// Tasks executed by Leaf nodes
+		std::vector<BlackboardOp> boardOps;	// Tests and writes of Condition and Assign nodes
+		std::vector<Blackboard*> boards;	// Blackboard every Condition and Assign node was built with
+		std::vector<AliasTable> aliases;	// Child weights of weighted RandomSelector nodes
+		std::vector<ParallelPolicy> policies;	// Thresholds of Parallel nodes
+		std::vector<LoopPolicy> loops;		// Repetitions and budgets of Repeater and Repeat_until_fail nodes
+		std::vector<std::string> labels;	// Log line of every node, only read when logging
+
+		friend class TreeLoader;			// Writes and restores compiled trees in its cache
+
+		/*!*****************************************************************************
+		\brief
+			Executes the node at index i.
+
+		\param i
+			Index of the node.
+
+		\param log
+			Pointer to the Log stream for output (can be nullptr).
+
+		\param depth
+			Depth of the node in the tree, used for log indentation.
+
+		\param board
+			Blackboard read and written by Condition and Assign nodes (nullptr
+			uses the one each node was built with).
+
+		\param rng
+			Random stream drawn from by RandomSelector nodes.
+
+		\return
+			Resulting state of the node.
+		*******************************************************************************/
+		State run(std::uint32_t i, Log* log, int depth, Blackboard* board, Rng& rng);
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Compiles a built tree.
+
+		\param root
+			Root task of the tree (default is empty).
+		*******************************************************************************/
+		explicit FlatTree(SMART root = {});
+
+		/*!*****************************************************************************
+		\brief
+			Ticks the whole tree once.
+
+		\param log
+			Pointer to the Log stream for output (can be nullptr).
+
+		\param board
+			Blackboard read and written by Condition and Assign nodes (default
+			nullptr uses the one each node was built with).
+
+		\param rng
+			Random stream drawn from by RandomSelector nodes (default nullptr
+			uses the calling thread's default stream).
+
+		\return
+			Resulting state of the root, Failure for an empty tree.
+		*******************************************************************************/
+		State operator()(Log* log = nullptr, Blackboard* board = nullptr, Rng* rng = nullptr);
+
+		/*!*****************************************************************************
+		\brief
+			Picks the child a RandomSelector node runs, by its weights if it has
+			any.
+
+		\param n
+			The RandomSelector node; must have children.
+
+		\param rng
+			Random stream to draw from; the object tree's RandomSelector draws the
+			same way.
+
+		\return
+			Position of the picked child among the node's children.
+		*******************************************************************************/
+		std::uint32_t pick(const FlatNode& n, Rng& rng) const
+		{
+			return n.param >= 0 ? aliases[n.param].sample(rng) : rng.below(n.count);
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the compiled nodes; node 0 is the root.
+
+		\return
+			Reference to the node array.
+		*******************************************************************************/
+		const std::vector<FlatNode>& getNodes() const
+		{
+			return nodes;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the tasks executed by Leaf nodes.
+
+		\return
+			Reference to the leaf array.
+		*******************************************************************************/
+		const std::vector<SMART>& getLeaves() const
+		{
+			return leaves;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the compiled test or write of a Condition or Assign node.
+
+		\param op
+			The node's param.
+
+		\return
+			Reference to the operation.
+		*******************************************************************************/
+		const BlackboardOp& getBoardOp(std::int32_t op) const
+		{
+			return boardOps[op];
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the thresholds and job children of a Parallel node.
+
+		\param policy
+			The node's param.
+
+		\return
+			Reference to the policy.
+		*******************************************************************************/
+		const ParallelPolicy& getPolicy(std::int32_t policy) const
+		{
+			return policies[policy];
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the repetitions and budget of a Repeater or Repeat_until_fail
+			node.
+
+		\param loop
+			The node's param.
+
+		\return
+			Reference to the loop policy.
+		*******************************************************************************/
+		const LoopPolicy& getLoop(std::int32_t loop) const
+		{
+			return loops[loop];
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the log line ("Selector()", "Repeater(3)", ...) of a node.
+
+		\param i
+			Index of the node.
+
+		\return
+			Reference to the label.
+		*******************************************************************************/
+		const std::string& getLabel(std::uint32_t i) const
+		{
+			return labels[i];
+		}
+	};
+
+} // end namespace
+
+#endif
@@ -1,351 +1,1031 @@
-/*!*****************************************************************************
-\file       functions.h
-\author     Vadim Surov, Jie Le Jet Ang
-\par        DP email: jielejet.ang@digipen.edu.sg
-\par        Course: CS3183
-\par        Section: A
-\par        Programming Assignment 10
-\date       07-10-2025
-
-\brief
-	Declares composite and decorator classes for behavior trees used in game AI.
-	Includes Selector, Sequence, RandomSelector, Inverter, Succeeder, Repeater,
-	Repeat_until_fail, and CheckState, each inheriting from Task and overriding
-	operator() for custom node logic and logging.
-*******************************************************************************/
-#ifndef FUNCTIONS_H
-#define FUNCTIONS_H
-
-#include <sstream>
-#include <string>
-#include <list>
-#include <cstdlib>
-#include "data.h"
-
-#define UNUSED(x) (void)x;
-
-namespace AI
-{
-	/*!*****************************************************************************
-	\brief
-		Logs the result state with the specified indentation level to the provided log stream.
-
-	\param log
-		Pointer to the Log stream for output (can be nullptr).
-
-	\param level
-		Indentation string for formatting log output.
-
-	\param s
-		State value to log.
-	*******************************************************************************/
-	inline void log_result(Log* log, const std::string& level, State s)
-	{
-		if (log) *log << level << "L " << STATES[s] << "\n";
-	}
-
-	// Check the state of a task comparing it with given by parameter 
-	class CheckState : public Task
-	{
-		Task checktask;
-		State checkstate;
-
-	public:
-		/*!*****************************************************************************
-		\brief
-			Constructs a CheckState node to compare a given task's state to a specified value.
-
-		\param checktask
-			The task whose state will be checked.
-
-		\param checkstate
-			The desired state to compare against (default is State::Success).
-		*******************************************************************************/
-		CheckState(Task checktask = {}, State checkstate = State::Success)
-			: Task{ "CheckState" }, checktask{ checktask }, checkstate{ checkstate }
-		{
-		}
-
-		/*!*****************************************************************************
-		\brief
-			Virtual override for executing the CheckState node; compares target task state to a desired value and logs the result.
-
-		\param log
-			Pointer to the Log stream for output (can be nullptr).
-
-		\param level
-			Indentation string for formatting log output.
-
-		\return
-			Reference to this task after execution.
-		*******************************************************************************/
-		virtual Task& operator()(Log* log = nullptr, std::string level = "") override;
-		
-	};
-
-	// Selector composite
-	//     Returns immediately with a success status code 
-	//     when one of its children runs successfully.
-	class Selector : public Task
-	{
-		std::list<SMART> tasks;
-
-	public:
-		/*!*****************************************************************************
-		\brief
-			Constructs a Selector node with an optional list of child tasks.
-
-		\param tasks
-			Initializer list of child SMART tasks to be added (default is empty).
-		*******************************************************************************/
-		Selector(std::initializer_list<SMART> tasks = {})
-			: Task{ "Selector" }, tasks{ tasks }
-		{
-		}
-
-		/*!*****************************************************************************
-		\brief
-			Virtual override for executing the Selector node; returns Success on first child Success, otherwise Failure.
-
-		\param log
-			Pointer to the Log stream for output (can be nullptr).
-
-		\param level
-			Indentation string for formatting log output.
-
-		\return
-			Reference to this task after execution.
-		*******************************************************************************/
-		virtual Task& operator()(Log* log = nullptr, std::string level = "") override;
-	};
-
-	// Sequence composite
-	//     Returns immediately with a failure status code 
-	//     when one of its children fails.
-	class Sequence : public Task
-	{
-		std::list<SMART> tasks;
-
-	public:
-		/*!*****************************************************************************
-		\brief
-			Constructs a Sequence node with an optional list of child tasks.
-
-		\param tasks
-			Initializer list of child SMART tasks to be added (default is empty).
-		*******************************************************************************/
-		Sequence(std::initializer_list<SMART> tasks = {})
-			: Task{ "Sequence" }, tasks{ tasks }
-		{
-		}
-
-		/*!*****************************************************************************
-		\brief
-			Virtual override for executing the Sequence node; returns Failure on first child Failure, otherwise Success.
-
-		\param log
-			Pointer to the Log stream for output (can be nullptr).
-
-		\param level
-			Indentation string for formatting log output.
-
-		\return
-			Reference to this task after execution.
-		*******************************************************************************/
-		virtual Task& operator()(Log* log = nullptr, std::string level = "") override;
-	};
-
-	// Random selector composite
-	//     Tries a single child at random.
-	class RandomSelector : public Task
-	{
-		std::list<SMART> tasks;
-
-	public:
-		/*!*****************************************************************************
-		\brief
-			Constructs a RandomSelector node with an optional list of child tasks.
-
-		\param tasks
-			Initializer list of child SMART tasks to be added (default is empty).
-		*******************************************************************************/
-		RandomSelector(std::initializer_list<SMART> tasks = {})
-			: Task{ "RandomSelector" }, tasks{ tasks }
-		{
-		}
-
-		/*!*****************************************************************************
-		\brief
-			Virtual override for executing the RandomSelector node; selects and runs one child at random and logs the result.
-
-		\param log
-			Pointer to the Log stream for output (can be nullptr).
-
-		\param level
-			Indentation string for formatting log output.
-
-		\return
-			Reference to this task after execution.
-		*******************************************************************************/
-		virtual Task& operator()(Log* log = nullptr, std::string level = "") override;
-		
-	};
-
-	// Inverter
-	//     Invert the value returned by a task
-	class Inverter : public Task
-	{
-		SMART task;
-
-	public:
-		/*!*****************************************************************************
-		\brief
-			Constructs an Inverter decorator node for the given child task.
-
-		\param task
-			SMART pointer to the child task (default is empty).
-		*******************************************************************************/
-		Inverter(SMART task = {})
-			: Task{ "Inverter" }, task{ task }
-		{
-		}
-
-		/*!*****************************************************************************
-		\brief
-			Virtual override for executing the Inverter decorator; inverts the child's result and logs the execution.
-
-		\param log
-			Pointer to the Log stream for output (can be nullptr).
-
-		\param level
-			Indentation string for formatting log output.
-
-		\return
-			Reference to this task after execution.
-		*******************************************************************************/
-		virtual Task& operator()(Log* log = nullptr, std::string level = "") override;
-		
-	};
-
-	// Succeeder
-	//     Always return success, irrespective of what the child node actually returned.
-	//     These are useful in cases where you want to process a branch of a tree 
-	//     where a failure is expected or anticipated, but you don’t want to 
-	//     abandon processing of a sequence that branch sits on.
-	class Succeeder : public Task
-	{
-		SMART task;
-
-	public:
-		/*!*****************************************************************************
-		\brief
-			Constructs a Succeeder decorator node for the given child task.
-
-		\param task
-			SMART pointer to the child task (default is empty).
-		*******************************************************************************/
-		Succeeder(SMART task = {})
-			: Task{ "Succeeder" }, task{ task }
-		{
-		}
-
-		/*!*****************************************************************************
-		\brief
-			Virtual override for executing the Succeeder decorator; always returns Success, logging execution.
-
-		\param log
-			Pointer to the Log stream for output (can be nullptr).
-
-		\param level
-			Indentation string for formatting log output.
-		\return
-			Reference to this task after execution.
-		*******************************************************************************/
-		virtual Task& operator()(Log* log = nullptr, std::string level = "") override;
-
-	};
-
-	// Repeater
-	//     A repeater will reprocess its child node each time its 
-	//     child returns a result. These are often used at the very 
-	//     base of the tree, to make the tree to run continuously. 
-	//     Repeaters may optionally run their children a set number of 
-	//     times before returning to their parent.
-	class Repeater : public Task
-	{
-		SMART task;
-		int counter;
-
-	public:
-		/*!*****************************************************************************
-		\brief
-			Constructs a Repeater decorator node for the given child task and repetition count.
-
-		\param task
-			SMART pointer to the child task (default is empty).
-
-		\param counter
-			Number of times to repeat the child task (default is 0).
-		*******************************************************************************/
-		Repeater(SMART task = {}, int counter = 0)
-			: Task{ "Repeater" }, task{ task }, counter{ counter }
-		{
-		}
-
-		/*!*****************************************************************************
-		\brief
-			Virtual override for executing the Repeater decorator; runs child multiple times, always returns Success.
-
-		\param log
-			Pointer to the Log stream for output (can be nullptr).
-
-		\param level
-			Indentation string for formatting log output.
-
-		\return
-			Reference to this task after execution.
-		*******************************************************************************/
-		virtual Task& operator()(Log* log = nullptr, std::string level = "") override;
-	};
-
-	// Repeat_until_fail
-	//      Like a repeater, these decorators will continue to 
-	//      reprocess their child. That is until the child finally 
-	//      returns a failure, at which point the repeater will 
-	//      return success to its parent.
-	class Repeat_until_fail : public Task
-	{
-		SMART task;
-
-	public:
-		/*!*****************************************************************************
-		\brief
-			Constructs a Repeat_until_fail decorator node for the given child task.
-
-		\param task
-			SMART pointer to the child task (default is empty).
-		*******************************************************************************/
-		Repeat_until_fail(SMART task = {})
-			: Task{ "Repeat_until_fail" }, task{ task }
-		{
-		}
-
-		/*!*****************************************************************************
-		\brief
-			Virtual override for executing Repeat_until_fail; runs child until Failure, then returns Success.
-
-		\param log
-			Pointer to the Log stream for output (can be nullptr).
-
-		\param level
-			Indentation string for formatting log output.
-
-		\return
-			Reference to this task after execution.
-		*******************************************************************************/
-		virtual Task& operator()(Log* log = nullptr, std::string level = "") override;
-	};
-
-} // end namespace
-
+/*!*****************************************************************************
+\file       functions.h
+\author     Vadim Surov, Jie Le Jet Ang
+\par        DP email: jielejet.ang@digipen.edu.sg
+\par        Course: CS3183
+\par        Section: A
+\par        Programming Assignment 10
+\date       07-10-2025
+
+\brief
+	Declares composite and decorator classes for behavior trees used in game AI.
+	Includes Selector, Sequence, RandomSelector, Parallel, Inverter, Succeeder,
+	Repeater, Repeat_until_fail, and CheckState, each inheriting from Node (a Task that is
+	ticked with its depth) and overriding tick() for custom node logic and logging.
+*******************************************************************************/
+#ifndef FUNCTIONS_H
+#define FUNCTIONS_H
+
+#include <sstream>
+#include <string>
+#include <list>
+#include <vector>
+#include <cstdlib>
+#include "data.h"
+#include "rng.h"
+
+#define UNUSED(x) (void)x;
+
+namespace AI
+{
+	/*!*****************************************************************************
+	\brief
+		Logs the result state with the specified indentation level to the provided log stream.
+
+	\param log
+		Pointer to the Log stream for output (can be nullptr).
+
+	\param level
+		Indentation string for formatting log output.
+
+	\param s
+		State value to log.
+	*******************************************************************************/
+	inline void log_result(Log* log, const std::string& level, State s)
+	{
+		if (log) *log << level << "L " << STATES[s] << "\n";
+	}
+
+	/*!*****************************************************************************
+	\brief
+		Writes the indentation of a node at the given depth ("| " per level) to the
+		provided log stream.
+
+	\param log
+		Pointer to the Log stream for output (must not be nullptr).
+
+	\param depth
+		Depth of the node in the tree.
+
+	\return
+		Reference to the Log stream, for writing the rest of the line.
+	*******************************************************************************/
+	inline Log& log_indent(Log* log, int depth)
+	{
+		for (int i = 0; i < depth; ++i)
+			*log << "| ";
+		return *log;
+	}
+
+	/*!*****************************************************************************
+	\brief
+		Logs the result state of a node at the given depth to the provided log stream.
+
+	\param log
+		Pointer to the Log stream for output (can be nullptr).
+
+	\param depth
+		Depth of the node in the tree.
+
+	\param s
+		State value to log.
+	*******************************************************************************/
+	inline void log_result(Log* log, int depth, State s)
+	{
+		if (log) log_indent(log, depth) << "L " << STATES[s] << "\n";
+	}
+
+	// Kinds of the composite, decorator and blackboard nodes; Custom is any other Node
+	enum class NodeKind { Selector, Sequence, RandomSelector, Parallel, Inverter, Succeeder,
+		Repeater, Repeat_until_fail, CheckState, Condition, Assign, Custom };
+
+	// Base of the composite and decorator nodes
+	//     Nodes are ticked with their depth as an integer; indentation is 
+	//     only written when logging is on, so ticking with logging off 
+	//     does not build any strings. The agent's random stream is passed
+	//     down the tick, so random picks never touch shared state.
+	class Node : public Task
+	{
+	public:
+		/*!*****************************************************************************
+		\brief
+			Constructs a Node with the given id.
+
+		\param id
+			Name of the node.
+		*******************************************************************************/
+		Node(const char* id)
+			: Task{ id }
+		{
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Executes the node.
+
+		\param log
+			Pointer to the Log stream for output (can be nullptr).
+
+		\param depth
+			Depth of the node in the tree, used for log indentation.
+
+		\param rng
+			Random stream of the agent, drawn from by RandomSelector nodes.
+
+		\return
+			Reference to this task after execution.
+		*******************************************************************************/
+		virtual Task& tick(Log* log, int depth, Rng& rng) = 0;
+
+		/*!*****************************************************************************
+		\brief
+			Virtual override for executing the node through the Task interface; the
+			depth is the number of "| " units in the indentation string and random
+			picks draw from the calling thread's default stream.
+
+		\param log
+			Pointer to the Log stream for output (can be nullptr).
+
+		\param level
+			Indentation string for formatting log output.
+
+		\return
+			Reference to this task after execution.
+		*******************************************************************************/
+		virtual Task& operator()(Log* log = nullptr, std::string level = "") override
+		{
+			return tick(log, static_cast<int>(level.size() / 2), default_rng());
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the kind of the node, used by tools that walk a built tree.
+
+		\return
+			The node kind (Custom unless overridden).
+		*******************************************************************************/
+		virtual NodeKind kind() const
+		{
+			return NodeKind::Custom;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Appends the children of the node, in execution order, to a list.
+
+		\param out
+			List that receives the children (empty children are skipped).
+		*******************************************************************************/
+		virtual void getChildren(std::vector<SMART>& out) const
+		{
+			UNUSED(out);
+		}
+	};
+
+	/*!*****************************************************************************
+	\brief
+		Executes a child task at the given depth. Nodes are ticked directly; other
+		tasks get an indentation string only when logging is on.
+
+	\param task
+		The task to execute.
+
+	\param log
+		Pointer to the Log stream for output (can be nullptr).
+
+	\param depth
+		Depth of the task in the tree.
+
+	\param rng
+		Random stream of the agent, passed to nodes.
+
+	\return
+		Reference to the task after execution.
+	*******************************************************************************/
+	Task& tick_child(Task& task, Log* log, int depth, Rng& rng);
+
+	// Check the state of a task comparing it with given by parameter 
+	class CheckState : public Node
+	{
+		Task checktask;
+		State checkstate;
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Constructs a CheckState node to compare a given task's state to a specified value.
+
+		\param checktask
+			The task whose state will be checked.
+
+		\param checkstate
+			The desired state to compare against (default is State::Success).
+		*******************************************************************************/
+		CheckState(Task checktask = {}, State checkstate = State::Success)
+			: Node{ "CheckState" }, checktask{ checktask }, checkstate{ checkstate }
+		{
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Virtual override for executing the CheckState node; compares target task state to a desired value and logs the result.
+
+		\param log
+			Pointer to the Log stream for output (can be nullptr).
+
+		\param depth
+			Depth of the node in the tree, used for log indentation.
+
+		\param rng
+			Random stream of the agent, drawn from by RandomSelector nodes.
+
+		\return
+			Reference to this task after execution.
+		*******************************************************************************/
+		virtual Task& tick(Log* log, int depth, Rng& rng) override;
+
+		/*!*****************************************************************************
+		\brief
+			Returns the kind of the node.
+
+		\return
+			NodeKind::CheckState.
+		*******************************************************************************/
+		virtual NodeKind kind() const override
+		{
+			return NodeKind::CheckState;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the task whose state is checked.
+
+		\return
+			Copy of the checked task.
+		*******************************************************************************/
+		Task getCheckTask() const
+		{
+			return checktask;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the state the checked task is compared against.
+
+		\return
+			The desired state.
+		*******************************************************************************/
+		State getCheckState() const
+		{
+			return checkstate;
+		}
+		
+	};
+
+	// Selector composite
+	//     Returns immediately with a success status code 
+	//     when one of its children runs successfully.
+	class Selector : public Node
+	{
+		std::list<SMART> tasks;
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Constructs a Selector node with an optional list of child tasks.
+
+		\param tasks
+			Initializer list of child SMART tasks to be added (default is empty).
+		*******************************************************************************/
+		Selector(std::initializer_list<SMART> tasks = {})
+			: Node{ "Selector" }, tasks{ tasks }
+		{
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Constructs a Selector node from a list of child tasks built at run time.
+
+		\param tasks
+			Child SMART tasks to be added.
+		*******************************************************************************/
+		Selector(const std::vector<SMART>& tasks)
+			: Node{ "Selector" }, tasks{ tasks.begin(), tasks.end() }
+		{
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Virtual override for executing the Selector node; returns Success on first child Success, otherwise Failure.
+
+		\param log
+			Pointer to the Log stream for output (can be nullptr).
+
+		\param depth
+			Depth of the node in the tree, used for log indentation.
+
+		\param rng
+			Random stream of the agent, drawn from by RandomSelector nodes.
+
+		\return
+			Reference to this task after execution.
+		*******************************************************************************/
+		virtual Task& tick(Log* log, int depth, Rng& rng) override;
+
+		/*!*****************************************************************************
+		\brief
+			Returns the kind of the node.
+
+		\return
+			NodeKind::Selector.
+		*******************************************************************************/
+		virtual NodeKind kind() const override
+		{
+			return NodeKind::Selector;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Appends the child tasks, in execution order, to a list.
+
+		\param out
+			List that receives the children.
+		*******************************************************************************/
+		virtual void getChildren(std::vector<SMART>& out) const override
+		{
+			for (const SMART& t : tasks)
+				if (t) out.push_back(t);
+		}
+	};
+
+	// Sequence composite
+	//     Returns immediately with a failure status code 
+	//     when one of its children fails.
+	class Sequence : public Node
+	{
+		std::list<SMART> tasks;
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Constructs a Sequence node with an optional list of child tasks.
+
+		\param tasks
+			Initializer list of child SMART tasks to be added (default is empty).
+		*******************************************************************************/
+		Sequence(std::initializer_list<SMART> tasks = {})
+			: Node{ "Sequence" }, tasks{ tasks }
+		{
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Constructs a Sequence node from a list of child tasks built at run time.
+
+		\param tasks
+			Child SMART tasks to be added.
+		*******************************************************************************/
+		Sequence(const std::vector<SMART>& tasks)
+			: Node{ "Sequence" }, tasks{ tasks.begin(), tasks.end() }
+		{
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Virtual override for executing the Sequence node; returns Failure on first child Failure, otherwise Success.
+
+		\param log
+			Pointer to the Log stream for output (can be nullptr).
+
+		\param depth
+			Depth of the node in the tree, used for log indentation.
+
+		\param rng
+			Random stream of the agent, drawn from by RandomSelector nodes.
+
+		\return
+			Reference to this task after execution.
+		*******************************************************************************/
+		virtual Task& tick(Log* log, int depth, Rng& rng) override;
+
+		/*!*****************************************************************************
+		\brief
+			Returns the kind of the node.
+
+		\return
+			NodeKind::Sequence.
+		*******************************************************************************/
+		virtual NodeKind kind() const override
+		{
+			return NodeKind::Sequence;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Appends the child tasks, in execution order, to a list.
+
+		\param out
+			List that receives the children.
+		*******************************************************************************/
+		virtual void getChildren(std::vector<SMART>& out) const override
+		{
+			for (const SMART& t : tasks)
+				if (t) out.push_back(t);
+		}
+	};
+
+	// Random selector composite
+	//     Tries a single child at random.
+	class RandomSelector : public Node
+	{
+		std::vector<SMART> tasks;
+		std::vector<float> weights;
+		AliasTable table;
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Constructs a RandomSelector node with an optional list of child tasks.
+
+		\param tasks
+			Initializer list of child SMART tasks to be added (default is empty).
+
+		\param weights
+			Weight of every child (default is empty, all children equally likely).
+		*******************************************************************************/
+		RandomSelector(std::initializer_list<SMART> tasks = {}, std::initializer_list<float> weights = {})
+			: RandomSelector{ std::vector<SMART>(tasks), std::vector<float>(weights) }
+		{
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Constructs a RandomSelector node from a list of child tasks built at run time.
+
+		\param tasks
+			Child SMART tasks to be added; empty ones are dropped.
+
+		\param weights
+			Weight of every child (empty for all children equally likely).
+		*******************************************************************************/
+		RandomSelector(const std::vector<SMART>& tasks, const std::vector<float>& weights)
+			: Node{ "RandomSelector" }, tasks{}, weights{}, table{}
+		{
+			// Empty children are dropped with their weights, so picks match the compiled tree
+			for (std::size_t i = 0; i < tasks.size(); ++i)
+				if (tasks[i])
+				{
+					this->tasks.push_back(tasks[i]);
+					if (!weights.empty())
+						this->weights.push_back(i < weights.size() ? weights[i] : 0.0f);
+				}
+			if (!this->weights.empty())
+				table = AliasTable{ this->weights };
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Virtual override for executing the RandomSelector node; selects and runs one child at random and logs the result.
+
+		\param log
+			Pointer to the Log stream for output (can be nullptr).
+
+		\param depth
+			Depth of the node in the tree, used for log indentation.
+
+		\param rng
+			Random stream of the agent, drawn from by RandomSelector nodes.
+
+		\return
+			Reference to this task after execution.
+		*******************************************************************************/
+		virtual Task& tick(Log* log, int depth, Rng& rng) override;
+
+		/*!*****************************************************************************
+		\brief
+			Returns the kind of the node.
+
+		\return
+			NodeKind::RandomSelector.
+		*******************************************************************************/
+		virtual NodeKind kind() const override
+		{
+			return NodeKind::RandomSelector;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Appends the child tasks, in execution order, to a list.
+
+		\param out
+			List that receives the children.
+		*******************************************************************************/
+		virtual void getChildren(std::vector<SMART>& out) const override
+		{
+			out.insert(out.end(), tasks.begin(), tasks.end());
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Appends the weights of the children, in the order of getChildren, to a
+			list.
+
+		\param out
+			List that receives the weights (nothing if the children are equally
+			likely).
+		*******************************************************************************/
+		void getWeights(std::vector<float>& out) const
+		{
+			out.insert(out.end(), weights.begin(), weights.end());
+		}
+	};
+
+	// Parallel composite
+	//     Runs all of its children; succeeds when enough of them succeed and
+	//     fails when enough of them fail. Children marked as jobs run on the
+	//     job system of the compiled runtime. At most PARALLEL_MAX children
+	//     are kept, since the runtime tracks two bits per child in one slot;
+	//     getDropped() tells how many more were given, so a tree built in
+	//     C++ can be checked before it is used.
+	class Parallel : public Node
+	{
+		std::vector<SMART> tasks;
+		int success;
+		int failure;
+		std::vector<bool> jobs;
+		int dropped;
+
+	public:
+		static const int PARALLEL_MAX = 16;
+
+		/*!*****************************************************************************
+		\brief
+			Constructs a Parallel node.
+
+		\param tasks
+			Initializer list of child SMART tasks to be added (default is empty).
+
+		\param success
+			Number of children that must succeed (default 0 means all of them).
+
+		\param failure
+			Number of children that must fail (default is 1; 0 means all of them).
+
+		\param jobs
+			For every child, true to run it as a job (default is empty, none).
+			Only leaves with a bound action can run as jobs.
+		*******************************************************************************/
+		Parallel(std::initializer_list<SMART> tasks = {}, int success = 0, int failure = 1,
+			std::initializer_list<bool> jobs = {})
+			: Parallel{ std::vector<SMART>(tasks), success, failure, std::vector<bool>(jobs) }
+		{
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Constructs a Parallel node from a list of child tasks built at run time.
+
+		\param tasks
+			Child SMART tasks to be added; empty ones are dropped, and so are the
+			ones past PARALLEL_MAX, which getDropped() counts.
+
+		\param success
+			Number of children that must succeed (0 means all of them).
+
+		\param failure
+			Number of children that must fail (0 means all of them).
+
+		\param jobs
+			For every child, true to run it as a job. Only leaves with a bound
+			action can run as jobs.
+		*******************************************************************************/
+		Parallel(const std::vector<SMART>& tasks, int success, int failure, const std::vector<bool>& jobs)
+			: Node{ "Parallel" }, tasks{}, success{ success }, failure{ failure }, jobs{}, dropped{ 0 }
+		{
+			// Empty children are dropped with their job flags, so every kept child can be ticked
+			for (std::size_t i = 0; i < tasks.size(); ++i)
+				if (tasks[i] && this->tasks.size() == PARALLEL_MAX)
+					++dropped;
+				else if (tasks[i])
+				{
+					this->tasks.push_back(tasks[i]);
+					this->jobs.push_back(i < jobs.size() && jobs[i]);
+				}
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the number of children that were given past PARALLEL_MAX and
+			are not part of the node.
+
+		\return
+			Number of dropped children, 0 for a valid node.
+		*******************************************************************************/
+		int getDropped() const
+		{
+			return dropped;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Virtual override for executing the Parallel node; runs every child and
+			compares the counts of results with the thresholds.
+
+		\param log
+			Pointer to the Log stream for output (can be nullptr).
+
+		\param depth
+			Depth of the node in the tree, used for log indentation.
+
+		\param rng
+			Random stream of the agent, drawn from by RandomSelector nodes.
+
+		\return
+			Reference to this task after execution.
+		*******************************************************************************/
+		virtual Task& tick(Log* log, int depth, Rng& rng) override;
+
+		/*!*****************************************************************************
+		\brief
+			Returns the kind of the node.
+
+		\return
+			NodeKind::Parallel.
+		*******************************************************************************/
+		virtual NodeKind kind() const override
+		{
+			return NodeKind::Parallel;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Appends the child tasks, in execution order, to a list.
+
+		\param out
+			List that receives the children.
+		*******************************************************************************/
+		virtual void getChildren(std::vector<SMART>& out) const override
+		{
+			out.insert(out.end(), tasks.begin(), tasks.end());
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the number of children that must succeed.
+
+		\return
+			Success threshold, between 0 and the number of children.
+		*******************************************************************************/
+		int getSuccessThreshold() const
+		{
+			int count = static_cast<int>(tasks.size());
+			return success <= 0 || success > count ? count : success;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the number of children that must fail.
+
+		\return
+			Failure threshold, between 0 and the number of children.
+		*******************************************************************************/
+		int getFailureThreshold() const
+		{
+			int count = static_cast<int>(tasks.size());
+			return failure <= 0 || failure > count ? count : failure;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns a bit mask of the children that run as jobs, in the order of
+			getChildren.
+
+		\return
+			Bit k is set if child k runs as a job.
+		*******************************************************************************/
+		std::uint32_t getJobMask() const
+		{
+			std::uint32_t mask = 0;
+			for (std::size_t k = 0; k < jobs.size(); ++k)
+				if (jobs[k])
+					mask |= 1u << k;
+			return mask;
+		}
+	};
+
+	// Inverter
+	//     Invert the value returned by a task
+	class Inverter : public Node
+	{
+		SMART task;
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Constructs an Inverter decorator node for the given child task.
+
+		\param task
+			SMART pointer to the child task (default is empty).
+		*******************************************************************************/
+		Inverter(SMART task = {})
+			: Node{ "Inverter" }, task{ task }
+		{
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Virtual override for executing the Inverter decorator; inverts the child's result and logs the execution.
+
+		\param log
+			Pointer to the Log stream for output (can be nullptr).
+
+		\param depth
+			Depth of the node in the tree, used for log indentation.
+
+		\param rng
+			Random stream of the agent, drawn from by RandomSelector nodes.
+
+		\return
+			Reference to this task after execution.
+		*******************************************************************************/
+		virtual Task& tick(Log* log, int depth, Rng& rng) override;
+
+		/*!*****************************************************************************
+		\brief
+			Returns the kind of the node.
+
+		\return
+			NodeKind::Inverter.
+		*******************************************************************************/
+		virtual NodeKind kind() const override
+		{
+			return NodeKind::Inverter;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Appends the child task, if any, to a list.
+
+		\param out
+			List that receives the child.
+		*******************************************************************************/
+		virtual void getChildren(std::vector<SMART>& out) const override
+		{
+			if (task) out.push_back(task);
+		}
+		
+	};
+
+	// Succeeder
+	//     Always return success, irrespective of what the child node actually returned.
+	//     These are useful in cases where you want to process a branch of a tree 
+	//     where a failure is expected or anticipated, but you don’t want to 
+	//     abandon processing of a sequence that branch sits on.
+	class Succeeder : public Node
+	{
+		SMART task;
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Constructs a Succeeder decorator node for the given child task.
+
+		\param task
+			SMART pointer to the child task (default is empty).
+		*******************************************************************************/
+		Succeeder(SMART task = {})
+			: Node{ "Succeeder" }, task{ task }
+		{
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Virtual override for executing the Succeeder decorator; always returns Success, logging execution.
+
+		\param log
+			Pointer to the Log stream for output (can be nullptr).
+
+		\param depth
+			Depth of the node in the tree, used for log indentation.
+
+		\param rng
+			Random stream of the agent, drawn from by RandomSelector nodes.
+
+		\return
+			Reference to this task after execution.
+		*******************************************************************************/
+		virtual Task& tick(Log* log, int depth, Rng& rng) override;
+
+		/*!*****************************************************************************
+		\brief
+			Returns the kind of the node.
+
+		\return
+			NodeKind::Succeeder.
+		*******************************************************************************/
+		virtual NodeKind kind() const override
+		{
+			return NodeKind::Succeeder;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Appends the child task, if any, to a list.
+
+		\param out
+			List that receives the child.
+		*******************************************************************************/
+		virtual void getChildren(std::vector<SMART>& out) const override
+		{
+			if (task) out.push_back(task);
+		}
+
+	};
+
+	// Most work a loop decorator does in one tick, 0 meaning no limit
+	//     In a tree with Running (BehaviorTree, BatchTree) a decorator whose
+	//     budget is spent returns Running and carries on from there on the next
+	//     tick; a Repeat_until_fail without a budget runs its child once per
+	//     tick. The object tree has no Running: its Repeat_until_fail stops at
+	//     the budget with an Undefined state and starts over on the next tick,
+	//     while its Repeater always runs every repetition.
+	struct LoopBudget
+	{
+		int iterations = 0;		// Runs of the child per tick
+		int microseconds = 0;	// Time per tick, checked after every run of the child
+	};
+
+	// Repeater
+	//     A repeater will reprocess its child node each time its 
+	//     child returns a result. These are often used at the very 
+	//     base of the tree, to make the tree to run continuously. 
+	//     Repeaters may optionally run their children a set number of 
+	//     times before returning to their parent.
+	class Repeater : public Node
+	{
+		SMART task;
+		int counter;
+		LoopBudget budget;
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Constructs a Repeater decorator node for the given child task and repetition count.
+
+		\param task
+			SMART pointer to the child task (default is empty).
+
+		\param counter
+			Number of times to repeat the child task (default is 0).
+
+		\param budget
+			Most repetitions or time per tick of a tree with Running (default is
+			no limit: all repetitions in one tick).
+		*******************************************************************************/
+		Repeater(SMART task = {}, int counter = 0, LoopBudget budget = {})
+			: Node{ "Repeater" }, task{ task }, counter{ counter }, budget{ budget }
+		{
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Virtual override for executing the Repeater decorator; runs child multiple times, always returns Success.
+
+		\param log
+			Pointer to the Log stream for output (can be nullptr).
+
+		\param depth
+			Depth of the node in the tree, used for log indentation.
+
+		\param rng
+			Random stream of the agent, drawn from by RandomSelector nodes.
+
+		\return
+			Reference to this task after execution.
+		*******************************************************************************/
+		virtual Task& tick(Log* log, int depth, Rng& rng) override;
+
+		/*!*****************************************************************************
+		\brief
+			Returns the kind of the node.
+
+		\return
+			NodeKind::Repeater.
+		*******************************************************************************/
+		virtual NodeKind kind() const override
+		{
+			return NodeKind::Repeater;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Appends the child task, if any, to a list.
+
+		\param out
+			List that receives the child.
+		*******************************************************************************/
+		virtual void getChildren(std::vector<SMART>& out) const override
+		{
+			if (task) out.push_back(task);
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the number of times the child task is repeated.
+
+		\return
+			The repetition count.
+		*******************************************************************************/
+		int getCounter() const
+		{
+			return counter;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the work the node may do in one tick of a tree with Running.
+
+		\return
+			The budget.
+		*******************************************************************************/
+		LoopBudget getBudget() const
+		{
+			return budget;
+		}
+	};
+
+	// Repeat_until_fail
+	//      Like a repeater, these decorators will continue to 
+	//      reprocess their child. That is until the child finally 
+	//      returns a failure, at which point the repeater will 
+	//      return success to its parent.
+	class Repeat_until_fail : public Node
+	{
+		SMART task;
+		LoopBudget budget;
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Constructs a Repeat_until_fail decorator node for the given child task.
+
+		\param task
+			SMART pointer to the child task (default is empty).
+
+		\param budget
+			Most runs or time per tick (default is no budget: one run per tick of
+			a tree with Running, every run until Failure in the object tree).
+		*******************************************************************************/
+		Repeat_until_fail(SMART task = {}, LoopBudget budget = {})
+			: Node{ "Repeat_until_fail" }, task{ task }, budget{ budget }
+		{
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Virtual override for executing Repeat_until_fail; runs child until Failure, then returns Success.
+
+		\param log
+			Pointer to the Log stream for output (can be nullptr).
+
+		\param depth
+			Depth of the node in the tree, used for log indentation.
+
+		\param rng
+			Random stream of the agent, drawn from by RandomSelector nodes.
+
+		\return
+			Reference to this task after execution.
+		*******************************************************************************/
+		virtual Task& tick(Log* log, int depth, Rng& rng) override;
+
+		/*!*****************************************************************************
+		\brief
+			Returns the kind of the node.
+
+		\return
+			NodeKind::Repeat_until_fail.
+		*******************************************************************************/
+		virtual NodeKind kind() const override
+		{
+			return NodeKind::Repeat_until_fail;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Appends the child task, if any, to a list.
+
+		\param out
+			List that receives the child.
+		*******************************************************************************/
+		virtual void getChildren(std::vector<SMART>& out) const override
+		{
+			if (task) out.push_back(task);
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the work the node may do in one tick of a tree with Running.
+
+		\return
+			The budget.
+		*******************************************************************************/
+		LoopBudget getBudget() const
+		{
+			return budget;
+		}
+	};
+
+} // end namespace
+
 #endif
\ No newline at end of file
@@ -0,0 +1,140 @@
+/*!*****************************************************************************
+\file       job_system.cpp
+\author     Jie Le Jet Ang
+\par        DP email: jielejet.ang@digipen.edu.sg
+\par        Course: CS3183
+\par        Section: A
+\par        Programming Assignment 10
+\date       10-18-2026
+
+\brief
+    Implements JobSystem: the worker loop, background job submission and the
+    blocking parallelFor used to split agents across threads.
+*******************************************************************************/
+#include "job_system.h"
+
+#include <atomic>
+#include <algorithm>
+#include <memory>
+
+namespace AI
+{
+    /*!*****************************************************************************
+    \brief
+        Starts the worker threads.
+
+    \param threads
+        Number of worker threads.
+    *******************************************************************************/
+    JobSystem::JobSystem(unsigned threads)
+        : workers{}, jobs{}, mutex{}, wake{}, stopping{ false }
+    {
+        // hardware_concurrency() may report 0, which makes the default wrap around
+        if (threads > 256)
+            threads = 0;
+        for (unsigned i = 0; i < threads; ++i)
+            workers.emplace_back([this] { work(); });
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Finishes the queued jobs and joins the worker threads.
+    *******************************************************************************/
+    JobSystem::~JobSystem()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& t : workers)
+            t.join();
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Main loop of a worker thread: waits for a job, runs it, and repeats until the pool stops and the queue is empty.
+    *******************************************************************************/
+    void JobSystem::work()
+    {
+        while (true)
+        {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this] { return stopping || !jobs.empty(); });
+                if (jobs.empty())
+                    return;
+                job = std::move(jobs.front());
+                jobs.pop_front();
+            }
+            job();
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Queues a job to run on a worker thread. Without worker threads the job runs immediately on the calling thread.
+
+    \param job
+        The job to run.
+    *******************************************************************************/
+    void JobSystem::submit(std::function<void()> job)
+    {
+        if (workers.empty())
+        {
+            job();
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.push_back(std::move(job));
+        }
+        wake.notify_one();
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Runs fn(i) for every i in [0, count). Every worker gets a helper job that takes the next free item until none are
+        left; the calling thread does the same, then waits for the helpers that are still busy.
+
+    \param count
+        Number of work items.
+
+    \param fn
+        Function called once per work item.
+    *******************************************************************************/
+    void JobSystem::parallelFor(std::size_t count, const std::function<void(std::size_t)>& fn)
+    {
+        struct Shared
+        {
+            std::atomic<std::size_t> next{ 0 };
+            std::atomic<std::size_t> done{ 0 };
+            std::mutex mutex;
+            std::condition_variable finished;
+        };
+        std::shared_ptr<Shared> shared = std::make_shared<Shared>();
+
+        auto drain = [shared, count, &fn]
+        {
+            std::size_t i;
+            while ((i = shared->next.fetch_add(1)) < count)
+            {
+                fn(i);
+                if (shared->done.fetch_add(1) + 1 == count)
+                {
+                    std::lock_guard<std::mutex> lock(shared->mutex);
+                    shared->finished.notify_all();
+                }
+            }
+        };
+
+        std::size_t helpers = count > 1 ? std::min(workers.size(), count - 1) : 0;
+        for (std::size_t h = 0; h < helpers; ++h)
+            submit(drain);
+        drain();
+
+        std::unique_lock<std::mutex> lock(shared->mutex);
+        shared->finished.wait(lock, [&] { return shared->done.load() == count; });
+    }
+} // end namespace
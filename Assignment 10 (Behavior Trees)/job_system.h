@@ -0,0 +1,99 @@
+/*!*****************************************************************************
+\file       job_system.h
+\author     Jie Le Jet Ang
+\par        DP email: jielejet.ang@digipen.edu.sg
+\par        Course: CS3183
+\par        Section: A
+\par        Programming Assignment 10
+\date       10-18-2026
+
+\brief
+	Declares JobSystem, a fixed pool of worker threads shared by the behavior
+	tree runtimes. Jobs can be submitted to run in the background, and a range
+	of work items can be split across the workers with parallelFor.
+*******************************************************************************/
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+namespace AI
+{
+	// Pool of worker threads with a shared job queue
+	class JobSystem
+	{
+		std::vector<std::thread> workers;
+		std::deque<std::function<void()>> jobs;
+		std::mutex mutex;
+		std::condition_variable wake;
+		bool stopping;
+
+		/*!*****************************************************************************
+		\brief
+			Main loop of a worker thread: runs queued jobs until the pool stops.
+		*******************************************************************************/
+		void work();
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Starts the worker threads.
+
+		\param threads
+			Number of worker threads (default is one less than the number of
+			hardware threads, since the calling thread also works in parallelFor).
+		*******************************************************************************/
+		explicit JobSystem(unsigned threads = std::thread::hardware_concurrency() - 1);
+
+		/*!*****************************************************************************
+		\brief
+			Finishes the queued jobs and joins the worker threads.
+		*******************************************************************************/
+		~JobSystem();
+
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+
+		/*!*****************************************************************************
+		\brief
+			Queues a job to run on a worker thread; returns immediately.
+
+		\param job
+			The job to run.
+		*******************************************************************************/
+		void submit(std::function<void()> job);
+
+		/*!*****************************************************************************
+		\brief
+			Runs fn(i) for every i in [0, count) on the workers and the calling
+			thread, and returns when all of them are done.
+
+		\param count
+			Number of work items.
+
+		\param fn
+			Function called once per work item.
+		*******************************************************************************/
+		void parallelFor(std::size_t count, const std::function<void(std::size_t)>& fn);
+
+		/*!*****************************************************************************
+		\brief
+			Returns the number of worker threads.
+
+		\return
+			Worker thread count.
+		*******************************************************************************/
+		std::size_t getThreadCount() const
+		{
+			return workers.size();
+		}
+	};
+
+} // end namespace
+
+#endif
@@ -0,0 +1,246 @@
+/*!*****************************************************************************
+\file       profiler.cpp
+\author     Jie Le Jet Ang
+\par        DP email: jielejet.ang@digipen.edu.sg
+\par        Course: CS3183
+\par        Section: A
+\par        Programming Assignment 10
+\date       10-18-2026
+
+\brief
+    Implements Profiler: merging of the totals of several threads and the
+    report, flame graph and Chrome trace outputs.
+*******************************************************************************/
+#include "profiler.h"
+
+#include <iomanip>
+
+namespace AI
+{
+    namespace
+    {
+        /*!*****************************************************************************
+        \brief
+            Writes a string as a JSON string literal.
+
+        \param os
+            The output stream.
+
+        \param text
+            The string.
+        *******************************************************************************/
+        void writeJsonString(std::ostream& os, const std::string& text)
+        {
+            os << '"';
+            for (char c : text)
+            {
+                if (c == '"' || c == '\\')
+                    os << '\\' << c;
+                else if (static_cast<unsigned char>(c) < 0x20)
+                    os << ' ';
+                else
+                    os << c;
+            }
+            os << '"';
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Creates a profiler with empty totals for every node of a tree. The child ranges and labels are copied, so the
+        profiler can outlive the tree.
+
+    \param tree
+        The profiled tree.
+    *******************************************************************************/
+    Profiler::Profiler(const BehaviorTree& tree)
+        : shape{ tree.getTree().getNodes() }, labels{}, nodes(shape.size()), childTime{ 0 }
+    {
+        for (std::uint32_t i = 0; i < shape.size(); ++i)
+            labels.push_back(tree.getTree().getLabel(i));
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Adds the totals of another profiler of the same tree.
+
+    \param other
+        The other profiler; ignored if it profiles a tree of another size.
+    *******************************************************************************/
+    void Profiler::merge(const Profiler& other)
+    {
+        if (other.nodes.size() != nodes.size())
+            return;
+        for (std::size_t i = 0; i < nodes.size(); ++i)
+        {
+            nodes[i].ticks += other.nodes[i].ticks;
+            nodes[i].total += other.nodes[i].total;
+            nodes[i].self += other.nodes[i].self;
+            for (int s = 0; s < 3; ++s)
+                nodes[i].statuses[s] += other.nodes[i].statuses[s];
+            nodes[i].overruns += other.nodes[i].overruns;
+            nodes[i].overrunTime += other.nodes[i].overrunTime;
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Sets every total back to 0.
+    *******************************************************************************/
+    void Profiler::clear()
+    {
+        nodes.assign(nodes.size(), NodeProfile{});
+        childTime = 0;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Prints the totals as a table indented like the tree. Nodes are visited depth first with an explicit stack so
+        children appear under their parent in order.
+
+    \param os
+        The output stream.
+    *******************************************************************************/
+    void Profiler::writeReport(std::ostream& os) const
+    {
+        if (nodes.empty())
+            return;
+
+        double root = nodes[0].total ? static_cast<double>(nodes[0].total) : 1.0;
+        std::ios::fmtflags flags = os.flags();
+        std::streamsize precision = os.precision();
+        os << std::fixed << std::setprecision(3);
+        os << std::setw(10) << "ticks" << std::setw(12) << "total ms" << std::setw(12) << "self ms"
+            << std::setw(8) << "%" << std::setw(10) << STATUSES[0] << std::setw(10) << STATUSES[1]
+            << std::setw(10) << STATUSES[2] << std::setw(10) << "overruns" << "  node\n";
+
+        std::vector<std::pair<std::uint32_t, int>> stack{ { 0, 0 } };
+        while (!stack.empty())
+        {
+            std::uint32_t i = stack.back().first;
+            int depth = stack.back().second;
+            stack.pop_back();
+
+            const NodeProfile& n = nodes[i];
+            os << std::setw(10) << n.ticks << std::setw(12) << n.total / 1e6 << std::setw(12) << n.self / 1e6
+                << std::setw(8) << std::setprecision(1) << 100.0 * n.total / root << std::setprecision(3)
+                << std::setw(10) << n.statuses[0] << std::setw(10) << n.statuses[1] << std::setw(10) << n.statuses[2]
+                << std::setw(10) << n.overruns << "  " << std::string(2 * depth, ' ') << labels[i] << "\n";
+
+            for (std::uint32_t c = shape[i].first + shape[i].count; c-- > shape[i].first;)
+                stack.push_back({ c, depth + 1 });
+        }
+
+        os.flags(flags);
+        os.precision(precision);
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Writes the self time of every node as folded stacks.
+
+    \param os
+        The output stream.
+    *******************************************************************************/
+    void Profiler::writeFlameGraph(std::ostream& os) const
+    {
+        if (!nodes.empty())
+            writeStacks(os, 0, {});
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Writes the folded stacks of a subtree. Semicolons separate the frames of a stack, so they are replaced in the
+        names; nodes that never ran are left out with their subtree.
+
+    \param os
+        The output stream.
+
+    \param i
+        Index of the subtree's root.
+
+    \param stack
+        Folded stack of the root's parent.
+    *******************************************************************************/
+    void Profiler::writeStacks(std::ostream& os, std::uint32_t i, const std::string& stack) const
+    {
+        if (nodes[i].ticks == 0)
+            return;
+
+        std::string name = labels[i] + " #" + std::to_string(i);
+        for (char& c : name)
+            if (c == ';')
+                c = ',';
+        std::string path = stack.empty() ? name : stack + ";" + name;
+        if (nodes[i].self)
+            os << path << " " << nodes[i].self << "\n";
+        for (std::uint32_t c = shape[i].first; c < shape[i].first + shape[i].count; ++c)
+            writeStacks(os, c, path);
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Writes the totals as a Chrome trace in JSON.
+
+    \param os
+        The output stream.
+    *******************************************************************************/
+    void Profiler::writeChromeTrace(std::ostream& os) const
+    {
+        bool first = true;
+        std::ios::fmtflags flags = os.flags();
+        std::streamsize precision = os.precision();
+        os << std::fixed << std::setprecision(3);
+        os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        if (!nodes.empty())
+            writeEvents(os, 0, 0, 0, first);
+        os << "\n]}\n";
+        os.flags(flags);
+        os.precision(precision);
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Writes the trace events of a subtree. Trace times are in microseconds; the children of a node start where the
+        node starts and follow each other, which keeps every child inside its parent since the children's totals add up
+        to at most the parent's.
+
+    \param os
+        The output stream.
+
+    \param i
+        Index of the subtree's root.
+
+    \param start
+        Start of the root on the trace, in nanoseconds.
+
+    \param depth
+        Depth of the root.
+
+    \param first
+        True until the first event has been written.
+    *******************************************************************************/
+    void Profiler::writeEvents(std::ostream& os, std::uint32_t i, std::uint64_t start, int depth, bool& first) const
+    {
+        const NodeProfile& n = nodes[i];
+        if (n.ticks == 0)
+            return;
+
+        os << (first ? "\n" : ",\n") << "{\"name\":";
+        first = false;
+        writeJsonString(os, labels[i]);
+        os << ",\"cat\":\"node\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+            << ",\"ts\":" << start / 1000.0 << ",\"dur\":" << n.total / 1000.0
+            << ",\"args\":{\"node\":" << i << ",\"depth\":" << depth << ",\"ticks\":" << n.ticks
+            << ",\"self_us\":" << n.self / 1000.0
+            << ",\"success\":" << n.statuses[0] << ",\"failure\":" << n.statuses[1]
+            << ",\"running\":" << n.statuses[2] << ",\"overruns\":" << n.overruns
+            << ",\"overrun_us\":" << n.overrunTime / 1000.0 << "}}";
+
+        for (std::uint32_t c = shape[i].first; c < shape[i].first + shape[i].count; ++c)
+        {
+            writeEvents(os, c, start, depth + 1, first);
+            start += nodes[c].total;
+        }
+    }
+} // end namespace
@@ -0,0 +1,245 @@
+/*!*****************************************************************************
+\file       profiler.h
+\author     Jie Le Jet Ang
+\par        DP email: jielejet.ang@digipen.edu.sg
+\par        Course: CS3183
+\par        Section: A
+\par        Programming Assignment 10
+\date       10-18-2026
+
+\brief
+	Declares Profiler, which records how often every node of a BehaviorTree
+	ran, how long it took with and without its children, and what it returned,
+	summed over every agent ticked with it. The totals can be printed as an
+	indented table or written as folded stacks for flame graph tools and as a
+	Chrome trace (chrome://tracing, Perfetto). Ticks without a profiler run the
+	interpreter compiled without any timing code, so they cost nothing extra.
+*******************************************************************************/
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <chrono>
+#include <iostream>
+#include "behavior_tree.h"
+
+namespace AI
+{
+	// Totals of one node over every tick and agent
+	struct NodeProfile
+	{
+		std::uint64_t ticks = 0;			// Number of times the node ran
+		std::uint64_t total = 0;			// Nanoseconds spent in the node and its children
+		std::uint64_t self = 0;				// Nanoseconds spent in the node itself
+		std::uint64_t statuses[3] = {};		// Number of results of every Status
+		std::uint64_t overruns = 0;			// Ticks a loop decorator spent its configured budget with work left
+		std::uint64_t overrunTime = 0;		// Nanoseconds loop decorators ran past their time budget
+	};
+
+	// Per-node timing of one BehaviorTree
+	//     A profiler is not thread safe: give every thread its own and merge
+	//     them when the frame is done.
+	class Profiler
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		// Start of a node being timed
+		struct Mark
+		{
+			Clock::time_point start;
+			std::uint64_t childTime;	// Time of the finished children of the enclosing node
+		};
+
+	private:
+		std::vector<FlatTree::FlatNode> shape;	// Child ranges of the profiled tree
+		std::vector<std::string> labels;		// Name of every node
+		std::vector<NodeProfile> nodes;
+		std::uint64_t childTime;				// Time of the finished children of the node being timed
+
+		/*!*****************************************************************************
+		\brief
+			Writes the folded stacks of a subtree.
+
+		\param os
+			The output stream.
+
+		\param i
+			Index of the subtree's root.
+
+		\param stack
+			Folded stack of the root's parent.
+		*******************************************************************************/
+		void writeStacks(std::ostream& os, std::uint32_t i, const std::string& stack) const;
+
+		/*!*****************************************************************************
+		\brief
+			Writes the trace events of a subtree.
+
+		\param os
+			The output stream.
+
+		\param i
+			Index of the subtree's root.
+
+		\param start
+			Start of the root on the trace, in nanoseconds.
+
+		\param depth
+			Depth of the root.
+
+		\param first
+			True until the first event has been written.
+		*******************************************************************************/
+		void writeEvents(std::ostream& os, std::uint32_t i, std::uint64_t start, int depth, bool& first) const;
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Creates a profiler with empty totals for every node of a tree.
+
+		\param tree
+			The profiled tree.
+		*******************************************************************************/
+		explicit Profiler(const BehaviorTree& tree);
+
+		/*!*****************************************************************************
+		\brief
+			Starts timing a node.
+
+		\return
+			Mark to pass to leave once the node returns.
+		*******************************************************************************/
+		Mark enter()
+		{
+			Mark mark{ Clock::now(), childTime };
+			childTime = 0;
+			return mark;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Stops timing a node and adds it to the totals.
+
+		\param i
+			Index of the node.
+
+		\param status
+			What the node returned.
+
+		\param mark
+			Mark returned by enter for this node.
+		*******************************************************************************/
+		void leave(std::uint32_t i, Status status, const Mark& mark)
+		{
+			std::uint64_t elapsed = static_cast<std::uint64_t>(
+				std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - mark.start).count());
+			NodeProfile& node = nodes[i];
+			++node.ticks;
+			node.total += elapsed;
+			node.self += elapsed > childTime ? elapsed - childTime : 0;
+			++node.statuses[static_cast<int>(status)];
+			childTime = mark.childTime + elapsed;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Records that a loop decorator stopped at its budget and carried the rest
+			of its work over to the next tick.
+
+		\param i
+			Index of the node.
+
+		\param excess
+			Nanoseconds it ran past its time budget (0 for an iteration budget).
+		*******************************************************************************/
+		void overrun(std::uint32_t i, std::uint64_t excess)
+		{
+			++nodes[i].overruns;
+			nodes[i].overrunTime += excess;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Adds the totals of another profiler of the same tree, such as the one of
+			another thread.
+
+		\param other
+			The other profiler.
+		*******************************************************************************/
+		void merge(const Profiler& other);
+
+		/*!*****************************************************************************
+		\brief
+			Sets every total back to 0.
+		*******************************************************************************/
+		void clear();
+
+		/*!*****************************************************************************
+		\brief
+			Returns the totals of a node.
+
+		\param i
+			Index of the node.
+
+		\return
+			Reference to the totals.
+		*******************************************************************************/
+		const NodeProfile& getNode(std::uint32_t i) const
+		{
+			return nodes[i];
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the number of nodes.
+
+		\return
+			Node count.
+		*******************************************************************************/
+		std::size_t getNodeCount() const
+		{
+			return nodes.size();
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Prints the totals as a table indented like the tree, one node per line:
+			ticks, total and self milliseconds, share of the root's time, the
+			count of every status and the budget overruns of loop decorators.
+
+		\param os
+			The output stream.
+		*******************************************************************************/
+		void writeReport(std::ostream& os) const;
+
+		/*!*****************************************************************************
+		\brief
+			Writes the self time of every node as folded stacks, one line of
+			"root;child;node nanoseconds" per node, the input of flamegraph.pl,
+			speedscope and similar tools. Nodes are named by their label and
+			index, so equal siblings stay apart.
+
+		\param os
+			The output stream.
+		*******************************************************************************/
+		void writeFlameGraph(std::ostream& os) const;
+
+		/*!*****************************************************************************
+		\brief
+			Writes the totals as a Chrome trace in JSON. Every node that ran is one
+			complete event as long as its total time, placed inside its parent after
+			its earlier siblings, so the trace viewer draws the tree as a flame
+			chart; ticks, self time, statuses and overruns are in the event's args.
+
+		\param os
+			The output stream.
+		*******************************************************************************/
+		void writeChromeTrace(std::ostream& os) const;
+	};
+
+} // end namespace
+
+#endif
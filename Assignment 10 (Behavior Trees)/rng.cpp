@@ -0,0 +1,80 @@
+/*!*****************************************************************************
+\file       rng.cpp
+\author     Jie Le Jet Ang
+\par        DP email: jielejet.ang@digipen.edu.sg
+\par        Course: CS3183
+\par        Section: A
+\par        Programming Assignment 10
+\date       10-18-2026
+
+\brief
+    Implements the default random stream of every thread and the construction
+    of AliasTable with Vose's method.
+*******************************************************************************/
+#include "rng.h"
+
+namespace AI
+{
+    /*!*****************************************************************************
+    \brief
+        Returns the random stream of the calling thread, seeded with 0 the first time the thread asks for it.
+
+    \return
+        Reference to the thread's stream.
+    *******************************************************************************/
+    Rng& default_rng()
+    {
+        thread_local Rng stream;
+        return stream;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Builds the table with Vose's method. The weights are scaled so that they average 1; columns below 1 are topped
+        up from columns above 1, which become the alias of the smaller column and lose the amount given. Every column
+        ends up with one own index and at most one alias.
+
+    \param weights
+        Weight of every index.
+    *******************************************************************************/
+    AliasTable::AliasTable(const std::vector<float>& weights)
+        : prob(weights.size(), 1.0f), alias(weights.size(), 0)
+    {
+        std::size_t n = weights.size();
+        double total = 0.0;
+        for (float w : weights)
+            total += w > 0.0f ? w : 0.0f;
+        for (std::size_t i = 0; i < n; ++i)
+            alias[i] = static_cast<std::uint32_t>(i);
+        if (n == 0 || total <= 0.0)
+            return;
+
+        std::vector<double> scaled(n);
+        std::vector<std::uint32_t> small, large;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            scaled[i] = (weights[i] > 0.0f ? weights[i] : 0.0f) * n / total;
+            (scaled[i] < 1.0 ? small : large).push_back(static_cast<std::uint32_t>(i));
+        }
+
+        while (!small.empty() && !large.empty())
+        {
+            std::uint32_t s = small.back(), l = large.back();
+            small.pop_back();
+            prob[s] = static_cast<float>(scaled[s]);
+            alias[s] = l;
+            scaled[l] -= 1.0 - scaled[s];
+            if (scaled[l] < 1.0)
+            {
+                large.pop_back();
+                small.push_back(l);
+            }
+        }
+
+        // What is left is 1 up to rounding
+        for (std::uint32_t i : large)
+            prob[i] = 1.0f;
+        for (std::uint32_t i : small)
+            prob[i] = 1.0f;
+    }
+} // end namespace
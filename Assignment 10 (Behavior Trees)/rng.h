@@ -0,0 +1,244 @@
+/*!*****************************************************************************
+\file       rng.h
+\author     Jie Le Jet Ang
+\par        DP email: jielejet.ang@digipen.edu.sg
+\par        Course: CS3183
+\par        Section: A
+\par        Programming Assignment 10
+\date       10-18-2026
+
+\brief
+	Declares Rng, a small seedable random number stream that every agent owns,
+	so random choices do not touch the global std::rand() state and give the
+	same results however the agents are spread across threads, and AliasTable,
+	which picks an index with given weights in constant time.
+*******************************************************************************/
+#ifndef RNG_H
+#define RNG_H
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+namespace AI
+{
+	// SplitMix64 random number stream
+	class Rng
+	{
+		std::uint64_t state;
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Constructs a stream from seed 0, so structs holding one can still be
+			initialized with {}.
+		*******************************************************************************/
+		Rng()
+			: state{ 0 }
+		{
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Constructs a stream from a seed.
+
+		\param seed
+			The seed.
+		*******************************************************************************/
+		explicit Rng(std::uint64_t seed)
+			: state{ seed }
+		{
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Makes the stream of one agent; streams of different agents with the
+			same seed do not overlap in practice.
+
+		\param seed
+			Seed shared by all agents.
+
+		\param agent
+			Index of the agent.
+
+		\return
+			The agent's stream.
+		*******************************************************************************/
+		static Rng forAgent(std::uint64_t seed, std::uint32_t agent)
+		{
+			Rng mix{ seed ^ (static_cast<std::uint64_t>(agent) << 32 | agent) };
+			return Rng{ mix.next64() };
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Draws the next 64 random bits.
+
+		\return
+			Random 64-bit value.
+		*******************************************************************************/
+		std::uint64_t next64()
+		{
+			std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			return z ^ (z >> 31);
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Draws the next 32 random bits.
+
+		\return
+			Random 32-bit value.
+		*******************************************************************************/
+		std::uint32_t next()
+		{
+			return static_cast<std::uint32_t>(next64() >> 32);
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Draws an integer in [0, n) by multiply and shift, without a division.
+
+		\param n
+			Number of possible values.
+
+		\return
+			Random value below n (0 if n is 0).
+		*******************************************************************************/
+		std::uint32_t below(std::uint32_t n)
+		{
+			return static_cast<std::uint32_t>((static_cast<std::uint64_t>(next()) * n) >> 32);
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Draws a float in [0, 1).
+
+		\return
+			Random value.
+		*******************************************************************************/
+		float unit()
+		{
+			return static_cast<float>(next() >> 8) * (1.0f / 16777216.0f);
+		}
+	};
+
+	/*!*****************************************************************************
+	\brief
+		Returns the random stream of the calling thread, for ticks that are given
+		no stream of their own. It starts from seed 0 in every thread, so such
+		ticks repeat from run to run and never share state across threads.
+
+	\return
+		Reference to the thread's stream.
+	*******************************************************************************/
+	Rng& default_rng();
+
+	// Walker's alias table for picking an index with given weights in O(1)
+	class AliasTable
+	{
+		std::vector<float> prob;			// Chance of keeping column i
+		std::vector<std::uint32_t> alias;	// Index taken instead of column i
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Builds the table.
+
+		\param weights
+			Weight of every index; negative weights count as 0 and if all are 0
+			every index is equally likely.
+		*******************************************************************************/
+		explicit AliasTable(const std::vector<float>& weights = {});
+
+		/*!*****************************************************************************
+		\brief
+			Restores a table from its columns, as returned by getProb and getAlias.
+
+		\param prob
+			Chance of keeping every column.
+
+		\param alias
+			Index taken instead of every column; same size as prob.
+		*******************************************************************************/
+		AliasTable(std::vector<float> prob, std::vector<std::uint32_t> alias)
+			: prob{ std::move(prob) }, alias{ std::move(alias) }
+		{
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Picks an index from a column and a uniform value.
+
+		\param column
+			Uniform random column in [0, size()).
+
+		\param u
+			Uniform random value in [0, 1).
+
+		\return
+			The picked index.
+		*******************************************************************************/
+		std::uint32_t sample(std::uint32_t column, float u) const
+		{
+			return u < prob[column] ? column : alias[column];
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Picks an index with a random stream.
+
+		\param rng
+			The stream.
+
+		\return
+			The picked index.
+		*******************************************************************************/
+		std::uint32_t sample(Rng& rng) const
+		{
+			std::uint32_t column = rng.below(static_cast<std::uint32_t>(prob.size()));
+			return sample(column, rng.unit());
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the number of indices.
+
+		\return
+			Table size.
+		*******************************************************************************/
+		std::uint32_t size() const
+		{
+			return static_cast<std::uint32_t>(prob.size());
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the chance of keeping every column.
+
+		\return
+			Reference to the column chances.
+		*******************************************************************************/
+		const std::vector<float>& getProb() const
+		{
+			return prob;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the index taken instead of every column.
+
+		\return
+			Reference to the aliases.
+		*******************************************************************************/
+		const std::vector<std::uint32_t>& getAlias() const
+		{
+			return alias;
+		}
+	};
+
+} // end namespace
+
+#endif
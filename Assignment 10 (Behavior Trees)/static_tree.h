@@ -0,0 +1,549 @@
+/*!*****************************************************************************
+\file       static_tree.h
+\author     Jie Le Jet Ang
+\par        DP email: jielejet.ang@digipen.edu.sg
+\par        Course: CS3183
+\par        Section: A
+\par        Programming Assignment 10
+\date       10-18-2026
+
+\brief
+	Declares behavior trees built at compile time from nested template types,
+	for fixed agent archetypes on hot paths:
+
+		using Guard = Static::Selector<
+			Static::Sequence<Static::Check<LowHealth>, Static::Act<Flee>>,
+			Static::Repeater<3, Static::Act<Patrol>>>;
+
+		Static::StaticTree<Guard>::Memory memory{};
+		Static::StaticTree<Guard>::tick(memory, context);
+
+	Every node is a type with a static tick, so the compiler sees the whole
+	tree and can inline it: there are no virtual calls, heap nodes or child
+	lists. The per-agent state is a plain struct nested like the tree. Results,
+	Running and resuming follow BehaviorTree exactly, so a tree can be tried out
+	at run time and frozen here once it is settled. Header only.
+*******************************************************************************/
+#ifndef STATIC_TREE_H
+#define STATIC_TREE_H
+
+#include <tuple>
+#include <cstdint>
+#include <cstddef>
+#include "behavior_tree.h"
+
+namespace AI
+{
+	namespace Static
+	{
+		// Leaf that tests a condition: Success if P::test(context) is true, Failure otherwise
+		template<typename P>
+		struct Check
+		{
+			struct Memory
+			{
+			};
+
+			/*!*****************************************************************************
+			\brief
+				Tests the condition.
+
+			\param context
+				The agent's tick context.
+
+			\param memory
+				The node's state (none).
+
+			\return
+				Success or Failure.
+			*******************************************************************************/
+			template<typename Context>
+			static Status tick(Context& context, Memory&)
+			{
+				return P::test(context) ? Status::Success : Status::Failure;
+			}
+		};
+
+		// Leaf that runs an action: returns A::run(context), which may be Running
+		template<typename A>
+		struct Act
+		{
+			struct Memory
+			{
+			};
+
+			/*!*****************************************************************************
+			\brief
+				Runs the action.
+
+			\param context
+				The agent's tick context.
+
+			\param memory
+				The node's state (none).
+
+			\return
+				Status returned by the action.
+			*******************************************************************************/
+			template<typename Context>
+			static Status tick(Context& context, Memory&)
+			{
+				return A::run(context);
+			}
+		};
+
+		// Selector and Sequence: run children in order until one returns Stop
+		//     The slot holds the running child plus one, like a BehaviorTree slot.
+		template<Status Stop, typename... Children>
+		struct Composite
+		{
+			struct Memory
+			{
+				std::uint32_t slot = 0;
+				std::tuple<typename Children::Memory...> children;
+			};
+
+			/*!*****************************************************************************
+			\brief
+				Runs child I and the ones after it, skipping those before the
+				running child.
+
+			\param context
+				The agent's tick context.
+
+			\param memory
+				The node's state.
+
+			\return
+				Stop if a child returned it, Running if one is running, the other
+				result if all children were run.
+			*******************************************************************************/
+			template<std::size_t I, typename Context>
+			static Status from(Context& context, Memory& memory)
+			{
+				if constexpr (I == sizeof...(Children))
+				{
+					memory.slot = 0;
+					return Stop == Status::Success ? Status::Failure : Status::Success;
+				}
+				else
+				{
+					if (I + 1 >= memory.slot)
+					{
+						using Child = std::tuple_element_t<I, std::tuple<Children...>>;
+						Status s = Child::tick(context, std::get<I>(memory.children));
+						if (s == Status::Running)
+						{
+							memory.slot = I + 1;
+							return Status::Running;
+						}
+						if (s == Stop)
+						{
+							memory.slot = 0;
+							return Stop;
+						}
+					}
+					return from<I + 1>(context, memory);
+				}
+			}
+
+			/*!*****************************************************************************
+			\brief
+				Runs the children, resuming at the running one.
+
+			\param context
+				The agent's tick context.
+
+			\param memory
+				The node's state.
+
+			\return
+				Resulting status.
+			*******************************************************************************/
+			template<typename Context>
+			static Status tick(Context& context, Memory& memory)
+			{
+				return from<0>(context, memory);
+			}
+		};
+
+		// Succeeds at the first child that succeeds; fails if all fail
+		template<typename... Children>
+		using Selector = Composite<Status::Success, Children...>;
+
+		// Fails at the first child that fails; succeeds if all succeed
+		template<typename... Children>
+		using Sequence = Composite<Status::Failure, Children...>;
+
+		// Runs one child picked at random, and the same one again while it is running
+		template<typename... Children>
+		struct RandomSelector
+		{
+			struct Memory
+			{
+				std::uint32_t slot = 0;
+				std::tuple<typename Children::Memory...> children;
+				Rng rng;	// Drawn from when the context has no random stream
+			};
+
+			/*!*****************************************************************************
+			\brief
+				Runs child k, found by stepping through the children at compile time.
+
+			\param context
+				The agent's tick context.
+
+			\param memory
+				The node's state.
+
+			\param k
+				Index of the child to run.
+
+			\return
+				Status of the child.
+			*******************************************************************************/
+			template<std::size_t I, typename Context>
+			static Status child(Context& context, Memory& memory, std::uint32_t k)
+			{
+				if constexpr (I + 1 == sizeof...(Children))
+				{
+					using Child = std::tuple_element_t<I, std::tuple<Children...>>;
+					return Child::tick(context, std::get<I>(memory.children));
+				}
+				else
+				{
+					using Child = std::tuple_element_t<I, std::tuple<Children...>>;
+					if (k == I)
+						return Child::tick(context, std::get<I>(memory.children));
+					return child<I + 1>(context, memory, k);
+				}
+			}
+
+			/*!*****************************************************************************
+			\brief
+				Picks a child with the agent's random stream, like BehaviorTree, or
+				with the node's own stream in the agent's memory without one, or
+				resumes the running one.
+
+			\param context
+				The agent's tick context.
+
+			\param memory
+				The node's state.
+
+			\return
+				Status of the child, Failure without children.
+			*******************************************************************************/
+			template<typename Context>
+			static Status tick(Context& context, Memory& memory)
+			{
+				constexpr std::uint32_t count = sizeof...(Children);
+				if constexpr (count == 0)
+					return Status::Failure;
+				else
+				{
+					std::uint32_t k = memory.slot ? memory.slot - 1
+						: (context.rng ? *context.rng : memory.rng).below(count);
+					Status s = child<0>(context, memory, k);
+					memory.slot = s == Status::Running ? k + 1 : 0;
+					return s;
+				}
+			}
+		};
+
+		// Runs every child each tick until SuccessCount children succeeded or FailureCount failed
+		//     A threshold of 0, or more than the number of children, means all of
+		//     them. The slot holds two bits per child: 0 to run, 1 succeeded,
+		//     2 failed.
+		template<int SuccessCount, int FailureCount, typename... Children>
+		struct Parallel
+		{
+			static_assert(sizeof...(Children) <= 16, "Parallel takes at most 16 children");
+
+			struct Memory
+			{
+				std::uint32_t slot = 0;
+				std::tuple<typename Children::Memory...> children;
+			};
+
+			/*!*****************************************************************************
+			\brief
+				Runs child I and the ones after it that are not done, and counts the
+				results.
+
+			\param context
+				The agent's tick context.
+
+			\param memory
+				The node's state.
+
+			\param successes
+				Number of children that succeeded.
+
+			\param failures
+				Number of children that failed.
+
+			\param running
+				Set if a child is running.
+			*******************************************************************************/
+			template<std::size_t I, typename Context>
+			static void from(Context& context, Memory& memory, std::uint32_t& successes, std::uint32_t& failures,
+				bool& running)
+			{
+				if constexpr (I < sizeof...(Children))
+				{
+					constexpr std::uint32_t shift = 2 * I;
+					std::uint32_t code = memory.slot >> shift & 3;
+					if (code == 0)
+					{
+						using Child = std::tuple_element_t<I, std::tuple<Children...>>;
+						Status s = Child::tick(context, std::get<I>(memory.children));
+						code = s == Status::Success ? 1 : s == Status::Failure ? 2 : 0;
+						memory.slot |= code << shift;
+						running = running || s == Status::Running;
+					}
+					successes += code == 1;
+					failures += code == 2;
+					from<I + 1>(context, memory, successes, failures, running);
+				}
+			}
+
+			/*!*****************************************************************************
+			\brief
+				Stops child I and the ones after it that are still running.
+
+			\param memory
+				The node's state.
+			*******************************************************************************/
+			template<std::size_t I>
+			static void stop(Memory& memory)
+			{
+				if constexpr (I < sizeof...(Children))
+				{
+					if ((memory.slot >> 2 * I & 3) == 0)
+						std::get<I>(memory.children) = {};
+					stop<I + 1>(memory);
+				}
+			}
+
+			/*!*****************************************************************************
+			\brief
+				Runs the children that are not done and compares the counts with the
+				thresholds; success is checked first. When the node finishes, children
+				that are still running are stopped.
+
+			\param context
+				The agent's tick context.
+
+			\param memory
+				The node's state.
+
+			\return
+				Resulting status.
+			*******************************************************************************/
+			template<typename Context>
+			static Status tick(Context& context, Memory& memory)
+			{
+				constexpr std::uint32_t count = sizeof...(Children);
+				constexpr std::uint32_t success = SuccessCount <= 0 || SuccessCount > static_cast<int>(count)
+					? count : SuccessCount;
+				constexpr std::uint32_t failure = FailureCount <= 0 || FailureCount > static_cast<int>(count)
+					? count : FailureCount;
+
+				std::uint32_t successes = 0, failures = 0;
+				bool running = false;
+				from<0>(context, memory, successes, failures, running);
+
+				Status result = successes >= success ? Status::Success
+					: failures >= failure ? Status::Failure
+					: running ? Status::Running
+					: Status::Failure;
+				if (result != Status::Running)
+				{
+					stop<0>(memory);
+					memory.slot = 0;
+				}
+				return result;
+			}
+		};
+
+		// Swaps Success and Failure of its child; Running passes through
+		template<typename Child>
+		struct Inverter
+		{
+			struct Memory
+			{
+				typename Child::Memory child;
+			};
+
+			/*!*****************************************************************************
+			\brief
+				Runs the child and inverts its result.
+
+			\param context
+				The agent's tick context.
+
+			\param memory
+				The node's state.
+
+			\return
+				Inverted status of the child.
+			*******************************************************************************/
+			template<typename Context>
+			static Status tick(Context& context, Memory& memory)
+			{
+				Status s = Child::tick(context, memory.child);
+				return s == Status::Success ? Status::Failure
+					: s == Status::Failure ? Status::Success
+					: s;
+			}
+		};
+
+		// Succeeds whatever its child returns, once the child is not running
+		template<typename Child>
+		struct Succeeder
+		{
+			struct Memory
+			{
+				typename Child::Memory child;
+			};
+
+			/*!*****************************************************************************
+			\brief
+				Runs the child.
+
+			\param context
+				The agent's tick context.
+
+			\param memory
+				The node's state.
+
+			\return
+				Running if the child is running, Success otherwise.
+			*******************************************************************************/
+			template<typename Context>
+			static Status tick(Context& context, Memory& memory)
+			{
+				return Child::tick(context, memory.child) == Status::Running ? Status::Running : Status::Success;
+			}
+		};
+
+		// Runs its child Counter times, resuming at the running repetition
+		//     Iterations and Microseconds bound the repetitions of one tick like
+		//     the LoopBudget of AI::Repeater (0 is no limit).
+		template<int Counter, typename Child, unsigned Iterations = 0, unsigned Microseconds = 0>
+		struct Repeater
+		{
+			static constexpr FlatTree::LoopPolicy LOOP{ Counter, Iterations, Microseconds };
+
+			struct Memory
+			{
+				std::uint32_t slot = 0;		// Running repetition plus one
+				typename Child::Memory child;
+			};
+
+			/*!*****************************************************************************
+			\brief
+				Runs the remaining repetitions.
+
+			\param context
+				The agent's tick context.
+
+			\param memory
+				The node's state.
+
+			\return
+				Running if the child is running or the budget is spent, Success once
+				all repetitions ran.
+			*******************************************************************************/
+			template<typename Context>
+			static Status tick(Context& context, Memory& memory)
+			{
+				LoopMeter meter{ LOOP };
+				for (int k = memory.slot ? static_cast<int>(memory.slot) - 1 : 0; k < Counter; ++k)
+				{
+					if (meter.spent() || Child::tick(context, memory.child) == Status::Running)
+					{
+						memory.slot = static_cast<std::uint32_t>(k) + 1;
+						return Status::Running;
+					}
+					meter.count();
+				}
+				memory.slot = 0;
+				return Status::Success;
+			}
+		};
+
+		// Runs its child until it fails, Iterations times and Microseconds long
+		// per tick at most (0 is no limit), or once per tick without a budget
+		template<typename Child, unsigned Iterations = 0, unsigned Microseconds = 0>
+		struct Repeat_until_fail
+		{
+			static constexpr FlatTree::LoopPolicy LOOP{ 0, Iterations, Microseconds };
+
+			struct Memory
+			{
+				typename Child::Memory child;
+			};
+
+			/*!*****************************************************************************
+			\brief
+				Runs the child while it succeeds and the budget lasts.
+
+			\param context
+				The agent's tick context.
+
+			\param memory
+				The node's state.
+
+			\return
+				Success once the child failed, Running otherwise.
+			*******************************************************************************/
+			template<typename Context>
+			static Status tick(Context& context, Memory& memory)
+			{
+				LoopMeter meter{ LOOP };
+				for (;;)
+				{
+					Status s = Child::tick(context, memory.child);
+					if (s != Status::Success)
+						return s == Status::Failure ? Status::Success : Status::Running;
+					meter.count();
+					if (!meter.limited() || meter.spent())
+						return Status::Running;
+				}
+			}
+		};
+
+		// A compile-time tree with its root
+		template<typename Root>
+		struct StaticTree
+		{
+			// State of one agent; value-initialize it for an agent with nothing running
+			using Memory = typename Root::Memory;
+
+			/*!*****************************************************************************
+			\brief
+				Ticks the tree for one agent, resuming its running nodes, like
+				BehaviorTree::tick.
+
+			\param memory
+				The agent's state.
+
+			\param context
+				The agent's tick context.
+
+			\return
+				Resulting status of the root.
+			*******************************************************************************/
+			template<typename Context>
+			static Status tick(Memory& memory, Context& context)
+			{
+				return Root::tick(context, memory);
+			}
+		};
+	} // end namespace Static
+
+} // end namespace
+
+#endif
@@ -0,0 +1,320 @@
+/*!*****************************************************************************
+\file       tick_log.cpp
+\author     Jie Le Jet Ang
+\par        DP email: jielejet.ang@digipen.edu.sg
+\par        Course: CS3183
+\par        Section: A
+\par        Programming Assignment 10
+\date       10-18-2026
+
+\brief
+    Implements the tick log: draining the rings, the log file and the decoder
+    that turns records back into the indented text of the Log stream.
+*******************************************************************************/
+#include "tick_log.h"
+#include "behavior_tree.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <cstring>
+
+namespace AI
+{
+    namespace
+    {
+        const char MAGIC[4] = { 'B', 'T', 'L', '1' };
+
+        /*!*****************************************************************************
+        \brief
+            Writes a binary value to a stream.
+
+        \param os
+            The stream.
+
+        \param value
+            The value.
+        *******************************************************************************/
+        template<typename T>
+        void put(std::ostream& os, T value)
+        {
+            os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Reads a binary value from a buffer and moves past it.
+
+        \param p
+            Read position.
+
+        \param end
+            End of the buffer.
+
+        \param value
+            Receives the value.
+
+        \return
+            True if the buffer held the whole value.
+        *******************************************************************************/
+        template<typename T>
+        bool get(const char*& p, const char* end, T& value)
+        {
+            if (static_cast<std::size_t>(end - p) < sizeof(T))
+                return false;
+            std::memcpy(&value, p, sizeof(T));
+            p += sizeof(T);
+            return true;
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Creates an empty ring. A power of two capacity turns the wrap around into a mask.
+
+    \param capacity
+        Number of records it holds, rounded up to a power of two.
+    *******************************************************************************/
+    TickRing::TickRing(std::size_t capacity)
+        : records{}, mask{ 0 }, time{ 0 }, head{ 0 }, tail{ 0 }, dropped{ 0 }
+    {
+        std::size_t size = 1;
+        while (size < capacity)
+            size <<= 1;
+        records.resize(size);
+        mask = size - 1;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Moves every record written so far to the end of a list. The acquire load of head makes the records before it
+        visible; the release store of tail hands their room back to the writer.
+
+    \param out
+        Receives the records in the order they were written.
+
+    \return
+        Number of records moved.
+    *******************************************************************************/
+    std::size_t TickRing::drain(std::vector<TickRecord>& out)
+    {
+        std::uint64_t t = tail.load(std::memory_order_relaxed);
+        std::uint64_t h = head.load(std::memory_order_acquire);
+        for (std::uint64_t k = t; k < h; ++k)
+            out.push_back(records[k & mask]);
+        tail.store(h, std::memory_order_release);
+        return static_cast<std::size_t>(h - t);
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Creates a log without rings.
+
+    \param capacity
+        Number of records every ring holds.
+    *******************************************************************************/
+    TickLog::TickLog(std::size_t capacity)
+        : rings{}, mutex{}, capacity{ capacity }
+    {
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Adds the ring of a ticking thread.
+
+    \return
+        Reference to the ring.
+    *******************************************************************************/
+    TickRing& TickLog::createRing()
+    {
+        std::lock_guard<std::mutex> lock{ mutex };
+        rings.push_back(std::unique_ptr<TickRing>(new TickRing{ capacity }));
+        return *rings.back();
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Moves the records of every ring to a list sorted by agent and then by time. An agent can be ticked on
+        different threads on different frames, so its records are gathered from all rings; the sort is stable, so
+        the records of one tick, which share a stamp, keep the order of their ring.
+
+    \param out
+        Receives the records.
+
+    \return
+        Number of records moved.
+    *******************************************************************************/
+    std::size_t TickLog::drain(std::vector<TickRecord>& out)
+    {
+        std::size_t start = out.size();
+        {
+            std::lock_guard<std::mutex> lock{ mutex };
+            for (const std::unique_ptr<TickRing>& ring : rings)
+                ring->drain(out);
+        }
+        std::stable_sort(out.begin() + start, out.end(), [](const TickRecord& a, const TickRecord& b)
+            {
+                return a.agent != b.agent ? a.agent < b.agent : a.time < b.time;
+            });
+        return out.size() - start;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Returns the number of records dropped by all rings.
+
+    \return
+        Dropped record count.
+    *******************************************************************************/
+    std::uint64_t TickLog::getDropped()
+    {
+        std::lock_guard<std::mutex> lock{ mutex };
+        std::uint64_t total = 0;
+        for (const std::unique_ptr<TickRing>& ring : rings)
+            total += ring->getDropped();
+        return total;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Writes records to a file: magic, label count, every label with its length, record count and the records as
+        they are in memory.
+
+    \param path
+        Path of the file.
+
+    \param tree
+        The logged tree.
+
+    \param records
+        The records.
+
+    \return
+        True on success.
+    *******************************************************************************/
+    bool saveTickLog(const std::string& path, const FlatTree& tree, const std::vector<TickRecord>& records)
+    {
+        std::ofstream file(path, std::ios::binary);
+        if (!file)
+            return false;
+
+        file.write(MAGIC, sizeof(MAGIC));
+        std::uint32_t count = static_cast<std::uint32_t>(tree.getNodes().size());
+        put(file, count);
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            const std::string& label = tree.getLabel(i);
+            put(file, static_cast<std::uint32_t>(label.size()));
+            file.write(label.data(), static_cast<std::streamsize>(label.size()));
+        }
+        put(file, static_cast<std::uint64_t>(records.size()));
+        file.write(reinterpret_cast<const char*>(records.data()),
+            static_cast<std::streamsize>(records.size() * sizeof(TickRecord)));
+        return static_cast<bool>(file);
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Reads a file written by saveTickLog. The file is read whole and every field is bounds checked.
+
+    \param path
+        Path of the file.
+
+    \param labels
+        Receives the label of every node.
+
+    \param records
+        Receives the records.
+
+    \return
+        True on success; false if the file is missing or damaged.
+    *******************************************************************************/
+    bool loadTickLog(const std::string& path, std::vector<std::string>& labels, std::vector<TickRecord>& records)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return false;
+        std::string data{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+        const char* p = data.data();
+        const char* end = p + data.size();
+
+        if (data.size() < sizeof(MAGIC) || std::memcmp(p, MAGIC, sizeof(MAGIC)) != 0)
+            return false;
+        p += sizeof(MAGIC);
+
+        std::uint32_t count = 0;
+        if (!get(p, end, count))
+            return false;
+        labels.clear();
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            std::uint32_t size = 0;
+            if (!get(p, end, size) || static_cast<std::size_t>(end - p) < size)
+                return false;
+            labels.emplace_back(p, size);
+            p += size;
+        }
+
+        std::uint64_t recordCount = 0;
+        if (!get(p, end, recordCount) || static_cast<std::uint64_t>(end - p) / sizeof(TickRecord) < recordCount)
+            return false;
+        records.resize(static_cast<std::size_t>(recordCount));
+        std::memcpy(records.data(), p, records.size() * sizeof(TickRecord));
+        return true;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Turns records back into the text of the Log stream. The depth of every line follows from the nesting of the
+        Enter records and the statuses, so it is not stored; records lost to a full ring can only make the indentation
+        wrong, never the decoder fail. Leaves give the same two lines as a task logging itself.
+
+    \param records
+        The records, every agent's in the order they were written.
+
+    \param labels
+        Label of every node.
+
+    \param os
+        The output stream.
+
+    \param agent
+        Agent to decode, or -1 for all.
+    *******************************************************************************/
+    void decodeTickLog(const std::vector<TickRecord>& records, const std::vector<std::string>& labels,
+        std::ostream& os, std::int64_t agent)
+    {
+        static const char* const UNKNOWN = "?";
+
+        std::int64_t current = -1;
+        int depth = 0;
+        for (const TickRecord& r : records)
+        {
+            if (agent >= 0 && r.agent != agent)
+                continue;
+            if (r.agent != current)
+            {
+                current = r.agent;
+                depth = 0;
+                if (agent < 0)
+                    os << "Agent " << r.agent << "\n";
+            }
+
+            TickEvent event = r.getEvent();
+            if (event == TickEvent::Enter)
+            {
+                for (int i = 0; i < depth; ++i)
+                    os << "| ";
+                os << (r.getNode() < labels.size() ? labels[r.getNode()].c_str() : UNKNOWN) << "\n";
+                ++depth;
+                continue;
+            }
+
+            if (depth > 0)
+                --depth;
+            for (int i = 0; i < depth; ++i)
+                os << "| ";
+            os << "L " << (event <= TickEvent::Running ? STATUSES[static_cast<int>(event)] : UNKNOWN) << "\n";
+        }
+    }
+} // end namespace
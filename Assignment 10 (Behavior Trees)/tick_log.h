@@ -0,0 +1,264 @@
+/*!*****************************************************************************
+\file       tick_log.h
+\author     Jie Le Jet Ang
+\par        DP email: jielejet.ang@digipen.edu.sg
+\par        Course: CS3183
+\par        Section: A
+\par        Programming Assignment 10
+\date       10-18-2026
+
+\brief
+	Declares the binary tick log of BehaviorTree. Instead of formatting text
+	on every node, a tick writes one small record when a node starts and one
+	when it returns into a ring buffer owned by the ticking thread, without
+	locks; the clock is read once per agent tick. The records are drained,
+	saved and turned back into the indented text of the Log stream
+	("Selector()" ... "L Success") offline, so every agent can be logged
+	while the game runs.
+*******************************************************************************/
+#ifndef TICK_LOG_H
+#define TICK_LOG_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <iostream>
+#include "flat_tree.h"
+
+namespace AI
+{
+	// What a record tells: the node started, or returned a status (same values as Status)
+	enum class TickEvent : std::uint8_t { Success, Failure, Running, Enter };
+
+	// One event of one node for one agent, 16 bytes
+	struct TickRecord
+	{
+		std::uint64_t time;		// Start of the agent's tick, in nanoseconds on the steady clock
+		std::uint32_t agent;	// Index of the agent
+		std::uint32_t code;		// Node index in the low 24 bits, TickEvent in the high 8
+
+		/*!*****************************************************************************
+		\brief
+			Returns the index of the node.
+
+		\return
+			Node index.
+		*******************************************************************************/
+		std::uint32_t getNode() const
+		{
+			return code & 0xFFFFFF;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns what happened to the node.
+
+		\return
+			The event.
+		*******************************************************************************/
+		TickEvent getEvent() const
+		{
+			return static_cast<TickEvent>(code >> 24);
+		}
+	};
+
+	// Lock-free ring buffer of records with one writer and one reader
+	//     The ticking thread pushes and a single other thread (or the same one
+	//     between ticks) drains. When the ring is full new records are dropped
+	//     and counted, so the writer never waits.
+	class TickRing
+	{
+		std::vector<TickRecord> records;
+		std::uint64_t mask;
+		std::uint64_t time;					// Stamp of the records being written
+		std::atomic<std::uint64_t> head;	// Next record to write, only written by the writer
+		std::atomic<std::uint64_t> tail;	// Next record to read, only written by the reader
+		std::atomic<std::uint64_t> dropped;
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Creates an empty ring.
+
+		\param capacity
+			Number of records it holds, rounded up to a power of two.
+		*******************************************************************************/
+		explicit TickRing(std::size_t capacity);
+
+		/*!*****************************************************************************
+		\brief
+			Reads the clock for the records of the next tick; called by the writer
+			only.
+		*******************************************************************************/
+		void stamp()
+		{
+			time = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count());
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Writes a record with the last stamp; called by the writer only.
+
+		\param agent
+			Index of the agent.
+
+		\param node
+			Index of the node.
+
+		\param event
+			What happened to the node.
+		*******************************************************************************/
+		void push(std::uint32_t agent, std::uint32_t node, TickEvent event)
+		{
+			std::uint64_t h = head.load(std::memory_order_relaxed);
+			if (h - tail.load(std::memory_order_acquire) > mask)
+			{
+				dropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+			records[h & mask] = TickRecord{ time, agent, (node & 0xFFFFFF) | static_cast<std::uint32_t>(event) << 24 };
+			head.store(h + 1, std::memory_order_release);
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Moves every record written so far to the end of a list; called by the
+			reader only.
+
+		\param out
+			Receives the records in the order they were written.
+
+		\return
+			Number of records moved.
+		*******************************************************************************/
+		std::size_t drain(std::vector<TickRecord>& out);
+
+		/*!*****************************************************************************
+		\brief
+			Returns the number of records dropped because the ring was full.
+
+		\return
+			Dropped record count.
+		*******************************************************************************/
+		std::uint64_t getDropped() const
+		{
+			return dropped.load(std::memory_order_relaxed);
+		}
+	};
+
+	// The rings of every ticking thread
+	class TickLog
+	{
+		std::vector<std::unique_ptr<TickRing>> rings;
+		std::mutex mutex;		// Guards the list of rings, not the records
+		std::size_t capacity;
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Creates a log without rings.
+
+		\param capacity
+			Number of records every ring holds (default is 65536).
+		*******************************************************************************/
+		explicit TickLog(std::size_t capacity = 1 << 16);
+
+		/*!*****************************************************************************
+		\brief
+			Adds the ring of a ticking thread, to be put in the TickContext of
+			every agent that thread ticks.
+
+		\return
+			Reference to the ring, valid as long as the log.
+		*******************************************************************************/
+		TickRing& createRing();
+
+		/*!*****************************************************************************
+		\brief
+			Moves the records of every ring to a list, sorted by agent and then by
+			time, so every agent's ticks read in order.
+
+		\param out
+			Receives the records.
+
+		\return
+			Number of records moved.
+		*******************************************************************************/
+		std::size_t drain(std::vector<TickRecord>& out);
+
+		/*!*****************************************************************************
+		\brief
+			Returns the number of records dropped by all rings.
+
+		\return
+			Dropped record count.
+		*******************************************************************************/
+		std::uint64_t getDropped();
+	};
+
+	/*!*****************************************************************************
+	\brief
+		Writes records to a file together with the labels of the tree's nodes,
+		so the file can be decoded without the tree.
+
+	\param path
+		Path of the file.
+
+	\param tree
+		The logged tree.
+
+	\param records
+		The records.
+
+	\return
+		True on success.
+	*******************************************************************************/
+	bool saveTickLog(const std::string& path, const FlatTree& tree, const std::vector<TickRecord>& records);
+
+	/*!*****************************************************************************
+	\brief
+		Reads a file written by saveTickLog.
+
+	\param path
+		Path of the file.
+
+	\param labels
+		Receives the label of every node.
+
+	\param records
+		Receives the records.
+
+	\return
+		True on success; false if the file is missing or damaged.
+	*******************************************************************************/
+	bool loadTickLog(const std::string& path, std::vector<std::string>& labels, std::vector<TickRecord>& records);
+
+	/*!*****************************************************************************
+	\brief
+		Turns records back into the text of the Log stream: a node's label when
+		it starts and "L <status>" when it returns, indented with "| " per
+		level.
+
+	\param records
+		The records, every agent's in the order they were written.
+
+	\param labels
+		Label of every node.
+
+	\param os
+		The output stream.
+
+	\param agent
+		Agent to decode (default -1 decodes all, each under an "Agent <n>" line).
+	*******************************************************************************/
+	void decodeTickLog(const std::vector<TickRecord>& records, const std::vector<std::string>& labels,
+		std::ostream& os, std::int64_t agent = -1);
+
+} // end namespace
+
+#endif
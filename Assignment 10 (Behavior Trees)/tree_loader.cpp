@@ -0,0 +1,1823 @@
+/*!*****************************************************************************
+\file       tree_loader.cpp
+\author     Jie Le Jet Ang
+\par        DP email: jielejet.ang@digipen.edu.sg
+\par        Course: CS3183
+\par        Section: A
+\par        Programming Assignment 10
+\date       10-18-2026
+
+\brief
+    Implements TreeLoader: the recursive descent parser of tree definitions,
+    the factories of the built-in node types, and the binary cache of
+    compiled trees with its memory-mapped reader.
+*******************************************************************************/
+#include "tree_loader.h"
+
+#include <fstream>
+#include <cstddef>
+#include <sstream>
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace AI
+{
+    namespace
+    {
+        const char CACHE_MAGIC[4] = { 'B', 'T', 'C', '5' };
+
+        /*!*****************************************************************************
+        \brief
+            Removes the spaces at both ends of a string.
+
+        \param s
+            The string.
+
+        \return
+            The trimmed string.
+        *******************************************************************************/
+        std::string trim(const std::string& s)
+        {
+            std::size_t b = s.find_first_not_of(" \t\r\n");
+            if (b == std::string::npos)
+                return {};
+            return s.substr(b, s.find_last_not_of(" \t\r\n") - b + 1);
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Reads a whole integer.
+
+        \param s
+            The text.
+
+        \param out
+            Receives the value.
+
+        \return
+            True if the whole text is an integer.
+        *******************************************************************************/
+        bool parseInt(const std::string& s, int& out)
+        {
+            char* end = nullptr;
+            long v = std::strtol(s.c_str(), &end, 10);
+            if (s.empty() || *end)
+                return false;
+            out = static_cast<int>(v);
+            return true;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Reads a whole number, with an optional f suffix.
+
+        \param s
+            The text.
+
+        \param out
+            Receives the value.
+
+        \return
+            True if the whole text is a number.
+        *******************************************************************************/
+        bool parseFloat(const std::string& s, float& out)
+        {
+            char* end = nullptr;
+            float v = std::strtof(s.c_str(), &end);
+            if (s.empty() || end == s.c_str() || (*end && !(end[0] == 'f' && !end[1])))
+                return false;
+            out = v;
+            return true;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Reads a state name.
+
+        \param s
+            The text ("Success" or "Failure").
+
+        \param out
+            Receives the state.
+
+        \return
+            True if the text names a state.
+        *******************************************************************************/
+        bool parseState(const std::string& s, State& out)
+        {
+            if (s == "Success")
+                out = State::Success;
+            else if (s == "Failure")
+                out = State::Failure;
+            else
+                return false;
+            return true;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Checks the number of arguments and children of a definition.
+
+        \param spec
+            The definition.
+
+        \param maxArgs
+            Largest number of arguments.
+
+        \param maxChildren
+            Largest number of children.
+
+        \param error
+            Receives the message on failure.
+
+        \return
+            True if the definition fits.
+        *******************************************************************************/
+        bool expect(const NodeSpec& spec, std::size_t maxArgs, std::size_t maxChildren, std::string& error)
+        {
+            if (spec.args.size() > maxArgs)
+                error = spec.type + " takes at most " + std::to_string(maxArgs) + " arguments";
+            else if (spec.children.size() > maxChildren)
+                error = spec.type + " takes at most " + std::to_string(maxChildren) + " children";
+            else
+                return true;
+            return false;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Returns the only child of a decorator definition.
+
+        \param spec
+            The definition.
+
+        \return
+            The child, or an empty pointer.
+        *******************************************************************************/
+        SMART onlyChild(const NodeSpec& spec)
+        {
+            return spec.children.empty() ? SMART{} : spec.children[0];
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Makes a Condition or Assign node from "key op value". The type of the key is the type it was declared with,
+            or else the type of the literal: true/false is bool, a number with a point or exponent is float, any other
+            number is int.
+
+        \param spec
+            The definition.
+
+        \param schema
+            Schema of the keys.
+
+        \param error
+            Receives the message on failure.
+
+        \param assign
+            True for Assign, false for Condition.
+
+        \return
+            The node, or an empty pointer on failure.
+        *******************************************************************************/
+        SMART makeBoardNode(const NodeSpec& spec, BlackboardSchema& schema, std::string& error, bool assign)
+        {
+            static const char* const ops[] = { "==", "!=", "<=", ">=", "<", ">" };
+            static const Compare compares[] = { Compare::Equal, Compare::NotEqual, Compare::LessEqual,
+                Compare::GreaterEqual, Compare::Less, Compare::Greater };
+
+            if (spec.args.size() != 1 || !spec.children.empty())
+            {
+                error = spec.type + " takes one argument and no children";
+                return {};
+            }
+            const std::string& arg = spec.args[0];
+
+            std::size_t at = std::string::npos, width = 1;
+            Compare compare = Compare::Equal;
+            if (assign)
+                at = arg.find('=');
+            else
+                for (int k = 0; k < 6 && at == std::string::npos; ++k)
+                    if ((at = arg.find(ops[k])) != std::string::npos)
+                    {
+                        width = std::strlen(ops[k]);
+                        compare = compares[k];
+                    }
+            if (at == std::string::npos)
+            {
+                error = spec.type + "(" + arg + ") has no " + (assign ? "'='" : "comparison");
+                return {};
+            }
+
+            std::string name = trim(arg.substr(0, at)), text = trim(arg.substr(at + width));
+            ValueType type = text == "true" || text == "false" ? ValueType::Bool
+                : text.find_first_of(".eE") != std::string::npos ? ValueType::Float
+                : ValueType::Int;
+            if (schema.find<bool>(name).valid())
+                type = ValueType::Bool;
+            else if (schema.find<float>(name).valid())
+                type = ValueType::Float;
+            else if (schema.find<std::int32_t>(name).valid())
+                type = ValueType::Int;
+
+            int i = 0;
+            float f = 0.0f;
+            switch (type)
+            {
+            case ValueType::Bool:
+                if (text != "true" && text != "false")
+                    break;
+                if (assign)
+                    return SMART(new Assign(schema.add<bool>(name), text == "true"));
+                return SMART(new Condition(schema.add<bool>(name), compare, text == "true"));
+            case ValueType::Float:
+                if (!parseFloat(text, f))
+                    break;
+                if (assign)
+                    return SMART(new Assign(schema.add<float>(name), f));
+                return SMART(new Condition(schema.add<float>(name), compare, f));
+            case ValueType::Int:
+            default:
+                if (!parseInt(text, i))
+                    break;
+                if (assign)
+                    return SMART(new Assign(schema.add<std::int32_t>(name), static_cast<std::int32_t>(i)));
+                return SMART(new Condition(schema.add<std::int32_t>(name), compare, static_cast<std::int32_t>(i)));
+            }
+            error = "'" + text + "' is not a valid value for key '" + name + "'";
+            return {};
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Makes a Selector from its children.
+
+        \param spec
+            The definition.
+
+        \param schema
+            Schema of the blackboard keys.
+
+        \param error
+            Receives the message on failure.
+
+        \return
+            The node, or an empty pointer on failure.
+        *******************************************************************************/
+        SMART makeSelector(const NodeSpec& spec, BlackboardSchema&, std::string& error)
+        {
+            return expect(spec, 0, spec.children.size(), error) ? SMART(new Selector(spec.children)) : SMART{};
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Makes a Sequence from its children.
+
+        \param spec
+            The definition.
+
+        \param schema
+            Schema of the blackboard keys.
+
+        \param error
+            Receives the message on failure.
+
+        \return
+            The node, or an empty pointer on failure.
+        *******************************************************************************/
+        SMART makeSequence(const NodeSpec& spec, BlackboardSchema&, std::string& error)
+        {
+            return expect(spec, 0, spec.children.size(), error) ? SMART(new Sequence(spec.children)) : SMART{};
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Makes a RandomSelector; the arguments, if any, are the child weights, one for every child.
+
+        \param spec
+            The definition.
+
+        \param schema
+            Schema of the blackboard keys.
+
+        \param error
+            Receives the message on failure.
+
+        \return
+            The node, or an empty pointer on failure.
+        *******************************************************************************/
+        SMART makeRandomSelector(const NodeSpec& spec, BlackboardSchema&, std::string& error)
+        {
+            if (!spec.args.empty() && spec.args.size() != spec.children.size())
+            {
+                error = "RandomSelector has " + std::to_string(spec.args.size()) + " weights for "
+                    + std::to_string(spec.children.size()) + " children";
+                return {};
+            }
+            std::vector<float> weights(spec.args.size());
+            for (std::size_t k = 0; k < spec.args.size(); ++k)
+                if (!parseFloat(spec.args[k], weights[k]))
+                {
+                    error = "RandomSelector weight '" + spec.args[k] + "' is not a number";
+                    return {};
+                }
+            return SMART(new RandomSelector(spec.children, weights));
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Makes a Parallel of at most Parallel::PARALLEL_MAX children; the arguments are the success and failure
+            thresholds, then a job flag (0 or 1) for every child.
+
+        \param spec
+            The definition.
+
+        \param schema
+            Schema of the blackboard keys.
+
+        \param error
+            Receives the message on failure.
+
+        \return
+            The node, or an empty pointer on failure.
+        *******************************************************************************/
+        SMART makeParallel(const NodeSpec& spec, BlackboardSchema&, std::string& error)
+        {
+            // Parallel(success, failure, job flag of every child...)
+            int success = 0, failure = 1, flag = 0;
+            std::vector<bool> jobs;
+            if (!expect(spec, spec.children.size() + 2, Parallel::PARALLEL_MAX, error))
+                return {};
+            for (std::size_t k = 0; k < spec.args.size(); ++k)
+            {
+                int& target = k == 0 ? success : k == 1 ? failure : flag;
+                if (!parseInt(spec.args[k], target))
+                {
+                    error = "Parallel argument '" + spec.args[k] + "' is not an integer";
+                    return {};
+                }
+                if (k >= 2)
+                    jobs.push_back(flag != 0);
+            }
+            return SMART(new Parallel(spec.children, success, failure, jobs));
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Makes an Inverter of its only child.
+
+        \param spec
+            The definition.
+
+        \param schema
+            Schema of the blackboard keys.
+
+        \param error
+            Receives the message on failure.
+
+        \return
+            The node, or an empty pointer on failure.
+        *******************************************************************************/
+        SMART makeInverter(const NodeSpec& spec, BlackboardSchema&, std::string& error)
+        {
+            return expect(spec, 0, 1, error) ? SMART(new Inverter(onlyChild(spec))) : SMART{};
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Makes a Succeeder of its only child.
+
+        \param spec
+            The definition.
+
+        \param schema
+            Schema of the blackboard keys.
+
+        \param error
+            Receives the message on failure.
+
+        \return
+            The node, or an empty pointer on failure.
+        *******************************************************************************/
+        SMART makeSucceeder(const NodeSpec& spec, BlackboardSchema&, std::string& error)
+        {
+            return expect(spec, 0, 1, error) ? SMART(new Succeeder(onlyChild(spec))) : SMART{};
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Reads the per-tick budget of a loop decorator from its arguments.
+
+        \param spec
+            The definition.
+
+        \param from
+            Index of the iteration budget; the time budget in microseconds follows.
+
+        \param budget
+            Receives the budget; arguments left out keep their value.
+
+        \param error
+            Receives the message on failure.
+
+        \return
+            True if the arguments are integers.
+        *******************************************************************************/
+        bool parseBudget(const NodeSpec& spec, std::size_t from, LoopBudget& budget, std::string& error)
+        {
+            int* fields[] = { &budget.iterations, &budget.microseconds };
+            for (std::size_t k = from; k < spec.args.size() && k < from + 2; ++k)
+                if (!parseInt(spec.args[k], *fields[k - from]) || *fields[k - from] < 0)
+                {
+                    error = spec.type + " budget '" + spec.args[k] + "' is not a count";
+                    return false;
+                }
+            return true;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Makes a Repeat_until_fail of its only child; the optional arguments are
+            the runs and microseconds it may take per tick (default no budget).
+
+        \param spec
+            The definition.
+
+        \param schema
+            Schema of the blackboard keys.
+
+        \param error
+            Receives the message on failure.
+
+        \return
+            The node, or an empty pointer on failure.
+        *******************************************************************************/
+        SMART makeRepeatUntilFail(const NodeSpec& spec, BlackboardSchema&, std::string& error)
+        {
+            LoopBudget budget;
+            if (!expect(spec, 2, 1, error) || !parseBudget(spec, 0, budget, error))
+                return {};
+            return SMART(new Repeat_until_fail(onlyChild(spec), budget));
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Makes a Repeater of its only child; the arguments are the repetition
+            count and optionally the repetitions and microseconds it may take per
+            tick (default no limit).
+
+        \param spec
+            The definition.
+
+        \param schema
+            Schema of the blackboard keys.
+
+        \param error
+            Receives the message on failure.
+
+        \return
+            The node, or an empty pointer on failure.
+        *******************************************************************************/
+        SMART makeRepeater(const NodeSpec& spec, BlackboardSchema&, std::string& error)
+        {
+            int counter = 0;
+            LoopBudget budget;
+            if (!expect(spec, 3, 1, error))
+                return {};
+            if (!spec.args.empty() && !parseInt(spec.args[0], counter))
+            {
+                error = "Repeater count '" + spec.args[0] + "' is not an integer";
+                return {};
+            }
+            if (!parseBudget(spec, 1, budget, error))
+                return {};
+            return SMART(new Repeater(onlyChild(spec), counter, budget));
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Makes a CheckState from a task id, the task's state and the checked state.
+
+        \param spec
+            The definition.
+
+        \param schema
+            Schema of the blackboard keys.
+
+        \param error
+            Receives the message on failure.
+
+        \return
+            The node, or an empty pointer on failure.
+        *******************************************************************************/
+        SMART makeCheckState(const NodeSpec& spec, BlackboardSchema&, std::string& error)
+        {
+            // CheckState(task id, task state, checked state = Success)
+            State taskState = State::Success, checkState = State::Success;
+            if (spec.args.size() < 2 || spec.args.size() > 3 || !spec.children.empty())
+            {
+                error = "CheckState takes a task id, its state and optionally the checked state";
+                return {};
+            }
+            if (!parseState(spec.args[1], taskState) || (spec.args.size() == 3 && !parseState(spec.args[2], checkState)))
+            {
+                error = "CheckState states must be Success or Failure";
+                return {};
+            }
+            return SMART(new CheckState(Task{ spec.args[0], taskState }, checkState));
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Makes a Condition from "key op value".
+
+        \param spec
+            The definition.
+
+        \param schema
+            Schema of the blackboard keys.
+
+        \param error
+            Receives the message on failure.
+
+        \return
+            The node, or an empty pointer on failure.
+        *******************************************************************************/
+        SMART makeCondition(const NodeSpec& spec, BlackboardSchema& schema, std::string& error)
+        {
+            return makeBoardNode(spec, schema, error, false);
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Makes an Assign from "key = value".
+
+        \param spec
+            The definition.
+
+        \param schema
+            Schema of the blackboard keys.
+
+        \param error
+            Receives the message on failure.
+
+        \return
+            The node, or an empty pointer on failure.
+        *******************************************************************************/
+        SMART makeAssign(const NodeSpec& spec, BlackboardSchema& schema, std::string& error)
+        {
+            return makeBoardNode(spec, schema, error, true);
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Makes a plain leaf task from its id.
+
+        \param spec
+            The definition.
+
+        \param schema
+            Schema of the blackboard keys.
+
+        \param error
+            Receives the message on failure.
+
+        \return
+            The node, or an empty pointer on failure.
+        *******************************************************************************/
+        SMART makeLeaf(const NodeSpec& spec, BlackboardSchema&, std::string& error)
+        {
+            if (spec.args.size() != 1 || !spec.children.empty())
+            {
+                error = "Leaf takes one id and no children";
+                return {};
+            }
+            return SMART(new Task(spec.args[0]));
+        }
+
+        // Appends binary values to the cache image
+        struct Writer
+        {
+            std::string out;
+
+            template<typename T>
+            void put(T value)
+            {
+                out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+            }
+        };
+
+        // Arrays of a cache image, in file order; Chars is last as it is the only one not made of 4-byte fields
+        enum Section { Strings, Specs, Args, Trees, Nodes, Labels, Leaves, Ops, Aliases, AliasEntries, Policies, Loops,
+            Chars, SECTION_COUNT };
+
+        // Place of an array in the image: offset from the start of the file and number of records
+        struct SectionRecord
+        {
+            std::uint32_t offset;
+            std::uint32_t count;
+        };
+
+        // A string, as a range of the Chars array
+        struct StringRecord
+        {
+            std::uint32_t first;
+            std::uint32_t length;
+        };
+
+        // Definition of a leaf or of a child of one; the children of a definition follow each other in Specs, after it
+        struct SpecRecord
+        {
+            std::uint32_t type;			// String of the node type
+            std::uint32_t firstArg;		// Arguments in Args, as strings
+            std::uint32_t argCount;
+            std::uint32_t firstChild;
+            std::uint32_t childCount;
+        };
+
+        // The ranges of one tree in the arrays
+        struct TreeRecord
+        {
+            std::uint32_t name;			// String of the name
+            std::uint32_t firstNode;	// Nodes, and Labels as strings
+            std::uint32_t nodeCount;
+            std::uint32_t firstLeaf;	// Leaves, as indices in Specs
+            std::uint32_t leafCount;
+            std::uint32_t firstOp;
+            std::uint32_t opCount;
+            std::uint32_t firstAlias;
+            std::uint32_t aliasCount;
+            std::uint32_t firstPolicy;
+            std::uint32_t policyCount;
+            std::uint32_t firstLoop;
+            std::uint32_t loopCount;
+        };
+
+        // A blackboard operation, with its key by name
+        struct OpRecord
+        {
+            std::uint32_t key;			// String of the key name, NO_STRING for an invalid key
+            std::uint8_t type;
+            std::uint8_t compare;
+            std::uint16_t padding;
+            Cell operand;
+        };
+
+        // An alias table, as a range of AliasEntries
+        struct AliasRecord
+        {
+            std::uint32_t first;
+            std::uint32_t size;
+        };
+
+        // One column of an alias table
+        struct AliasEntry
+        {
+            float prob;
+            std::uint32_t alias;
+        };
+
+        const std::uint32_t NO_STRING = 0xFFFFFFFF;
+
+        // Nodes and policies are stored as they are in memory, so a tree's arrays are copied in one call
+        static_assert(sizeof(FlatTree::FlatNode) == 12 && offsetof(FlatTree::FlatNode, count) == 2
+            && offsetof(FlatTree::FlatNode, first) == 4 && offsetof(FlatTree::FlatNode, param) == 8,
+            "FlatNode must have the cached layout");
+        static_assert(sizeof(FlatTree::ParallelPolicy) == 8 && sizeof(FlatTree::LoopPolicy) == 12,
+            "Policies must have the cached layout");
+
+        // Size of a record of every section
+        const std::size_t RECORD_SIZES[SECTION_COUNT] = { sizeof(StringRecord), sizeof(SpecRecord),
+            sizeof(std::uint32_t), sizeof(TreeRecord), sizeof(FlatTree::FlatNode), sizeof(std::uint32_t),
+            sizeof(std::uint32_t), sizeof(OpRecord), sizeof(AliasRecord), sizeof(AliasEntry),
+            sizeof(FlatTree::ParallelPolicy), sizeof(FlatTree::LoopPolicy), 1 };
+
+        const std::size_t HEADER_SIZE = sizeof(CACHE_MAGIC) + sizeof(std::uint64_t)
+            + SECTION_COUNT * sizeof(SectionRecord);
+
+        // A read-only file mapped into memory
+        class MappedFile
+        {
+            const char* data = nullptr;
+            std::size_t size = 0;
+#ifdef _WIN32
+            HANDLE file = INVALID_HANDLE_VALUE;
+            HANDLE mapping = nullptr;
+#endif
+
+        public:
+            explicit MappedFile(const std::string& path)
+            {
+#ifdef _WIN32
+                file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                    FILE_ATTRIBUTE_NORMAL, nullptr);
+                LARGE_INTEGER length;
+                if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &length) || length.QuadPart == 0)
+                    return;
+                mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (!mapping)
+                    return;
+                data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                size = data ? static_cast<std::size_t>(length.QuadPart) : 0;
+#else
+                int fd = open(path.c_str(), O_RDONLY);
+                if (fd < 0)
+                    return;
+                struct stat info;
+                if (fstat(fd, &info) == 0 && info.st_size > 0)
+                {
+                    void* view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (view != MAP_FAILED)
+                    {
+                        data = static_cast<const char*>(view);
+                        size = static_cast<std::size_t>(info.st_size);
+                    }
+                }
+                close(fd);
+#endif
+            }
+
+            ~MappedFile()
+            {
+#ifdef _WIN32
+                if (data)
+                    UnmapViewOfFile(data);
+                if (mapping)
+                    CloseHandle(mapping);
+                if (file != INVALID_HANDLE_VALUE)
+                    CloseHandle(file);
+#else
+                if (data)
+                    munmap(const_cast<char*>(data), size);
+#endif
+            }
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            const char* begin() const { return data; }
+            const char* end() const { return data + size; }
+        };
+    }
+
+    // Recursive descent parser over the text of a definition
+    struct TreeLoader::Parser
+    {
+        TreeLoader& loader;
+        const char* p;
+        const char* end;
+        int line;
+
+        /*!*****************************************************************************
+        \brief
+            Records a parse error at the current line.
+
+        \param message
+            What is wrong.
+
+        \return
+            An empty pointer.
+        *******************************************************************************/
+        SMART fail(const std::string& message)
+        {
+            loader.error = "line " + std::to_string(line) + ": " + message;
+            return {};
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Skips spaces, line breaks and comments (# or // to the end of the line).
+        *******************************************************************************/
+        void skip()
+        {
+            while (p < end)
+            {
+                if (*p == '\n')
+                    ++line;
+                if (*p == '#' || (*p == '/' && p + 1 < end && p[1] == '/'))
+                    while (p < end && *p != '\n')
+                        ++p;
+                else if (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')
+                    ++p;
+                else
+                    break;
+            }
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Reads a name made of letters, digits and underscores.
+
+        \param out
+            Receives the name.
+
+        \return
+            True if a name was read.
+        *******************************************************************************/
+        bool name(std::string& out)
+        {
+            const char* b = p;
+            while (p < end && (std::isalnum(static_cast<unsigned char>(*p)) || *p == '_'))
+                ++p;
+            out.assign(b, p);
+            return p > b;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Reads a node: a quoted leaf id, or a name followed by optional (arguments) and {children}.
+
+        \param definition
+            Receives the type, arguments and children's definitions of the node.
+
+        \return
+            The node, or an empty pointer on error.
+        *******************************************************************************/
+        SMART node(LeafSpec& definition)
+        {
+            skip();
+            int at = line;
+            NodeSpec spec;
+
+            if (p < end && *p == '"')
+            {
+                const char* b = ++p;
+                while (p < end && *p != '"' && *p != '\n')
+                    ++p;
+                if (p == end || *p != '"')
+                    return fail("unterminated string");
+                spec.type = "Leaf";
+                spec.args.emplace_back(b, p++);
+            }
+            else
+            {
+                if (!name(spec.type))
+                    return fail(p < end ? std::string("unexpected '") + *p + "'" : "unexpected end of file");
+
+                bool hasArgs = false, hasBody = false;
+                skip();
+                if (p < end && *p == '(')
+                {
+                    // Arguments are split at commas that are not nested in parentheses
+                    hasArgs = true;
+                    int nesting = 0;
+                    std::string arg;
+                    for (++p; p < end && (*p != ')' || nesting); ++p)
+                    {
+                        if (*p == '\n')
+                            return fail("missing ')'");
+                        nesting += *p == '(' ? 1 : *p == ')' ? -1 : 0;
+                        if (*p == ',' && !nesting)
+                        {
+                            spec.args.push_back(trim(arg));
+                            arg.clear();
+                        }
+                        else
+                            arg += *p;
+                    }
+                    if (p == end)
+                        return fail("missing ')'");
+                    ++p;
+                    if (!spec.args.empty() || !trim(arg).empty())
+                        spec.args.push_back(trim(arg));
+                    skip();
+                }
+                if (p < end && *p == '{')
+                {
+                    hasBody = true;
+                    for (++p;;)
+                    {
+                        skip();
+                        if (p == end)
+                            return fail("missing '}' of " + spec.type + " from line " + std::to_string(at));
+                        if (*p == '}')
+                            break;
+                        definition.children.emplace_back();
+                        SMART child = node(definition.children.back());
+                        if (!child)
+                            return {};
+                        spec.children.push_back(child);
+                    }
+                    ++p;
+                }
+
+                if (!loader.factories.count(spec.type))
+                {
+                    if (hasArgs || hasBody)
+                        return fail("unknown node type '" + spec.type + "'");
+                    spec.args.push_back(spec.type);
+                    spec.type = "Leaf";
+                }
+            }
+
+            std::string message;
+            SMART task = loader.factories[spec.type](spec, loader.schema, message);
+            if (!task)
+            {
+                line = at;
+                return fail(message.empty() ? "invalid " + spec.type : message);
+            }
+
+            // Nodes that compile to leaves are remembered with their children's definitions so the cache can make
+            // them again; a plain Leaf is made again from its id
+            definition.type = std::move(spec.type);
+            definition.args = std::move(spec.args);
+            Node* n = dynamic_cast<Node*>(task.get());
+            if ((!n || n->kind() == NodeKind::Custom) && definition.type != "Leaf")
+                loader.leafSpecs[task.get()] = std::make_shared<const LeafSpec>(definition);
+            return task;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Reads every "tree name = node" definition of the text.
+
+        \param trees
+            Receives the roots by name.
+
+        \return
+            True on success.
+        *******************************************************************************/
+        bool file(std::map<std::string, SMART>& trees)
+        {
+            for (;;)
+            {
+                skip();
+                if (p == end)
+                    return true;
+
+                std::string keyword, tree;
+                std::string problem;
+                if (!name(keyword) || keyword != "tree")
+                    problem = "expected 'tree'";
+                else if (skip(), !name(tree))
+                    problem = "expected a tree name";
+                else if (skip(), p == end || *p != '=')
+                    problem = "expected '=' after tree " + tree;
+                if (!problem.empty())
+                {
+                    fail(problem);
+                    return false;
+                }
+                ++p;
+
+                LeafSpec definition;
+                SMART root = node(definition);
+                if (!root)
+                    return false;
+                if (!trees.emplace(tree, root).second)
+                {
+                    fail("tree '" + tree + "' is defined twice");
+                    return false;
+                }
+            }
+        }
+    };
+
+    // Builds the arrays of a cache image; equal strings and equal definitions are stored once
+    struct TreeLoader::CacheWriter
+    {
+        Writer sections[SECTION_COUNT];
+        std::uint32_t counts[SECTION_COUNT] = {};
+        std::unordered_map<std::string, std::uint32_t> strings;
+        std::map<std::vector<std::uint32_t>, std::uint32_t> stored;	// Definitions by their flattened strings
+        std::vector<SpecRecord> specs;
+
+        /*!*****************************************************************************
+        \brief
+            Appends a record to a section.
+
+        \param section
+            The section.
+
+        \param record
+            The record.
+        *******************************************************************************/
+        template<typename T>
+        void add(Section section, const T& record)
+        {
+            sections[section].put(record);
+            ++counts[section];
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Appends a node in the layout of FlatNode, with its padding byte cleared.
+
+        \param n
+            The node.
+        *******************************************************************************/
+        void node(const FlatTree::FlatNode& n)
+        {
+            Writer& w = sections[Nodes];
+            w.put(static_cast<std::uint8_t>(n.op));
+            w.put(std::uint8_t{ 0 });
+            w.put(n.count);
+            w.put(n.first);
+            w.put(n.param);
+            ++counts[Nodes];
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Returns the index of a string, storing it the first time.
+
+        \param s
+            The string.
+
+        \return
+            Index in Strings.
+        *******************************************************************************/
+        std::uint32_t string(const std::string& s)
+        {
+            auto it = strings.emplace(s, counts[Strings]);
+            if (it.second)
+            {
+                add(Strings, StringRecord{ counts[Chars], static_cast<std::uint32_t>(s.size()) });
+                sections[Chars].out += s;
+                counts[Chars] += static_cast<std::uint32_t>(s.size());
+            }
+            return it.first->second;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Stores a definition in Specs at an index taken for it, its children after the last record.
+
+        \param at
+            Index of the definition.
+
+        \param definition
+            The definition.
+        *******************************************************************************/
+        void fill(std::uint32_t at, const LeafSpec& definition)
+        {
+            SpecRecord record{ string(definition.type), counts[Args],
+                static_cast<std::uint32_t>(definition.args.size()), static_cast<std::uint32_t>(specs.size()),
+                static_cast<std::uint32_t>(definition.children.size()) };
+            for (const std::string& arg : definition.args)
+                add(Args, string(arg));
+            specs.resize(specs.size() + definition.children.size());
+            for (std::uint32_t k = 0; k < record.childCount; ++k)
+                fill(record.firstChild + k, definition.children[k]);
+            specs[at] = record;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Appends a definition in preorder to a key that tells it apart: its type, the number and strings of its
+            arguments, then the number and keys of its children.
+
+        \param definition
+            The definition.
+
+        \param key
+            Receives the key.
+        *******************************************************************************/
+        void flatten(const LeafSpec& definition, std::vector<std::uint32_t>& key)
+        {
+            key.push_back(string(definition.type));
+            key.push_back(static_cast<std::uint32_t>(definition.args.size()));
+            for (const std::string& arg : definition.args)
+                key.push_back(string(arg));
+            key.push_back(static_cast<std::uint32_t>(definition.children.size()));
+            for (const LeafSpec& child : definition.children)
+                flatten(child, key);
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Returns the index of the definition of a leaf, storing it unless an equal one was stored.
+
+        \param definition
+            The definition.
+
+        \return
+            Index in Specs.
+        *******************************************************************************/
+        std::uint32_t spec(const LeafSpec& definition)
+        {
+            std::vector<std::uint32_t> key;
+            flatten(definition, key);
+            auto it = stored.find(key);
+            if (it != stored.end())
+                return it->second;
+            std::uint32_t at = static_cast<std::uint32_t>(specs.size());
+            specs.emplace_back();
+            fill(at, definition);
+            stored.emplace(std::move(key), at);
+            return at;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Returns the image: the header with the place of every section, then the sections in order.
+
+        \param sourceHash
+            Hash of the definition the trees came from.
+
+        \return
+            The image.
+        *******************************************************************************/
+        std::string image(std::uint64_t sourceHash)
+        {
+            for (const SpecRecord& record : specs)
+                add(Specs, record);
+
+            Writer w;
+            w.out.append(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+            w.put(sourceHash);
+            std::size_t offset = HEADER_SIZE;
+            for (int s = 0; s < SECTION_COUNT; ++s)
+            {
+                w.put(SectionRecord{ static_cast<std::uint32_t>(offset), counts[s] });
+                offset += sections[s].out.size();
+            }
+            w.out.reserve(offset);
+            for (const Writer& section : sections)
+                w.out += section.out;
+            return w.out;
+        }
+    };
+
+    // Reads the arrays of a mapped cache image and makes the leaves of its trees again
+    //     Strings are made once and definitions are resolved to their factory
+    //     once, however many leaves share them.
+    struct TreeLoader::CacheReader
+    {
+        TreeLoader& loader;
+        const char* base;
+        SectionRecord sections[SECTION_COUNT];
+        std::vector<std::string> strings;
+        std::vector<std::uint32_t> args;
+        std::vector<SpecRecord> specs;
+        std::vector<NodeSpec> definitions;		// Type and arguments of every definition, filled when first made
+        std::vector<NodeFactory> factories;		// Factory of every definition, nullptr until first made
+        std::vector<BlackboardKey> keys;		// Key named by every string, invalid until first declared
+        std::vector<std::shared_ptr<const LeafSpec>> kept;	// Definition of every spec as saveCache takes it, once
+
+        /*!*****************************************************************************
+        \brief
+            Copies records of a section, checking that they lie inside it.
+
+        \param section
+            The section.
+
+        \param first
+            Index of the first record.
+
+        \param count
+            Number of records.
+
+        \param out
+            Receives the records.
+
+        \return
+            True if the records lie inside the section.
+        *******************************************************************************/
+        template<typename T>
+        bool read(Section section, std::uint64_t first, std::uint64_t count, T* out) const
+        {
+            if (first + count > sections[section].count)
+                return false;
+            if (count)
+                std::memcpy(out, base + sections[section].offset + first * sizeof(T), count * sizeof(T));
+            return true;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Reads the section table, checking that every section lies inside the image, then makes every string and
+            reads every definition, checking that every index they hold points into its array and that children come
+            after their parent.
+
+        \param size
+            Size of the image.
+
+        \return
+            True if the image is whole.
+        *******************************************************************************/
+        bool open(std::size_t size)
+        {
+            std::memcpy(sections, base + sizeof(CACHE_MAGIC) + sizeof(std::uint64_t), sizeof(sections));
+            for (int s = 0; s < SECTION_COUNT; ++s)
+                if (sections[s].offset < HEADER_SIZE
+                    || sections[s].offset + std::uint64_t{ sections[s].count } * RECORD_SIZES[s] > size)
+                    return false;
+
+            const char* chars = base + sections[Chars].offset;
+            std::vector<StringRecord> records(sections[Strings].count);
+            read(Strings, 0, records.size(), records.data());
+            strings.reserve(records.size());
+            for (const StringRecord& r : records)
+            {
+                if (std::uint64_t{ r.first } + r.length > sections[Chars].count)
+                    return false;
+                strings.emplace_back(chars + r.first, r.length);
+            }
+
+            args.resize(sections[Args].count);
+            specs.resize(sections[Specs].count);
+            read(Args, 0, args.size(), args.data());
+            read(Specs, 0, specs.size(), specs.data());
+            for (std::uint32_t arg : args)
+                if (arg >= strings.size())
+                    return false;
+            for (std::size_t s = 0; s < specs.size(); ++s)
+            {
+                const SpecRecord& r = specs[s];
+                bool children = r.childCount == 0
+                    || (r.firstChild > s && std::uint64_t{ r.firstChild } + r.childCount <= specs.size());
+                if (r.type >= strings.size() || std::uint64_t{ r.firstArg } + r.argCount > args.size() || !children)
+                    return false;
+            }
+            definitions.resize(specs.size());
+            factories.resize(specs.size(), nullptr);
+            keys.resize(strings.size());
+            kept.resize(specs.size());
+            return true;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Makes a node from its definition, its children first.
+
+        \param s
+            Index of the definition.
+
+        \param message
+            Receives the problem on failure.
+
+        \return
+            The node, or an empty pointer on failure.
+        *******************************************************************************/
+        SMART make(std::uint32_t s, std::string& message)
+        {
+            const SpecRecord& r = specs[s];
+            NodeSpec& spec = definitions[s];
+            if (!factories[s])
+            {
+                auto it = loader.factories.find(strings[r.type]);
+                if (it == loader.factories.end())
+                {
+                    message = "of unknown type '" + strings[r.type] + "'";
+                    return {};
+                }
+                factories[s] = it->second;
+                spec.type = strings[r.type];
+                for (std::uint32_t a = 0; a < r.argCount; ++a)
+                    spec.args.push_back(strings[args[r.firstArg + a]]);
+            }
+
+            // Children come after their parent, so making them never reaches this definition again
+            for (std::uint32_t k = 0; k < r.childCount; ++k)
+            {
+                SMART child = make(r.firstChild + k, message);
+                if (!child)
+                {
+                    spec.children.clear();
+                    return {};
+                }
+                spec.children.push_back(child);
+            }
+            SMART task = factories[s](spec, loader.schema, message);
+            spec.children.clear();
+            if (!task && message.empty())
+                message = "of type '" + spec.type + "' is invalid";
+            return task;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Builds a definition as the loader keeps it for saveCache.
+
+        \param s
+            Index of the definition.
+
+        \return
+            The definition.
+        *******************************************************************************/
+        LeafSpec build(std::uint32_t s) const
+        {
+            const SpecRecord& r = specs[s];
+            LeafSpec out{ strings[r.type], {}, {} };
+            for (std::uint32_t a = 0; a < r.argCount; ++a)
+                out.args.push_back(strings[args[r.firstArg + a]]);
+            for (std::uint32_t k = 0; k < r.childCount; ++k)
+                out.children.push_back(build(r.firstChild + k));
+            return out;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Returns a definition as the loader keeps it for saveCache, built the first time it is asked for.
+
+        \param s
+            Index of the definition.
+
+        \return
+            The definition, shared by every leaf made from it.
+        *******************************************************************************/
+        const std::shared_ptr<const LeafSpec>& definition(std::uint32_t s)
+        {
+            if (!kept[s])
+                kept[s] = std::make_shared<const LeafSpec>(build(s));
+            return kept[s];
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Restores one tree: copies its nodes and policies, makes its labels from the strings, makes its leaves and
+            declares the keys of its blackboard operations.
+
+        \param record
+            Ranges of the tree.
+
+        \param tree
+            Receives the tree.
+
+        \param message
+            Receives the problem on failure, left empty if a range or index is out of its array.
+
+        \return
+            True on success.
+        *******************************************************************************/
+        bool tree(const TreeRecord& record, FlatTree& tree, std::string& message)
+        {
+            const std::uint32_t ranges[][3] = { { Nodes, record.firstNode, record.nodeCount },
+                { Labels, record.firstNode, record.nodeCount }, { Leaves, record.firstLeaf, record.leafCount },
+                { Ops, record.firstOp, record.opCount }, { Aliases, record.firstAlias, record.aliasCount },
+                { Policies, record.firstPolicy, record.policyCount }, { Loops, record.firstLoop, record.loopCount } };
+            for (const auto& range : ranges)
+                if (std::uint64_t{ range[1] } + range[2] > sections[range[0]].count)
+                    return false;
+
+            tree.nodes.resize(record.nodeCount);
+            tree.policies.resize(record.policyCount);
+            tree.loops.resize(record.loopCount);
+            read(Nodes, record.firstNode, record.nodeCount, tree.nodes.data());
+            read(Policies, record.firstPolicy, record.policyCount, tree.policies.data());
+            read(Loops, record.firstLoop, record.loopCount, tree.loops.data());
+
+            tree.labels.reserve(record.nodeCount);
+            for (std::uint32_t i = 0; i < record.nodeCount; ++i)
+            {
+                std::uint32_t label = 0;
+                read(Labels, record.firstNode + i, 1, &label);
+                if (label >= strings.size())
+                    return false;
+                tree.labels.push_back(strings[label]);
+            }
+
+            tree.leaves.reserve(record.leafCount);
+            for (std::uint32_t l = 0; l < record.leafCount; ++l)
+            {
+                std::uint32_t s = 0;
+                read(Leaves, record.firstLeaf + l, 1, &s);
+                if (s >= specs.size())
+                    return false;
+                SMART leaf = make(s, message);
+                if (!leaf)
+                {
+                    message = "cannot make leaf " + message;
+                    return false;
+                }
+                tree.leaves.push_back(leaf);
+                if (strings[specs[s].type] != "Leaf")
+                    loader.leafSpecs[leaf.get()] = definition(s);
+            }
+
+            tree.boardOps.reserve(record.opCount);
+            for (std::uint32_t o = 0; o < record.opCount; ++o)
+            {
+                OpRecord r{};
+                read(Ops, record.firstOp + o, 1, &r);
+                BlackboardOp op;
+                op.key.type = static_cast<ValueType>(r.type);
+                op.compare = static_cast<Compare>(r.compare);
+                op.operand = r.operand;
+                if (r.key != NO_STRING)
+                {
+                    if (r.key >= strings.size() || op.key.type > ValueType::Float)
+                        return false;
+                    BlackboardKey& key = keys[r.key];
+                    if (!key.valid() || key.type != op.key.type)
+                        key = op.key.type == ValueType::Bool ? BlackboardKey(loader.schema.add<bool>(strings[r.key]))
+                            : op.key.type == ValueType::Float ? BlackboardKey(loader.schema.add<float>(strings[r.key]))
+                            : BlackboardKey(loader.schema.add<std::int32_t>(strings[r.key]));
+                    op.key = key;
+                }
+                tree.boardOps.push_back(op);
+            }
+            tree.boards.assign(record.opCount, nullptr);
+
+            tree.aliases.reserve(record.aliasCount);
+            for (std::uint32_t a = 0; a < record.aliasCount; ++a)
+            {
+                AliasRecord r{};
+                read(Aliases, record.firstAlias + a, 1, &r);
+                if (std::uint64_t{ r.first } + r.size > sections[AliasEntries].count)
+                    return false;
+                std::vector<AliasEntry> entries(r.size);
+                read(AliasEntries, r.first, r.size, entries.data());
+                std::vector<float> prob(r.size);
+                std::vector<std::uint32_t> alias(r.size);
+                for (std::uint32_t k = 0; k < r.size; ++k)
+                {
+                    prob[k] = entries[k].prob;
+                    alias[k] = entries[k].alias;
+                }
+                tree.aliases.emplace_back(std::move(prob), std::move(alias));
+            }
+            return true;
+        }
+    };
+
+    /*!*****************************************************************************
+    \brief
+        Creates a loader with the built-in node types registered.
+
+    \param schema
+        Schema that receives the blackboard keys named by the trees.
+    *******************************************************************************/
+    TreeLoader::TreeLoader(BlackboardSchema& schema)
+        : factories{}, schema{ schema }, leafSpecs{}, error{}
+    {
+        factories["Selector"] = makeSelector;
+        factories["Sequence"] = makeSequence;
+        factories["RandomSelector"] = makeRandomSelector;
+        factories["Parallel"] = makeParallel;
+        factories["Inverter"] = makeInverter;
+        factories["Succeeder"] = makeSucceeder;
+        factories["Repeater"] = makeRepeater;
+        factories["Repeat_until_fail"] = makeRepeatUntilFail;
+        factories["CheckState"] = makeCheckState;
+        factories["Condition"] = makeCondition;
+        factories["Assign"] = makeAssign;
+        factories["Leaf"] = makeLeaf;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Registers a node type, replacing any factory of the same name.
+
+    \param type
+        Name of the type in definitions.
+
+    \param factory
+        Function that makes the node.
+    *******************************************************************************/
+    void TreeLoader::registerType(const std::string& type, NodeFactory factory)
+    {
+        factories[type] = factory;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Builds the trees of a text definition in one pass over the text.
+
+    \param text
+        The definition.
+
+    \param trees
+        Receives the root of every tree by name.
+
+    \return
+        True on success.
+    *******************************************************************************/
+    bool TreeLoader::parse(const std::string& text, std::map<std::string, SMART>& trees)
+    {
+        error.clear();
+        Parser parser{ *this, text.data(), text.data() + text.size(), 1 };
+        return parser.file(trees);
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Writes compiled trees to a cache file. The image holds a header (magic, hash of the definition, and the offset
+        and record count of every section) followed by flat arrays of fixed-size records that refer to each other by
+        index: strings, leaf definitions with their arguments and their children's definitions already parsed, trees
+        as ranges of the other arrays, nodes and policies in their memory layout, node labels, leaves, blackboard
+        operations with key names and alias tables. Nothing in the image depends on where it is loaded.
+
+    \param path
+        Path of the cache file.
+
+    \param trees
+        Trees compiled from trees made by this loader, by name.
+
+    \param sourceHash
+        Hash of the definition the trees came from.
+
+    \return
+        True on success.
+    *******************************************************************************/
+    bool TreeLoader::saveCache(const std::string& path, const std::map<std::string, FlatTree>& trees,
+        std::uint64_t sourceHash)
+    {
+        CacheWriter w;
+        for (const auto& entry : trees)
+        {
+            const FlatTree& tree = entry.second;
+            TreeRecord record{ w.string(entry.first),
+                w.counts[Nodes], static_cast<std::uint32_t>(tree.nodes.size()),
+                w.counts[Leaves], static_cast<std::uint32_t>(tree.leaves.size()),
+                w.counts[Ops], static_cast<std::uint32_t>(tree.boardOps.size()),
+                w.counts[Aliases], static_cast<std::uint32_t>(tree.aliases.size()),
+                w.counts[Policies], static_cast<std::uint32_t>(tree.policies.size()),
+                w.counts[Loops], static_cast<std::uint32_t>(tree.loops.size()) };
+
+            for (std::size_t i = 0; i < tree.nodes.size(); ++i)
+            {
+                w.node(tree.nodes[i]);
+                w.add(Labels, w.string(tree.labels[i]));
+            }
+
+            for (const SMART& leaf : tree.leaves)
+            {
+                auto it = leafSpecs.find(leaf.get());
+                w.add(Leaves, w.spec(it != leafSpecs.end() ? *it->second : LeafSpec{ "Leaf", { leaf->getId() }, {} }));
+            }
+
+            for (const BlackboardOp& op : tree.boardOps)
+                w.add(Ops, OpRecord{ op.key.valid() ? w.string(schema.getName(static_cast<std::uint32_t>(op.key.slot)))
+                    : NO_STRING, static_cast<std::uint8_t>(op.key.type), static_cast<std::uint8_t>(op.compare), 0,
+                    op.operand });
+
+            for (const AliasTable& table : tree.aliases)
+            {
+                w.add(Aliases, AliasRecord{ w.counts[AliasEntries], table.size() });
+                for (std::uint32_t k = 0; k < table.size(); ++k)
+                    w.add(AliasEntries, AliasEntry{ table.getProb()[k], table.getAlias()[k] });
+            }
+
+            for (const FlatTree::ParallelPolicy& policy : tree.policies)
+                w.add(Policies, policy);
+            for (const FlatTree::LoopPolicy& loop : tree.loops)
+                w.add(Loops, loop);
+            w.add(Trees, record);
+        }
+
+        std::string image = w.image(sourceHash);
+        std::ofstream file(path, std::ios::binary);
+        file.write(image.data(), static_cast<std::streamsize>(image.size()));
+        if (!file)
+        {
+            error = "cannot write " + path;
+            return false;
+        }
+        return true;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Restores compiled trees from a cache file. The file is mapped into memory in one call and every array is read
+        in one pass: strings are made once, node arrays and policies are copied per tree in one call, leaves are made
+        again by their factories from their stored definitions, each definition resolved to its factory once, and
+        blackboard keys are declared in the schema again by name, once per name, so the slots match the current
+        schema. A tree that fails validate() makes the whole cache a miss.
+
+    \param path
+        Path of the cache file.
+
+    \param trees
+        Receives the compiled trees by name.
+
+    \param sourceHash
+        Expected hash of the definition (0 accepts any).
+
+    \return
+        True on success.
+    *******************************************************************************/
+    bool TreeLoader::loadCache(const std::string& path, std::map<std::string, FlatTree>& trees, std::uint64_t sourceHash)
+    {
+        MappedFile file(path);
+        if (!file.begin())
+        {
+            error = "cannot map " + path;
+            return false;
+        }
+
+        std::size_t size = static_cast<std::size_t>(file.end() - file.begin());
+        if (size < HEADER_SIZE || std::memcmp(file.begin(), CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0)
+        {
+            error = path + " is not a tree cache";
+            return false;
+        }
+        std::uint64_t hash;
+        std::memcpy(&hash, file.begin() + sizeof(CACHE_MAGIC), sizeof(hash));
+        if (sourceHash && hash != sourceHash)
+        {
+            error = path + " is stale";
+            return false;
+        }
+
+        CacheReader reader{ *this, file.begin(), {}, {}, {}, {}, {}, {}, {}, {} };
+        if (!reader.open(size))
+        {
+            error = path + " is damaged";
+            return false;
+        }
+
+        std::map<std::string, FlatTree> loaded;
+        for (std::uint32_t t = 0; t < reader.sections[Trees].count; ++t)
+        {
+            TreeRecord record{};
+            reader.read(Trees, t, 1, &record);
+            std::string message;
+            if (record.name >= reader.strings.size())
+            {
+                error = path + " is damaged";
+                return false;
+            }
+            const std::string& name = reader.strings[record.name];
+            FlatTree& tree = loaded[name];
+            if (!reader.tree(record, tree, message) || !validate(tree))
+            {
+                error = path + ": tree '" + name + "' " + (message.empty() ? "is damaged" : message);
+                return false;
+            }
+        }
+
+        for (auto& entry : loaded)
+            trees[entry.first] = std::move(entry.second);
+        return true;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Loads a definition file through its cache. The cache is keyed by the hash of the definition text, so editing the
+        file makes the next load parse it again and rewrite the cache.
+
+    \param sourcePath
+        Path of the definition file.
+
+    \param cachePath
+        Path of the cache file.
+
+    \param trees
+        Receives the compiled trees by name.
+
+    \return
+        True on success.
+    *******************************************************************************/
+    bool TreeLoader::load(const std::string& sourcePath, const std::string& cachePath,
+        std::map<std::string, FlatTree>& trees)
+    {
+        std::ifstream source(sourcePath, std::ios::binary);
+        if (!source)
+        {
+            error = "cannot read " + sourcePath;
+            return false;
+        }
+        std::ostringstream text;
+        text << source.rdbuf();
+        std::uint64_t hash = hashText(text.str());
+
+        bool cached = loadCache(cachePath, trees, hash);
+        leafSpecs.clear();
+        if (cached)
+            return true;
+
+        std::map<std::string, SMART> roots;
+        if (!parse(text.str(), roots))
+        {
+            leafSpecs.clear();
+            error = sourcePath + ", " + error;
+            return false;
+        }
+        std::map<std::string, FlatTree> compiled;
+        for (const auto& entry : roots)
+            compiled.emplace(entry.first, FlatTree{ entry.second });
+
+        // A cache that cannot be written only costs the next start its parse, but one that was written must restore,
+        // or every start would parse again without a word
+        std::map<std::string, FlatTree> restored;
+        bool restores = !saveCache(cachePath, compiled, hash) || loadCache(cachePath, restored, hash);
+        leafSpecs.clear();
+        if (!restores)
+        {
+            error = "cannot restore the cache of " + sourcePath + ", " + error;
+            return false;
+        }
+        for (auto& entry : compiled)
+            trees[entry.first] = std::move(entry.second);
+        error.clear();
+        return true;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Checks that every opcode of a restored tree is known, every child range lies after its node and inside the node
+        array, and every index stored in a param points into its array: the alias table of a weighted RandomSelector
+        has one column for every child, leaves and blackboard operations exist, and a CheckState result is Success or
+        Failure. Leaves, Condition, Assign and CheckState have no children, decorators at most one.
+
+    \param tree
+        The restored tree.
+
+    \return
+        True if the tree can be run.
+    *******************************************************************************/
+    bool TreeLoader::validate(const FlatTree& tree)
+    {
+        using Op = FlatTree::Op;
+        const std::size_t nodeCount = tree.nodes.size();
+        if (nodeCount == 0 || tree.labels.size() != nodeCount)
+            return false;
+
+        for (std::size_t i = 0; i < nodeCount; ++i)
+        {
+            const FlatTree::FlatNode& n = tree.nodes[i];
+            if (n.op > Op::Leaf)
+                return false;
+            if (n.count && (n.first <= i || n.first + static_cast<std::size_t>(n.count) > nodeCount))
+                return false;
+
+            std::size_t param = static_cast<std::size_t>(n.param);
+            bool inRange = n.param >= 0;
+            switch (n.op)
+            {
+            case Op::Selector:
+            case Op::Sequence:
+                break;
+            case Op::RandomSelector:
+                if (n.param != -1 && !(inRange && param < tree.aliases.size() && tree.aliases[param].size() == n.count))
+                    return false;
+                break;
+            case Op::Parallel:
+                if (!inRange || param >= tree.policies.size() || n.count > Parallel::PARALLEL_MAX)
+                    return false;
+                break;
+            case Op::Inverter:
+            case Op::Succeeder:
+                if (n.count > 1)
+                    return false;
+                break;
+            case Op::Repeater:
+            case Op::Repeat_until_fail:
+                if (n.count > 1 || !inRange || param >= tree.loops.size())
+                    return false;
+                break;
+            case Op::CheckState:
+                if (n.count || (n.param != State::Success && n.param != State::Failure))
+                    return false;
+                break;
+            case Op::Condition:
+            case Op::Assign:
+                if (n.count || !inRange || param >= tree.boardOps.size())
+                    return false;
+                break;
+            case Op::Leaf:
+            default:
+                if (n.count || !inRange || param >= tree.leaves.size())
+                    return false;
+                break;
+            }
+        }
+
+        for (const AliasTable& table : tree.aliases)
+        {
+            if (table.size() == 0)
+                return false;
+            for (std::uint32_t alias : table.getAlias())
+                if (alias >= table.size())
+                    return false;
+        }
+        for (const BlackboardOp& op : tree.boardOps)
+            if (op.key.type > ValueType::Float || op.compare > Compare::GreaterEqual)
+                return false;
+        return true;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Computes the 64-bit FNV-1a hash of a text. A hash of 0 means "any" to loadCache, so it is mapped to 1.
+
+    \param text
+        The text.
+
+    \return
+        The hash.
+    *******************************************************************************/
+    std::uint64_t hashText(const std::string& text)
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (unsigned char c : text)
+            hash = (hash ^ c) * 1099511628211ull;
+        return hash ? hash : 1;
+    }
+} // end namespace
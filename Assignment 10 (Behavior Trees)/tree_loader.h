@@ -0,0 +1,224 @@
+/*!*****************************************************************************
+\file       tree_loader.h
+\author     Jie Le Jet Ang
+\par        DP email: jielejet.ang@digipen.edu.sg
+\par        Course: CS3183
+\par        Section: A
+\par        Programming Assignment 10
+\date       10-18-2026
+
+\brief
+	Declares TreeLoader, which reads behavior trees from a text definition
+	file instead of C++ initializer lists, so trees can change without a
+	rebuild. Every node is made by a factory registered under its type name;
+	the built-in nodes are registered up front and games can add their own.
+	Compiled trees are cached in a binary file of flat record arrays, which is
+	mapped into memory in one call and restored in one pass without parsing.
+	A definition looks like
+
+		# Comments run to the end of the line
+		tree guard = Selector {
+			Sequence { Condition(health < 30) Assign(fleeing = true) flee }
+			RandomSelector(1, 3) { idle "look around" }
+			Repeater(3) { patrol }
+			Repeat_until_fail(4, 200) { search }
+		}
+
+	The optional arguments of Repeater after its count, and of
+	Repeat_until_fail, are the runs and microseconds the loop may take per
+	tick before it returns Running and goes on next tick.
+	A bare name that is not a node type, or a quoted string, is a leaf task
+	with that id, ready to be bound to an action by BehaviorTree.
+*******************************************************************************/
+#ifndef TREE_LOADER_H
+#define TREE_LOADER_H
+
+#include <vector>
+#include <memory>
+#include <map>
+#include <unordered_map>
+#include <string>
+#include <cstdint>
+#include "flat_tree.h"
+
+namespace AI
+{
+	// A node definition read from text
+	struct NodeSpec
+	{
+		std::string type;				// Node type, "Leaf" for a plain leaf task
+		std::vector<std::string> args;	// Arguments between the parentheses, trimmed
+		std::vector<SMART> children;	// Children between the braces, already built
+	};
+
+	// Makes a node from its definition
+	//     Keys named by the node are declared in the schema. On an invalid
+	//     definition the factory returns an empty pointer and sets error.
+	using NodeFactory = SMART(*)(const NodeSpec& spec, BlackboardSchema& schema, std::string& error);
+
+	// Loader of text tree definitions with a compiled binary cache
+	class TreeLoader
+	{
+		// Definition of a node that compiles to a leaf, with the definitions of its children, as written to the cache
+		struct LeafSpec
+		{
+			std::string type;				// Node type
+			std::vector<std::string> args;	// Arguments between the parentheses
+			std::vector<LeafSpec> children;	// Definitions of the children between the braces
+		};
+
+		std::map<std::string, NodeFactory> factories;
+		BlackboardSchema& schema;
+		// Definition of every leaf made but plain ones, to cache it; leaves made from one definition share it
+		std::unordered_map<const Task*, std::shared_ptr<const LeafSpec>> leafSpecs;
+		std::string error;
+
+		struct Parser;
+		struct CacheWriter;
+		struct CacheReader;
+
+		/*!*****************************************************************************
+		\brief
+			Checks that every opcode of a restored tree is known and every child
+			range and index points into its arrays.
+
+		\param tree
+			The restored tree.
+
+		\return
+			True if the tree can be run.
+		*******************************************************************************/
+		static bool validate(const FlatTree& tree);
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Creates a loader with the built-in node types registered: Selector,
+			Sequence, RandomSelector, Parallel, Inverter, Succeeder, Repeater,
+			Repeat_until_fail, CheckState, Condition, Assign and Leaf.
+
+		\param schema
+			Schema that receives the blackboard keys named by the trees; must
+			outlive the loader.
+		*******************************************************************************/
+		explicit TreeLoader(BlackboardSchema& schema);
+
+		/*!*****************************************************************************
+		\brief
+			Registers a node type, replacing any factory of the same name.
+
+		\param type
+			Name of the type in definitions.
+
+		\param factory
+			Function that makes the node.
+		*******************************************************************************/
+		void registerType(const std::string& type, NodeFactory factory);
+
+		/*!*****************************************************************************
+		\brief
+			Builds the trees of a text definition. The definitions of the nodes
+			that compile to leaves are kept for saveCache until the next load.
+
+		\param text
+			The definition.
+
+		\param trees
+			Receives the root of every tree by name.
+
+		\return
+			True on success; otherwise getError() tells the line and the problem.
+		*******************************************************************************/
+		bool parse(const std::string& text, std::map<std::string, SMART>& trees);
+
+		/*!*****************************************************************************
+		\brief
+			Writes compiled trees to a cache file.
+
+		\param path
+			Path of the cache file.
+
+		\param trees
+			Trees compiled from trees made by this loader, by name.
+
+		\param sourceHash
+			Hash of the definition the trees came from, checked by loadCache.
+
+		\return
+			True on success.
+		*******************************************************************************/
+		bool saveCache(const std::string& path, const std::map<std::string, FlatTree>& trees,
+			std::uint64_t sourceHash = 0);
+
+		/*!*****************************************************************************
+		\brief
+			Restores compiled trees from a cache file mapped into memory. Node
+			arrays and policies are copied as they are, leaves are made again by
+			their factories from their stored definitions and blackboard keys are
+			declared in the schema again by name.
+
+		\param path
+			Path of the cache file.
+
+		\param trees
+			Receives the compiled trees by name.
+
+		\param sourceHash
+			Expected hash of the definition (0 accepts any).
+
+		\return
+			True on success; false if the file is missing, stale or damaged, or a
+			restored tree has a child range or index outside its arrays.
+		*******************************************************************************/
+		bool loadCache(const std::string& path, std::map<std::string, FlatTree>& trees, std::uint64_t sourceHash = 0);
+
+		/*!*****************************************************************************
+		\brief
+			Loads a definition file through its cache: the cache is used if it was
+			made from the same text, otherwise the text is parsed and the cache is
+			written again and restored once, so a node its factory cannot make
+			again from the cache is reported now rather than parsed on every start.
+
+		\param sourcePath
+			Path of the definition file.
+
+		\param cachePath
+			Path of the cache file.
+
+		\param trees
+			Receives the compiled trees by name.
+
+		\return
+			True on success; otherwise getError() tells the problem.
+		*******************************************************************************/
+		bool load(const std::string& sourcePath, const std::string& cachePath, std::map<std::string, FlatTree>& trees);
+
+		/*!*****************************************************************************
+		\brief
+			Returns the message of the last failure.
+
+		\return
+			Reference to the message.
+		*******************************************************************************/
+		const std::string& getError() const
+		{
+			return error;
+		}
+	};
+
+	/*!*****************************************************************************
+	\brief
+		Computes the 64-bit FNV-1a hash of a text, used to tell if a cache is
+		stale.
+
+	\param text
+		The text.
+
+	\return
+		The hash.
+	*******************************************************************************/
+	std::uint64_t hashText(const std::string& text);
+
+} // end namespace
+
+#endif
@@ -0,0 +1,366 @@
+/*!*****************************************************************************
+\file      batch_module.cpp
+\author    Jie Le Jet Ang
+\par       DP email: jielejet.ang@digipen.edu.sg
+\par       Course: CS3183
+\par       Section: A
+\par       Programming Assignment 11
+\date      10-18-2026
+
+\brief
+    Implements BatchFuzzyModule. Every step is a loop over the LANES agents of
+    a chunk whose branches are written as selects, with the same comparisons
+    and float operations as the scalar module, so the loops vectorize and
+    every lane matches the scalar result bit for bit.
+*******************************************************************************/
+#include "batch_module.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace AI
+{
+    namespace
+    {
+        const std::uint32_t LANES = BatchFuzzyModule::LANES;
+
+        /*!*****************************************************************************
+        \brief
+            Picks one of two values by masking their bits. A ?: on computed floats
+            stays a branch when floating-point traps are honoured, which stops the
+            loop from vectorizing; the mask does not.
+        \param condition
+            Which value to pick.
+        \param a
+            Value if the condition holds.
+        \param b
+            Value otherwise.
+        \return
+            a or b, bit for bit.
+        *******************************************************************************/
+        inline float pick(bool condition, float a, float b)
+        {
+            std::uint32_t ia, ib;
+            std::memcpy(&ia, &a, sizeof(float));
+            std::memcpy(&ib, &b, sizeof(float));
+            std::uint32_t mask = 0u - static_cast<std::uint32_t>(condition);
+            std::uint32_t bits = (ia & mask) | (ib & ~mask);
+            float result;
+            std::memcpy(&result, &bits, sizeof(float));
+            return result;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            isEqual without branches, for use inside lane loops; std::min and
+            std::max pick like the ?: above.
+        \param a
+            First value to compare.
+        \param b
+            Second value to compare.
+        \return
+            True if the values are equal within floating-point precision.
+        *******************************************************************************/
+        inline bool isEqualLane(float a, float b)
+        {
+            const float most = std::numeric_limits<float>::max();
+            float diff = std::fabs(a - b);
+            float sum = std::fabs(a) + std::fabs(b);
+            float norm = pick(most < sum, most, sum);
+            float threshold = 128 * FLT_EPSILON * norm;
+            return (a == b) | (diff < pick(FLT_MIN < threshold, threshold, FLT_MIN));
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Calculates the membership of LANES values in one set.
+        \param set
+            The set.
+        \param x
+            The values.
+        \param dom
+            Receives the memberships.
+        *******************************************************************************/
+        void calculateDOMs(const FlatFuzzyModule::FlatSet& set, const float* __restrict x, float* __restrict dom)
+        {
+            const float peak = set.peak, leftEdge = set.leftEdge, rightEdge = set.rightEdge;
+            const float rise = set.rise, fall = set.fall;
+            switch (set.shape)
+            {
+            case FuzzyShape::LeftShoulder:
+                for (std::uint32_t k = 0; k < LANES; ++k)
+                {
+                    float v = x[k];
+                    float r = pick((v >= peak) & (v < rightEdge), fall * (v - peak) + 1.0f, 0.0f);
+                    dom[k] = pick((v < peak) & (v >= leftEdge), 1.0f, r);
+                }
+                break;
+
+            case FuzzyShape::RightShoulder:
+                for (std::uint32_t k = 0; k < LANES; ++k)
+                {
+                    float v = x[k];
+                    float r = pick((v > peak) & (v <= rightEdge), 1.0f, 0.0f);
+                    dom[k] = pick((v <= peak) & (v > leftEdge), rise * (v - leftEdge), r);
+                }
+                break;
+
+            case FuzzyShape::Singleton:
+                for (std::uint32_t k = 0; k < LANES; ++k)
+                    dom[k] = pick((x[k] >= leftEdge) & (x[k] <= rightEdge), 1.0f, 0.0f);
+                return;
+
+            case FuzzyShape::Triangle:
+                for (std::uint32_t k = 0; k < LANES; ++k)
+                {
+                    float v = x[k];
+                    float r = pick((v > peak) & (v < rightEdge), fall * (v - peak) + 1.0f, 0.0f);
+                    dom[k] = pick((v <= peak) & (v >= leftEdge), rise * (v - leftEdge), r);
+                }
+                break;
+
+            default:
+                std::fill(dom, dom + LANES, 0.0f);
+                return;
+            }
+
+            if (set.degenerate)
+                for (std::uint32_t k = 0; k < LANES; ++k)
+                    dom[k] = pick(isEqualLane(peak, x[k]), 1.0f, dom[k]);
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Prepares the batch evaluation of a module. The centroid samples the same points for every agent, so the
+        membership of every sample point in every set is computed once here, with the scalar calculateDOM.
+    \param module
+        The compiled module.
+    *******************************************************************************/
+    BatchFuzzyModule::BatchFuzzyModule(const FlatFuzzyModule& module)
+        : module{ module }, doms(module.getSets().size() * LANES), sampleDOMs{}, sampleFirst{}, sampleX{},
+        clipped{}, decisions{ 0 }, nanoseconds{ 0 }
+    {
+        int numSamples = module.getNumSamples();
+        for (const FlatFuzzyModule::FlatVariable& v : module.getVariables())
+        {
+            sampleFirst.push_back(static_cast<std::uint32_t>(sampleDOMs.size()));
+            clipped.resize(std::max<std::size_t>(clipped.size(), v.count));
+            float stepSize = (v.maxRange - v.minRange) / numSamples;
+            for (int samp = 1; samp <= numSamples; ++samp)
+            {
+                float x = v.minRange + samp * stepSize;
+                sampleX.push_back(x);
+                for (std::uint32_t s = v.first; s < v.first + v.count; ++s)
+                    sampleDOMs.push_back(calculateDOM(module.getSets()[s], x));
+            }
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Fuzzifies one input variable for a chunk.
+    \param variable
+        Index of the variable.
+    \param x
+        Inputs of the chunk's LANES agents.
+    *******************************************************************************/
+    void BatchFuzzyModule::fuzzify(std::uint32_t variable, const float* x)
+    {
+        const FlatFuzzyModule::FlatVariable& v = module.getVariables()[variable];
+        for (std::uint32_t s = v.first; s < v.first + v.count; ++s)
+            calculateDOMs(module.getSets()[s], x, &doms[s * LANES]);
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Fires every rule for a chunk, in the order of FlatFuzzyModule::fire. The antecedent of a rule is reduced for
+        all lanes before its consequent is updated, so a rule whose consequent is also one of its terms sees the
+        consequent's old DOM, as in the scalar module.
+    *******************************************************************************/
+    void BatchFuzzyModule::fire()
+    {
+        const std::vector<FlatFuzzyModule::FlatRule>& rules = module.getRules();
+        const std::uint32_t* terms = module.getTerms().data();
+
+        for (const FlatFuzzyModule::FlatRule& rule : rules)
+            std::fill_n(&doms[rule.consequent * LANES], LANES, 0.0f);
+
+        for (const FlatFuzzyModule::FlatRule& rule : rules)
+        {
+            float acc[LANES];
+            float* out = &doms[rule.consequent * LANES];
+            if (rule.logic == FuzzyLogic::AND)
+            {
+                const float none = std::numeric_limits<float>::max();
+                std::fill_n(acc, LANES, none);
+                for (std::uint32_t t = rule.first; t < rule.first + rule.count; ++t)
+                {
+                    const float* d = &doms[terms[t] * LANES];
+                    for (std::uint32_t k = 0; k < LANES; ++k)
+                        acc[k] = d[k] < acc[k] ? d[k] : acc[k];
+                }
+                for (std::uint32_t k = 0; k < LANES; ++k)
+                    acc[k] = pick(acc[k] == none, 0.0f, acc[k]);
+            }
+            else if (rule.logic == FuzzyLogic::OR)
+            {
+                const float none = std::numeric_limits<float>::lowest();
+                std::fill_n(acc, LANES, none);
+                for (std::uint32_t t = rule.first; t < rule.first + rule.count; ++t)
+                {
+                    const float* d = &doms[terms[t] * LANES];
+                    for (std::uint32_t k = 0; k < LANES; ++k)
+                        acc[k] = d[k] > acc[k] ? d[k] : acc[k];
+                }
+                for (std::uint32_t k = 0; k < LANES; ++k)
+                    acc[k] = pick(acc[k] == none, 0.0f, acc[k]);
+            }
+            else
+                std::fill_n(acc, LANES, 0.0f);
+
+            for (std::uint32_t k = 0; k < LANES; ++k)
+                out[k] = acc[k] > out[k] ? acc[k] : out[k];
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Defuzzifies a variable for a chunk. Sums run in the same order as the scalar module for every lane; the
+        division of lanes with no area is computed and then discarded. The exact centroid sorts breakpoints that
+        differ from lane to lane, so it runs lane by lane.
+    \param variable
+        Index of the variable.
+    \param method
+        Defuzzification method to use.
+    \param out
+        Receives the crisp outputs of the chunk's LANES agents.
+    *******************************************************************************/
+    void BatchFuzzyModule::deFuzzify(std::uint32_t variable, FuzzyModule::DefuzzifyMethod method, float* out)
+    {
+        const FlatFuzzyModule::FlatVariable& v = module.getVariables()[variable];
+        float numerator[LANES] = {}, denominator[LANES] = {};
+
+        if (method == FuzzyModule::max_av)
+        {
+            for (std::uint32_t s = v.first; s < v.first + v.count; ++s)
+            {
+                const float representative = module.getSets()[s].representative;
+                const float* d = &doms[s * LANES];
+                for (std::uint32_t k = 0; k < LANES; ++k)
+                {
+                    numerator[k] += representative * d[k];
+                    denominator[k] += d[k];
+                }
+            }
+        }
+        else if (method == FuzzyModule::centroid)
+        {
+            const std::uint32_t numSamples = static_cast<std::uint32_t>(module.getNumSamples());
+            const float* sample = sampleDOMs.data() + sampleFirst[variable];
+            for (std::uint32_t samp = 0; samp < numSamples; ++samp)
+            {
+                const float x = sampleX[variable * numSamples + samp];
+                for (std::uint32_t s = v.first; s < v.first + v.count; ++s, ++sample)
+                {
+                    const float m = *sample;
+                    const float* d = &doms[s * LANES];
+                    for (std::uint32_t k = 0; k < LANES; ++k)
+                    {
+                        float contribution = d[k] < m ? d[k] : m;
+                        denominator[k] += contribution;
+                        numerator[k] += x * contribution;
+                    }
+                }
+            }
+        }
+
+        else if (method == FuzzyModule::exact_centroid)
+        {
+            for (std::uint32_t k = 0; k < LANES; ++k)
+            {
+                for (std::uint32_t s = 0; s < v.count; ++s)
+                    clipped[s] = clip(module.getSets()[v.first + s], doms[(v.first + s) * LANES + k]);
+                out[k] = exactCentroid(clipped.data(), v.count, v.minRange, v.maxRange);
+            }
+            return;
+        }
+
+        for (std::uint32_t k = 0; k < LANES; ++k)
+        {
+            float crisp = numerator[k] / denominator[k];
+            out[k] = pick(isEqualLane(0.0f, denominator[k]), 0.0f, crisp);
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Evaluates the module for a batch of agents. Sets that are neither inputs nor consequents are never written,
+        so the frozen DOMs are copied into every lane once per call. A last chunk with fewer than LANES agents is
+        padded with copies of its first agent.
+    \param frozen
+        Context holding the DOMs of the sets outside the inputs.
+    \param inputs
+        Crisp values of every input variable.
+    \param count
+        Number of agents.
+    \param output
+        Index of the variable to defuzzify.
+    \param method
+        Defuzzification method to use.
+    \param results
+        Receives the crisp output of every agent.
+    *******************************************************************************/
+    void BatchFuzzyModule::deFuzzify(const FuzzyContext& frozen, const std::vector<FuzzyInput>& inputs,
+        std::size_t count, std::uint32_t output, FuzzyModule::DefuzzifyMethod method, float* results)
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        for (std::uint32_t s = 0; s < module.getSets().size(); ++s)
+            std::fill_n(&doms[s * LANES], LANES, frozen.getDOM(s));
+
+        for (std::size_t base = 0; base < count; base += LANES)
+        {
+            std::size_t n = std::min<std::size_t>(LANES, count - base);
+            for (const FuzzyInput& input : inputs)
+            {
+                float x[LANES];
+                for (std::uint32_t k = 0; k < LANES; ++k)
+                    x[k] = input.values[base + (k < n ? k : 0)];
+                fuzzify(input.variable, x);
+            }
+            fire();
+
+            float out[LANES];
+            deFuzzify(output, method, out);
+            std::copy_n(out, n, results + base);
+        }
+
+        decisions += count;
+        nanoseconds += static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Returns the throughput of the batch.
+    \return
+        Agent decisions per second since the last resetStats, 0 before the first.
+    *******************************************************************************/
+    double BatchFuzzyModule::getDecisionsPerSecond() const
+    {
+        return nanoseconds ? decisions * 1e9 / static_cast<double>(nanoseconds) : 0.0;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Sets the decision count and time back to 0.
+    *******************************************************************************/
+    void BatchFuzzyModule::resetStats()
+    {
+        decisions = 0;
+        nanoseconds = 0;
+    }
+} // end namespace
@@ -0,0 +1,131 @@
+/*!*****************************************************************************
+\file      batch_module.h
+\author    Jie Le Jet Ang
+\par       DP email: jielejet.ang@digipen.edu.sg
+\par       Course: CS3183
+\par       Section: A
+\par       Programming Assignment 11
+\date      10-18-2026
+
+\brief
+	Declares BatchFuzzyModule, which evaluates one shared FlatFuzzyModule for
+	many agents at once. Crisp inputs come in as one array per input variable,
+	and agents are processed in chunks of LANES. Fuzzification, rule firing
+	and defuzzification are loops across the agents of a chunk without
+	branches, which the compiler turns into SIMD instructions. Every agent
+	gets the same crisp output as the scalar module.
+*******************************************************************************/
+#ifndef BATCH_MODULE_H
+#define BATCH_MODULE_H
+
+#include <vector>
+#include <cstdint>
+#include "flat_module.h"
+
+namespace AI
+{
+	// Crisp values of one input variable for every agent of a batch
+	struct FuzzyInput
+	{
+		std::uint32_t variable;		// Index of the variable in the module
+		const float* values;		// values[a] is the input of agent a
+	};
+
+	// Batch evaluation of a FlatFuzzyModule
+	//     The module is only read, so several batches, one per thread, can
+	//     share it. A batch keeps the DOMs of one chunk of agents, set by set:
+	//     the DOM of set s for lane k is doms[s * LANES + k].
+	class BatchFuzzyModule
+	{
+	public:
+		static const std::uint32_t LANES = 16;	// Agents evaluated together
+
+	private:
+		const FlatFuzzyModule& module;
+		std::vector<float> doms;				// DOMs of the chunk being evaluated
+		std::vector<float> sampleDOMs;			// Membership of every centroid sample point in every set
+		std::vector<std::uint32_t> sampleFirst;	// Index of every variable's first sample in sampleDOMs
+		std::vector<float> sampleX;				// Sample x of variable v is sampleX[v * numSamples + samp]
+		std::vector<ClippedSet> clipped;		// Sets of one lane for exact centroid defuzzification
+		std::uint64_t decisions;				// Agents evaluated since the last resetStats
+		std::uint64_t nanoseconds;				// Time spent evaluating them
+
+		/*!*****************************************************************************
+		\brief
+			Fuzzifies one input variable for a chunk.
+		\param variable
+			Index of the variable.
+		\param x
+			Inputs of the chunk's LANES agents.
+		*******************************************************************************/
+		void fuzzify(std::uint32_t variable, const float* x);
+
+		/*!*****************************************************************************
+		\brief
+			Fires every rule for a chunk.
+		*******************************************************************************/
+		void fire();
+
+		/*!*****************************************************************************
+		\brief
+			Defuzzifies a variable for a chunk.
+		\param variable
+			Index of the variable.
+		\param method
+			Defuzzification method to use.
+		\param out
+			Receives the crisp outputs of the chunk's LANES agents.
+		*******************************************************************************/
+		void deFuzzify(std::uint32_t variable, FuzzyModule::DefuzzifyMethod method, float* out);
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Prepares the batch evaluation of a module.
+		\param module
+			The compiled module; must outlive the batch.
+		*******************************************************************************/
+		explicit BatchFuzzyModule(const FlatFuzzyModule& module);
+
+		/*!*****************************************************************************
+		\brief
+			Evaluates the module for a batch of agents: every agent's inputs are
+			fuzzified, the rules fired and the output variable defuzzified, as
+			with fuzzify and deFuzzify on the scalar module. Sets of variables
+			that are not inputs keep the DOM they have in the frozen context.
+		\param frozen
+			Context holding the DOMs of the sets outside the inputs, such as
+				the module's getContext().
+		\param inputs
+			Crisp values of every input variable.
+		\param count
+			Number of agents.
+		\param output
+			Index of the variable to defuzzify.
+		\param method
+			Defuzzification method to use.
+		\param results
+			Receives the crisp output of every agent (count values).
+		*******************************************************************************/
+		void deFuzzify(const FuzzyContext& frozen, const std::vector<FuzzyInput>& inputs, std::size_t count,
+			std::uint32_t output, FuzzyModule::DefuzzifyMethod method, float* results);
+
+		/*!*****************************************************************************
+		\brief
+			Returns the throughput of the batch.
+		\return
+			Agent decisions per second over every call since the last resetStats,
+			0 before the first.
+		*******************************************************************************/
+		double getDecisionsPerSecond() const;
+
+		/*!*****************************************************************************
+		\brief
+			Sets the decision count and time back to 0.
+		*******************************************************************************/
+		void resetStats();
+	};
+
+} // end namespace
+
+#endif
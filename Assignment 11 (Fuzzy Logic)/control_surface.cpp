@@ -0,0 +1,426 @@
+/*!*****************************************************************************
+\file      control_surface.cpp
+\author    Jie Le Jet Ang
+\par       DP email: jielejet.ang@digipen.edu.sg
+\par       Course: CS3183
+\par       Section: A
+\par       Programming Assignment 11
+\date      10-18-2026
+
+\brief
+    Implements ControlSurface: tabulating a module, measuring the error of the
+    table, interpolating it and its cache file.
+*******************************************************************************/
+#include "control_surface.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace AI
+{
+    namespace
+    {
+        const char MAGIC[4] = { 'F', 'C', 'S', '1' };
+
+        /*!*****************************************************************************
+        \brief
+            Writes a binary value to a stream.
+        \param os
+            The stream.
+        \param value
+            The value.
+        *******************************************************************************/
+        template<typename T>
+        void put(std::ostream& os, T value)
+        {
+            os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Reads a binary value from a buffer and moves past it.
+        \param p
+            Read position.
+        \param end
+            End of the buffer.
+        \param value
+            Receives the value.
+        \return
+            True if the buffer held the whole value.
+        *******************************************************************************/
+        template<typename T>
+        bool get(const char*& p, const char* end, T& value)
+        {
+            if (static_cast<std::size_t>(end - p) < sizeof(T))
+                return false;
+            std::memcpy(&value, p, sizeof(T));
+            p += sizeof(T);
+            return true;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Adds a value to an FNV-1a hash.
+        \param hash
+            The hash.
+        \param value
+            The value.
+        *******************************************************************************/
+        void hashValue(std::uint64_t& hash, std::uint64_t value)
+        {
+            for (int i = 0; i < 8; ++i, value >>= 8)
+                hash = (hash ^ (value & 0xFF)) * 1099511628211ull;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Converts an input to its position along the grid, clamped to the range. NaN fails every comparison and
+            is taken as the low end of the range, so the position is always a valid cell.
+        \param x
+            Crisp input.
+        \param minRange
+            Low end of the input's range.
+        \param maxRange
+            High end of the input's range.
+        \param scale
+            Cells per unit of the input.
+        \return
+            Position in cells, from 0 to the resolution.
+        *******************************************************************************/
+        float position(float x, float minRange, float maxRange, float scale)
+        {
+            float clamped = x > minRange ? std::min(x, maxRange) : minRange;
+            return (clamped - minRange) * scale;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Evaluates a module at one input point.
+        \param module
+            The module.
+        \param context
+            DOMs of the evaluation, which are overwritten.
+        \param inputs
+            Indices of the input variables.
+        \param point
+            Crisp value of every input.
+        \param output
+            Index of the output variable.
+        \param method
+            Defuzzification method.
+        \return
+            Crisp output.
+        *******************************************************************************/
+        float evaluate(const FlatFuzzyModule& module, FuzzyContext& context, const std::vector<std::uint32_t>& inputs,
+            const float* point, std::uint32_t output, FuzzyModule::DefuzzifyMethod method)
+        {
+            for (std::size_t d = 0; d < inputs.size(); ++d)
+                module.fuzzify(context, inputs[d], point[d]);
+            return module.deFuzzify(context, output, method);
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Creates an empty table.
+    *******************************************************************************/
+    ControlSurface::ControlSurface()
+        : dimensions{ 0 }, resolution{ 0 }, minRange{}, maxRange{}, scale{}, maxError{ 0.0f }, key{ 0 }, values{}
+    {
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Computes the key of a table from the rule base hash, the frozen DOMs of every set outside the inputs and the
+        settings. The table is evaluated from the frozen context and only the inputs are fuzzified, so the DOMs of the
+        other variables are frozen into it; consequents are cleared when the rules fire, but hashing them too only
+        costs a rebuild, never a stale table.
+    \param module
+        The compiled module.
+    \param frozen
+        Context holding the DOMs of the sets outside the inputs.
+    \param inputs
+        Indices of the input variables.
+    \param output
+        Index of the output variable.
+    \param method
+        Defuzzification method.
+    \param resolution
+        Cells along every input.
+    \return
+        The key, never 0.
+    *******************************************************************************/
+    std::uint64_t ControlSurface::makeKey(const FlatFuzzyModule& module, const FuzzyContext& frozen,
+        const std::vector<std::uint32_t>& inputs, std::uint32_t output, FuzzyModule::DefuzzifyMethod method,
+        std::uint32_t resolution)
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+        hashValue(hash, module.getHash());
+        const std::vector<FlatFuzzyModule::FlatVariable>& variables = module.getVariables();
+        for (std::uint32_t v = 0; v < variables.size(); ++v)
+            if (std::find(inputs.begin(), inputs.end(), v) == inputs.end())
+                for (std::uint32_t s = variables[v].first; s < variables[v].first + variables[v].count; ++s)
+                {
+                    float dom = frozen.getDOM(s);
+                    std::uint32_t bits = 0;
+                    std::memcpy(&bits, &dom, sizeof(bits));
+                    hashValue(hash, bits);
+                }
+        hashValue(hash, inputs.size());
+        for (std::uint32_t input : inputs)
+            hashValue(hash, input);
+        hashValue(hash, output);
+        hashValue(hash, static_cast<std::uint64_t>(method));
+        hashValue(hash, resolution);
+        return hash ? hash : 1;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Tabulates the output of a module at every grid node. The error is then measured on a grid of check points:
+        along every input, checks points strictly inside every cell, where the interpolation is furthest from the
+        nodes it was made from, and the edges and peaks of the input's sets, where the surface bends. It is a measured
+        bound, so a bend between the checked points, such as where two rules take over from each other, can stray
+        further.
+    \param module
+        The compiled module.
+    \param frozen
+        Context holding the DOMs of the sets outside the inputs; the table evaluates in a copy.
+    \param inputs
+        Indices of the one or two input variables.
+    \param output
+        Index of the output variable.
+    \param method
+        Defuzzification method.
+    \param resolution
+        Cells along every input.
+    \param checks
+        Points checked along every input inside every cell.
+    \return
+        True on success.
+    *******************************************************************************/
+    bool ControlSurface::build(const FlatFuzzyModule& module, const FuzzyContext& frozen,
+        const std::vector<std::uint32_t>& inputs, std::uint32_t output, FuzzyModule::DefuzzifyMethod method,
+        std::uint32_t resolution, std::uint32_t checks)
+    {
+        std::size_t variableCount = module.getVariables().size();
+        if (inputs.empty() || inputs.size() > 2 || resolution == 0 || output >= variableCount)
+            return false;
+        for (std::uint32_t input : inputs)
+            if (input >= variableCount)
+                return false;
+
+        FuzzyContext context{ frozen };
+        dimensions = static_cast<std::uint32_t>(inputs.size());
+        this->resolution = resolution;
+        for (std::uint32_t d = 0; d < 2; ++d)
+        {
+            const FlatFuzzyModule::FlatVariable& v = module.getVariables()[inputs[d < dimensions ? d : 0]];
+            minRange[d] = d < dimensions ? v.minRange : 0.0f;
+            maxRange[d] = d < dimensions ? v.maxRange : 0.0f;
+            scale[d] = maxRange[d] > minRange[d] ? resolution / (maxRange[d] - minRange[d]) : 0.0f;
+        }
+        key = makeKey(module, frozen, inputs, output, method, resolution);
+
+        std::uint32_t nodes = resolution + 1;
+        std::uint32_t rows = dimensions == 2 ? nodes : 1;
+        values.assign(static_cast<std::size_t>(nodes) * rows, 0.0f);
+        for (std::uint32_t j = 0; j < rows; ++j)
+            for (std::uint32_t i = 0; i < nodes; ++i)
+            {
+                float point[2] = { minRange[0] + (maxRange[0] - minRange[0]) * i / resolution,
+                    minRange[1] + (maxRange[1] - minRange[1]) * j / resolution };
+                values[static_cast<std::size_t>(j) * nodes + i] = evaluate(module, context, inputs, point, output, method);
+            }
+
+        std::vector<float> along[2];
+        for (std::uint32_t d = 0; d < dimensions; ++d)
+        {
+            for (std::uint32_t i = 0; i < resolution; ++i)
+                for (std::uint32_t a = 0; a < checks; ++a)
+                    along[d].push_back(minRange[d] + (maxRange[d] - minRange[d]) * (i + (a + 1.0f) / (checks + 1)) / resolution);
+
+            const FlatFuzzyModule::FlatVariable& v = module.getVariables()[inputs[d]];
+            for (std::uint32_t s = v.first; s < v.first + v.count; ++s)
+                for (float x : { module.getSets()[s].leftEdge, module.getSets()[s].peak, module.getSets()[s].rightEdge })
+                    if (x > minRange[d] && x < maxRange[d])
+                        along[d].push_back(x);
+        }
+        if (dimensions == 1)
+            along[1].push_back(0.0f);
+
+        maxError = 0.0f;
+        for (float y : along[1])
+            for (float x : along[0])
+            {
+                float point[2] = { x, y };
+                float exact = evaluate(module, context, inputs, point, output, method);
+                float table = dimensions == 2 ? (*this)(x, y) : (*this)(x);
+                maxError = std::max(maxError, std::fabs(exact - table));
+            }
+        return true;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Writes the table to a cache file: magic, key, dimensions, resolution, the range of both inputs, the error
+        bound, the value count and the values as they are in memory.
+    \param path
+        Path of the cache file.
+    \return
+        True on success.
+    *******************************************************************************/
+    bool ControlSurface::saveCache(const std::string& path) const
+    {
+        std::ofstream file(path, std::ios::binary);
+        if (!file)
+            return false;
+
+        file.write(MAGIC, sizeof(MAGIC));
+        put(file, key);
+        put(file, dimensions);
+        put(file, resolution);
+        for (int d = 0; d < 2; ++d)
+        {
+            put(file, minRange[d]);
+            put(file, maxRange[d]);
+        }
+        put(file, maxError);
+        put(file, static_cast<std::uint32_t>(values.size()));
+        file.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(float)));
+        return static_cast<bool>(file);
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Reads a table from a cache file. The file is read whole and checked before the table is changed, so a failed
+        load leaves the table as it was.
+    \param path
+        Path of the cache file.
+    \param expected
+        Key the table must have (0 accepts any).
+    \return
+        True on success.
+    *******************************************************************************/
+    bool ControlSurface::loadCache(const std::string& path, std::uint64_t expected)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return false;
+        std::string data{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+        const char* p = data.data();
+        const char* end = p + data.size();
+
+        if (data.size() < sizeof(MAGIC) || std::memcmp(p, MAGIC, sizeof(MAGIC)) != 0)
+            return false;
+        p += sizeof(MAGIC);
+
+        std::uint64_t fileKey = 0;
+        std::uint32_t fileDimensions = 0, fileResolution = 0, count = 0;
+        float ranges[4] = {}, error = 0.0f;
+        if (!get(p, end, fileKey) || (expected && fileKey != expected) || !get(p, end, fileDimensions)
+            || !get(p, end, fileResolution) || fileDimensions < 1 || fileDimensions > 2 || fileResolution == 0)
+            return false;
+        for (float& range : ranges)
+            if (!get(p, end, range))
+                return false;
+        std::uint64_t nodes = fileResolution + 1ull;
+        if (!get(p, end, error) || !get(p, end, count) || count != (fileDimensions == 2 ? nodes * nodes : nodes)
+            || static_cast<std::size_t>(end - p) / sizeof(float) < count)
+            return false;
+
+        dimensions = fileDimensions;
+        resolution = fileResolution;
+        for (int d = 0; d < 2; ++d)
+        {
+            minRange[d] = ranges[2 * d];
+            maxRange[d] = ranges[2 * d + 1];
+            scale[d] = maxRange[d] > minRange[d] ? resolution / (maxRange[d] - minRange[d]) : 0.0f;
+        }
+        maxError = error;
+        key = fileKey;
+        values.resize(count);
+        std::memcpy(values.data(), p, count * sizeof(float));
+        return true;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Loads a table through its cache. A cache that cannot be written only costs the next start its tabulation.
+    \param cachePath
+        Path of the cache file.
+    \param module
+        The compiled module.
+    \param frozen
+        Context holding the DOMs of the sets outside the inputs.
+    \param inputs
+        Indices of the input variables.
+    \param output
+        Index of the output variable.
+    \param method
+        Defuzzification method.
+    \param resolution
+        Cells along every input.
+    \return
+        True on success.
+    *******************************************************************************/
+    bool ControlSurface::load(const std::string& cachePath, const FlatFuzzyModule& module, const FuzzyContext& frozen,
+        const std::vector<std::uint32_t>& inputs, std::uint32_t output, FuzzyModule::DefuzzifyMethod method,
+        std::uint32_t resolution)
+    {
+        if (loadCache(cachePath, makeKey(module, frozen, inputs, output, method, resolution)))
+            return true;
+        if (!build(module, frozen, inputs, output, method, resolution))
+            return false;
+        saveCache(cachePath);
+        return true;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Looks up the output of a one-input table by linear interpolation between the two nearest nodes.
+    \param x
+        Crisp input.
+    \return
+        Interpolated crisp output; 0 if the table is not a one-input table.
+    *******************************************************************************/
+    float ControlSurface::operator()(float x) const
+    {
+        if (dimensions != 1)
+            return 0.0f;
+        float fx = position(x, minRange[0], maxRange[0], scale[0]);
+        std::uint32_t i = std::min(static_cast<std::uint32_t>(fx), resolution - 1);
+        float t = fx - i;
+        return values[i] + (values[i + 1] - values[i]) * t;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Looks up the output of a two-input table by bilinear interpolation between the four nodes around the point.
+    \param x
+        Crisp value of the first input.
+    \param y
+        Crisp value of the second input.
+    \return
+        Interpolated crisp output; 0 if the table is not a two-input table.
+    *******************************************************************************/
+    float ControlSurface::operator()(float x, float y) const
+    {
+        if (dimensions != 2)
+            return 0.0f;
+        float fx = position(x, minRange[0], maxRange[0], scale[0]);
+        float fy = position(y, minRange[1], maxRange[1], scale[1]);
+        std::uint32_t i = std::min(static_cast<std::uint32_t>(fx), resolution - 1);
+        std::uint32_t j = std::min(static_cast<std::uint32_t>(fy), resolution - 1);
+        float t = fx - i, u = fy - j;
+
+        const float* row = &values[static_cast<std::size_t>(j) * (resolution + 1) + i];
+        const float* next = row + resolution + 1;
+        float bottom = row[0] + (row[1] - row[0]) * t;
+        float top = next[0] + (next[1] - next[0]) * t;
+        return bottom + (top - bottom) * u;
+    }
+} // end namespace
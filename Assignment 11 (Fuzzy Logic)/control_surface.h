@@ -0,0 +1,219 @@
+/*!*****************************************************************************
+\file      control_surface.h
+\author    Jie Le Jet Ang
+\par       DP email: jielejet.ang@digipen.edu.sg
+\par       Course: CS3183
+\par       Section: A
+\par       Programming Assignment 11
+\date      10-18-2026
+
+\brief
+	Declares ControlSurface, a lookup table of the crisp output of a one- or
+	two-input fuzzy module over a grid of its inputs. Queries interpolate the
+	table linearly (bilinearly for two inputs), so they cost a few loads
+	instead of a full inference. The table records how far it strays from
+	the exact evaluation, and it is cached in a file keyed by a hash of the
+	rule base, so it is only tabulated again when the rules change.
+*******************************************************************************/
+#ifndef CONTROL_SURFACE_H
+#define CONTROL_SURFACE_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "flat_module.h"
+
+namespace AI
+{
+	// Tabulated output of a fuzzy module over one or two inputs
+	//     Inputs are clamped to the ranges of their variables, NaN to the low
+	//     end; the value of grid node (i, j) is values[j * (resolution + 1) + i].
+	class ControlSurface
+	{
+		std::uint32_t dimensions;		// Number of inputs, 0 while empty
+		std::uint32_t resolution;		// Cells along every input
+		float minRange[2];				// Range of every input
+		float maxRange[2];
+		float scale[2];					// Cells per unit of every input
+		float maxError;					// Largest difference from the exact evaluation found
+		std::uint64_t key;				// Hash of the rule base and of how the table was made
+		std::vector<float> values;
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Creates an empty table.
+		*******************************************************************************/
+		ControlSurface();
+
+		/*!*****************************************************************************
+		\brief
+			Computes the key of a table: a hash of the module's rule base, of the
+			frozen DOMs of the sets outside the inputs, which the table is
+			evaluated with, and of the inputs, output, method and resolution.
+		\param module
+			The compiled module.
+		\param frozen
+			Context holding the DOMs of the sets outside the inputs.
+		\param inputs
+			Indices of the one or two input variables.
+		\param output
+			Index of the output variable.
+		\param method
+			Defuzzification method.
+		\param resolution
+			Cells along every input.
+		\return
+			The key.
+		*******************************************************************************/
+		static std::uint64_t makeKey(const FlatFuzzyModule& module, const FuzzyContext& frozen,
+			const std::vector<std::uint32_t>& inputs, std::uint32_t output, FuzzyModule::DefuzzifyMethod method,
+			std::uint32_t resolution);
+
+		/*!*****************************************************************************
+		\brief
+			Tabulates the output of a module at every grid node, then measures the
+			error of the table against the exact evaluation at points inside every
+			cell and at the edges and peaks of the input sets.
+		\param module
+			The compiled module.
+		\param frozen
+			Context holding the DOMs of the sets outside the inputs, such as
+				the module's getContext(); the table evaluates in a copy.
+		\param inputs
+			Indices of the one or two input variables.
+		\param output
+			Index of the output variable.
+		\param method
+			Defuzzification method.
+		\param resolution
+			Cells along every input (default is 64).
+		\param checks
+			Points checked along every input inside every cell (default is 3).
+		\return
+			True on success; false for other than one or two inputs, an unknown
+			variable or a resolution of 0.
+		*******************************************************************************/
+		bool build(const FlatFuzzyModule& module, const FuzzyContext& frozen, const std::vector<std::uint32_t>& inputs,
+			std::uint32_t output, FuzzyModule::DefuzzifyMethod method, std::uint32_t resolution = 64,
+			std::uint32_t checks = 3);
+
+		/*!*****************************************************************************
+		\brief
+			Writes the table to a cache file.
+		\param path
+			Path of the cache file.
+		\return
+			True on success.
+		*******************************************************************************/
+		bool saveCache(const std::string& path) const;
+
+		/*!*****************************************************************************
+		\brief
+			Reads a table from a cache file.
+		\param path
+			Path of the cache file.
+		\param expected
+			Key the table must have (0 accepts any).
+		\return
+			True on success; false if the file is missing, stale or damaged.
+		*******************************************************************************/
+		bool loadCache(const std::string& path, std::uint64_t expected = 0);
+
+		/*!*****************************************************************************
+		\brief
+			Loads a table through its cache: the cache is used if it was made from
+			the same rule base and settings, otherwise the table is built and the
+			cache written again.
+		\param cachePath
+			Path of the cache file.
+		\param module
+			The compiled module.
+		\param frozen
+			Context holding the DOMs of the sets outside the inputs.
+		\param inputs
+			Indices of the one or two input variables.
+		\param output
+			Index of the output variable.
+		\param method
+			Defuzzification method.
+		\param resolution
+			Cells along every input (default is 64).
+		\return
+			True on success.
+		*******************************************************************************/
+		bool load(const std::string& cachePath, const FlatFuzzyModule& module, const FuzzyContext& frozen,
+			const std::vector<std::uint32_t>& inputs, std::uint32_t output, FuzzyModule::DefuzzifyMethod method,
+			std::uint32_t resolution = 64);
+
+		/*!*****************************************************************************
+		\brief
+			Looks up the output of a one-input table.
+		\param x
+			Crisp input.
+		\return
+			Interpolated crisp output; 0 if the table is not a one-input table.
+		*******************************************************************************/
+		float operator()(float x) const;
+
+		/*!*****************************************************************************
+		\brief
+			Looks up the output of a two-input table.
+		\param x
+			Crisp value of the first input.
+		\param y
+			Crisp value of the second input.
+		\return
+			Interpolated crisp output; 0 if the table is not a two-input table.
+		*******************************************************************************/
+		float operator()(float x, float y) const;
+
+		/*!*****************************************************************************
+		\brief
+			Returns the largest difference between the table and the exact
+			evaluation found when it was built.
+		\return
+			The error bound, in units of the output variable.
+		*******************************************************************************/
+		float getMaxError() const
+		{
+			return maxError;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the key the table was made with.
+		\return
+			The key, 0 while empty.
+		*******************************************************************************/
+		std::uint64_t getKey() const
+		{
+			return key;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the number of inputs.
+		\return
+			1 or 2, 0 while empty.
+		*******************************************************************************/
+		std::uint32_t getDimensions() const
+		{
+			return dimensions;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the number of cells along every input.
+		\return
+			The resolution.
+		*******************************************************************************/
+		std::uint32_t getResolution() const
+		{
+			return resolution;
+		}
+	};
+
+} // end namespace
+
+#endif
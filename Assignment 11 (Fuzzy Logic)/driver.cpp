@@ -0,0 +1,688 @@
+/*!*****************************************************************************
+\file      driver.cpp
+\author    Jie Le Jet Ang
+\par       DP email: jielejet.ang@digipen.edu.sg
+\par       Course: CS3183
+\par       Section: A
+\par       Programming Assignment 11
+\date      10-18-2026
+
+\brief
+    Driver for the fuzzy module runtimes. Checks compare the runtimes with
+    each other on the same rule bases and benchmarks print their
+    measurements. Build it with the other files of the assignment and its
+    data.h; run it with no arguments for every check, or with the names of
+    the checks and benchmarks to run. The exit code is the number of failed
+    checks.
+*******************************************************************************/
+#include "batch_module.h"
+#include "control_surface.h"
+#include "fixed_module.h"
+#include "rule_loader.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <thread>
+
+using namespace AI;
+
+namespace
+{
+    using SetList = std::initializer_list<std::shared_ptr<FuzzySet>>;
+
+    /*!*****************************************************************************
+    \brief
+        Builds the weapon selection module: the desirability of a weapon from the distance to the target and the
+        ammo left, with a Singleton set and an OR rule besides the nine AND rules.
+    \param fm
+        Receives the variables and rules.
+    *******************************************************************************/
+    void makeWeapon(FuzzyModule& fm)
+    {
+        FuzzyVariable& dist = fm.createVariable("DistToTarget");
+        dist.addLeftShoulderSet("Close", 0, 25, 150).addTriangularSet("Medium", 25, 150, 300)
+            .addRightShoulderSet("Far", 150, 300, 1000);
+        FuzzyVariable& ammo = fm.createVariable("AmmoStatus");
+        ammo.addTriangularSet("Low", 0, 0, 10).addTriangularSet("Okay", 0, 10, 30)
+            .addRightShoulderSet("Loads", 10, 30, 40).addSingletonSet("Exact", 19, 20, 21);
+        FuzzyVariable& desire = fm.createVariable("Desirability");
+        desire.addLeftShoulderSet("Undesirable", 0, 25, 50).addTriangularSet("Desirable", 25, 50, 75)
+            .addRightShoulderSet("VeryDesirable", 50, 75, 100);
+
+        const char* dists[] = { "Close", "Medium", "Far" };
+        const char* ammos[] = { "Low", "Okay", "Loads" };
+        const char* results[3][3] = { { "Undesirable", "Undesirable", "Desirable" },
+            { "Desirable", "VeryDesirable", "VeryDesirable" }, { "Undesirable", "Undesirable", "Desirable" } };
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                fm.addRule(std::make_shared<FuzzyAND>(SetList{ dist.getSet(dists[i]), ammo.getSet(ammos[j]) }),
+                    desire.getSet(results[i][j]));
+        fm.addRule(std::make_shared<FuzzyOR>(SetList{ dist.getSet("Far"), ammo.getSet("Exact") }),
+            desire.getSet("Undesirable"));
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Builds a large module: five inputs and two outputs of seven sets each, and a rule for every pair of sets of
+        every pair of inputs, 490 rules, every fifth of them an OR.
+    \param fm
+        Receives the variables and rules.
+    *******************************************************************************/
+    void makeLarge(FuzzyModule& fm)
+    {
+        const char* names[7] = { "a", "b", "c", "d", "e", "f", "g" };
+        for (int v = 0; v < 7; ++v)
+        {
+            FuzzyVariable& var = fm.createVariable((v < 5 ? "in" : "out") + std::to_string(v < 5 ? v : v - 5));
+            var.addLeftShoulderSet(names[0], 0, 10, 20);
+            for (int k = 1; k < 6; ++k)
+                var.addTriangularSet(names[k], k * 15.0f - 10, k * 15.0f + 5, k * 15.0f + 20);
+            var.addRightShoulderSet(names[6], 80, 90, 100);
+        }
+
+        int n = 0;
+        for (int v = 0; v < 5; ++v)
+            for (int w = v + 1; w < 5; ++w)
+                for (int i = 0; i < 7; ++i)
+                    for (int j = 0; j < 7; ++j, ++n)
+                    {
+                        SetList sets{ fm.getVariable("in" + std::to_string(v)).getSet(names[i]),
+                            fm.getVariable("in" + std::to_string(w)).getSet(names[j]) };
+                        std::shared_ptr<FuzzyOperator> op;
+                        if (n % 5 == 0)
+                            op = std::make_shared<FuzzyOR>(sets);
+                        else
+                            op = std::make_shared<FuzzyAND>(sets);
+                        FuzzyVariable& out = fm.getVariable("out" + std::to_string(n % 2));
+                        fm.addRule(op, out.getSet(names[(i * 3 + j * 5 + v) % 7]));
+                    }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Checks that FlatFuzzyModule gives the same bits as the FuzzyModule it was compiled from, for every method,
+        with one input changing at a time as in a game loop.
+    \return
+        True if every output matches.
+    *******************************************************************************/
+    bool checkFlat()
+    {
+        FuzzyModule fm;
+        makeWeapon(fm);
+        FlatFuzzyModule module(fm);
+        std::uint32_t dist = module.getVariableIndex("DistToTarget"), ammo = module.getVariableIndex("AmmoStatus");
+        std::uint32_t desire = module.getVariableIndex("Desirability");
+
+        std::mt19937 gen(3);
+        std::uniform_real_distribution<float> distRandom(-10.0f, 1100.0f), ammoRandom(-5.0f, 45.0f);
+        for (int t = 0; t < 5000; ++t)
+        {
+            if (t % 2)
+            {
+                float x = distRandom(gen);
+                fm.fuzzify("DistToTarget", x);
+                module.fuzzify(dist, x);
+            }
+            else
+            {
+                float x = t % 10 ? ammoRandom(gen) : static_cast<float>(t % 50);
+                fm.fuzzify("AmmoStatus", x);
+                module.fuzzify(ammo, x);
+            }
+            FuzzyModule::DefuzzifyMethod method = static_cast<FuzzyModule::DefuzzifyMethod>(t % 3);
+            float object = fm.deFuzzify("Desirability", method), flat = module.deFuzzify(desire, method);
+            if (std::memcmp(&object, &flat, sizeof(float)) != 0)
+                return false;
+        }
+        return true;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Checks that BatchFuzzyModule gives the same bits as FlatFuzzyModule, agent by agent, for both methods. The
+        inputs are random, some of them outside the ranges, and start with the edges and peaks of the sets; the count
+        is not a multiple of the lanes, so the last chunk is partial.
+    \return
+        True if every output matches.
+    *******************************************************************************/
+    bool checkBatch()
+    {
+        FuzzyModule fm;
+        makeWeapon(fm);
+        FlatFuzzyModule module(fm);
+        BatchFuzzyModule batch(module);
+        const FuzzyContext frozen(module);
+        std::uint32_t dist = module.getVariableIndex("DistToTarget"), ammo = module.getVariableIndex("AmmoStatus");
+        std::uint32_t desire = module.getVariableIndex("Desirability");
+
+        const std::size_t count = 10007;
+        const float distEdges[] = { 0, 25, 150, 300, 1000 }, ammoEdges[] = { 0, 10, 19, 20, 21, 30, 40 };
+        std::mt19937 gen(1);
+        std::uniform_real_distribution<float> distRandom(-10.0f, 1100.0f), ammoRandom(-5.0f, 45.0f);
+        std::vector<float> dists(count), ammos(count), results(count);
+        for (std::size_t a = 0; a < count; ++a)
+        {
+            dists[a] = a < 35 ? distEdges[a % 5] : distRandom(gen);
+            ammos[a] = a < 35 ? ammoEdges[a / 5] : ammoRandom(gen);
+        }
+
+        for (FuzzyModule::DefuzzifyMethod method : { FuzzyModule::max_av, FuzzyModule::centroid })
+        {
+            batch.deFuzzify(frozen, { { dist, dists.data() }, { ammo, ammos.data() } }, count, desire, method,
+                results.data());
+            for (std::size_t a = 0; a < count; ++a)
+            {
+                module.fuzzify(dist, dists[a]);
+                module.fuzzify(ammo, ammos[a]);
+                float scalar = module.deFuzzify(desire, method);
+                if (std::memcmp(&scalar, &results[a], sizeof(float)) != 0)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Checks that contexts let threads share one module: four threads evaluate their own quarter of the inputs,
+        each in a context of its own, and every output must match evaluating the module itself one input at a time.
+    \return
+        True if every output matches.
+    *******************************************************************************/
+    bool checkContexts()
+    {
+        FuzzyModule fm;
+        makeWeapon(fm);
+        FlatFuzzyModule module(fm);
+        std::uint32_t dist = module.getVariableIndex("DistToTarget"), ammo = module.getVariableIndex("AmmoStatus");
+        std::uint32_t desire = module.getVariableIndex("Desirability");
+
+        const std::size_t count = 4000, threadCount = 4;
+        std::mt19937 gen(4);
+        std::uniform_real_distribution<float> distRandom(0.0f, 1000.0f), ammoRandom(0.0f, 40.0f);
+        std::vector<float> dists(count), ammos(count), results(count);
+        for (std::size_t a = 0; a < count; ++a)
+        {
+            dists[a] = distRandom(gen);
+            ammos[a] = ammoRandom(gen);
+        }
+
+        const FlatFuzzyModule& shared = module;
+        std::vector<std::thread> threads;
+        for (std::size_t k = 0; k < threadCount; ++k)
+            threads.emplace_back([&, k]()
+            {
+                FuzzyContext context(shared);
+                for (std::size_t a = k; a < count; a += threadCount)
+                {
+                    shared.fuzzify(context, dist, dists[a]);
+                    shared.fuzzify(context, ammo, ammos[a]);
+                    results[a] = shared.deFuzzify(context, desire, FuzzyModule::centroid);
+                }
+            });
+        for (std::thread& thread : threads)
+            thread.join();
+
+        for (std::size_t a = 0; a < count; ++a)
+        {
+            module.fuzzify(dist, dists[a]);
+            module.fuzzify(ammo, ammos[a]);
+            if (module.deFuzzify(desire, FuzzyModule::centroid) != results[a])
+                return false;
+        }
+        return true;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Checks that firing a context again only for the rules whose antecedents changed gives the same DOMs and
+        outputs as firing every rule. One random input of the large module changes at a time, every input is
+        fuzzified again each step, and both outputs are defuzzified with every method; the context must also have
+        evaluated fewer rules than full firing does.
+    \return
+        True if every DOM and output matches and rules were skipped.
+    *******************************************************************************/
+    bool checkIncremental()
+    {
+        FuzzyModule fm;
+        makeLarge(fm);
+        FlatFuzzyModule module(fm), full(module);
+        FuzzyContext context(module);
+        std::uint32_t inputs[5], outputs[2];
+        for (int v = 0; v < 5; ++v)
+            inputs[v] = module.getVariableIndex("in" + std::to_string(v));
+        for (int o = 0; o < 2; ++o)
+            outputs[o] = module.getVariableIndex("out" + std::to_string(o));
+
+        const int steps = 3000;
+        float current[5] = { 50, 50, 50, 50, 50 };
+        std::mt19937 gen(2);
+        std::uniform_real_distribution<float> random(-5.0f, 105.0f);
+        for (int t = 0; t < steps; ++t)
+        {
+            current[gen() % 5] = t % 11 ? random(gen) : 15.0f * (t % 7);
+            for (int v = 0; v < 5; ++v)
+            {
+                module.fuzzify(context, inputs[v], current[v]);
+                full.fuzzify(inputs[v], current[v]);
+            }
+            FuzzyModule::DefuzzifyMethod method = static_cast<FuzzyModule::DefuzzifyMethod>(t % 3);
+            for (std::uint32_t output : outputs)
+                if (module.deFuzzify(context, output, method) != full.deFuzzify(output, method))
+                    return false;
+            for (std::uint32_t s = 0; s < module.getSets().size(); ++s)
+                if (context.getDOM(s) != full.getDOM(s))
+                    return false;
+        }
+        return context.getRulesFired() < 2ull * steps * module.getRules().size();
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Checks FixedFuzzyModule against the float path on the weapon and large modules, both with outputs from 0 to
+        100: for the same crisp inputs, some of them on set edges and outside the ranges, every DOM must be within
+        4 steps and both methods within 0.01. A module beyond the fixed-point range must be refused, and so must exact
+        centroid, which has no fixed-point form.
+    \return
+        True if every DOM and output is within its tolerance and the large range and exact centroid are refused.
+    *******************************************************************************/
+    bool checkFixed()
+    {
+        using Fixed = FixedFuzzyModule::Fixed;
+        FuzzyModule weapon, large;
+        makeWeapon(weapon);
+        makeLarge(large);
+        std::mt19937 gen(11);
+        for (FuzzyModule* fm : { &weapon, &large })
+        {
+            FlatFuzzyModule module(*fm);
+            FixedFuzzyModule fixed(module);
+            std::uint32_t output = module.getVariableIndex(fm == &weapon ? "Desirability" : "out0");
+            std::vector<std::uint32_t> inputs;
+            for (std::uint32_t v = 0; v < module.getVariables().size(); ++v)
+                if (v != output && module.getVariables()[v].count)
+                    inputs.push_back(v);
+
+            for (int t = 0; t < 5000; ++t)
+                for (std::uint32_t v : inputs)
+                {
+                    const FlatFuzzyModule::FlatVariable& var = module.getVariables()[v];
+                    const FlatFuzzyModule::FlatSet& set = module.getSets()[var.first + gen() % var.count];
+                    float width = var.maxRange - var.minRange;
+                    std::uniform_real_distribution<float> random(var.minRange - width / 10, var.maxRange + width / 10);
+                    float x = t % 4 ? random(gen) : t % 8 ? set.leftEdge : set.rightEdge;
+                    Fixed crisp = FixedFuzzyModule::toFixed(x);
+                    module.fuzzify(v, FixedFuzzyModule::toFloat(crisp));
+                    fixed.fuzzify(v, crisp);
+
+                    for (FuzzyModule::DefuzzifyMethod method : { FuzzyModule::max_av, FuzzyModule::centroid })
+                    {
+                        float exact = module.deFuzzify(output, method);
+                        if (std::fabs(exact - FixedFuzzyModule::toFloat(fixed.deFuzzify(output, method))) > 0.01f)
+                            return false;
+                    }
+                    for (std::uint32_t s = 0; s < module.getSets().size(); ++s)
+                        if (std::abs(FixedFuzzyModule::toFixed(module.getDOM(s)) - fixed.getDOM(s)) > 4)
+                            return false;
+                }
+        }
+
+        FuzzyModule wide;
+        wide.createVariable("Far").addTriangularSet("Edge", 0, 20000, 40000);
+        FixedFuzzyModule refused{ FlatFuzzyModule(wide) };
+        return !refused.isValid() && refused.deFuzzify(0, FuzzyModule::max_av) == 0
+            && FixedFuzzyModule::supports(FuzzyModule::centroid)
+            && !FixedFuzzyModule::supports(FuzzyModule::exact_centroid);
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Checks ControlSurface: an empty table and NaN inputs give finite outputs, a table restored from its cache
+        looks up the same values, and the key changes with the frozen DOMs of a variable that is not an input, which
+        the table is evaluated with. Fuzzifying the module's own context must leave the compiled DOMs, which a new
+        context starts from, as they were.
+    \return
+        True if every part behaves.
+    *******************************************************************************/
+    bool checkSurface()
+    {
+        FuzzyModule fm;
+        makeWeapon(fm);
+        FlatFuzzyModule module(fm);
+        std::uint32_t dist = module.getVariableIndex("DistToTarget"), ammo = module.getVariableIndex("AmmoStatus");
+        std::uint32_t desire = module.getVariableIndex("Desirability");
+
+        ControlSurface empty;
+        bool passed = empty(1.0f) == 0.0f && empty(1.0f, 2.0f) == 0.0f;
+
+        const char* path = "driver_surface.fcs";
+        ControlSurface built, cached;
+        const FuzzyContext& own = module.getContext();
+        std::uint64_t key = ControlSurface::makeKey(module, own, { dist, ammo }, desire, FuzzyModule::centroid, 32);
+        passed = passed && built.build(module, own, { dist, ammo }, desire, FuzzyModule::centroid, 32)
+            && built.saveCache(path)
+            && cached.loadCache(path, key)
+            && std::isfinite(cached(NAN, 20.0f)) && cached(NAN, 20.0f) == cached(0.0f, 20.0f)
+            && built(1.0f) == 0.0f;
+        for (float x = -50.0f; x < 1100.0f && passed; x += 37.0f)
+            passed = built(x, x / 25.0f) == cached(x, x / 25.0f);
+        std::remove(path);
+
+        std::uint64_t before = ControlSurface::makeKey(module, own, { dist }, desire, FuzzyModule::max_av, 64);
+        module.fuzzify(dist, 500.0f);
+        std::uint64_t input = ControlSurface::makeKey(module, own, { dist }, desire, FuzzyModule::max_av, 64);
+        module.fuzzify(ammo, 20.0f);
+        std::uint64_t frozen = ControlSurface::makeKey(module, own, { dist }, desire, FuzzyModule::max_av, 64);
+        std::uint64_t compiled = ControlSurface::makeKey(module, FuzzyContext(module), { dist }, desire,
+            FuzzyModule::max_av, 64);
+        return passed && before == input && input != frozen && compiled == before;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Checks RuleLoader: the weapon module read from text must give the same bits as the one built in C++, for
+        every method, and definitions with mistakes must be refused with a message, leaving the module as it was.
+    \return
+        True if every output matches and every mistake is refused.
+    *******************************************************************************/
+    bool checkLoader()
+    {
+        const std::string text =
+            "# The module of makeWeapon\n"
+            "variable DistToTarget\n"
+            "{\n"
+            "    Close = LeftShoulder(0, 25, 150)\n"
+            "    Medium = Triangle(25, 150, 300)\n"
+            "    Far = RightShoulder(150, 300, 1000)\n"
+            "}\n"
+            "variable AmmoStatus\n"
+            "{\n"
+            "    Low = Triangle(0, 0, 10)\n"
+            "    Okay = Triangle(0, 10, 30)\n"
+            "    Loads = RightShoulder(10, 30, 40)\n"
+            "    Exact = Singleton(19, 20, 21)\n"
+            "}\n"
+            "variable Desirability\n"
+            "{\n"
+            "    Undesirable = LeftShoulder(0, 25, 50)\n"
+            "    Desirable = Triangle(25, 50, 75)\n"
+            "    VeryDesirable = RightShoulder(50, 75, 100)\n"
+            "}\n"
+            "IF DistToTarget IS Close AND AmmoStatus IS Low THEN Desirability IS Undesirable\n"
+            "IF DistToTarget IS Close AND AmmoStatus IS Okay THEN Desirability IS Undesirable\n"
+            "IF DistToTarget IS Close AND AmmoStatus IS Loads THEN Desirability IS Desirable\n"
+            "IF DistToTarget IS Medium AND AmmoStatus IS Low THEN Desirability IS Desirable\n"
+            "IF DistToTarget IS Medium AND AmmoStatus IS Okay THEN Desirability IS VeryDesirable\n"
+            "if DistToTarget is Medium and AmmoStatus is Loads then Desirability is VeryDesirable\n"
+            "IF DistToTarget IS Far AND AmmoStatus IS Low THEN Desirability IS Undesirable\n"
+            "IF DistToTarget IS Far AND AmmoStatus IS Okay THEN Desirability IS Undesirable\n"
+            "IF DistToTarget IS Far AND AmmoStatus IS Loads THEN Desirability IS Desirable\n"
+            "IF DistToTarget IS Far OR AmmoStatus IS Exact THEN Desirability IS Undesirable\n";
+        const char* mistakes[] = {
+            "variable A { Low = Triangle(0, 10, 5) }",
+            "variable A { Low = Square(0, 5, 10) }",
+            "variable A { Low = Triangle(0, 5, 10) }\nIF A IS High THEN A IS Low",
+            "variable A { Low = Triangle(0, 5, 10) }\nIF A IS Low AND A IS Low OR A IS Low THEN A IS Low",
+            "IF B IS Low THEN B IS Low",
+        };
+
+        FuzzyModule fm;
+        makeWeapon(fm);
+        FlatFuzzyModule built(fm), loaded;
+        RuleLoader loader;
+        if (!loader.parse(text, loaded) || loaded.getSets().size() != built.getSets().size()
+            || loaded.getRules().size() != built.getRules().size())
+            return false;
+        for (const char* mistake : mistakes)
+            if (loader.parse(mistake, loaded) || loader.getError().empty())
+                return false;
+
+        std::uint32_t dist = loaded.getVariableIndex("DistToTarget"), ammo = loaded.getVariableIndex("AmmoStatus");
+        std::uint32_t desire = loaded.getVariableIndex("Desirability");
+        std::mt19937 gen(5);
+        std::uniform_real_distribution<float> distRandom(-10.0f, 1100.0f), ammoRandom(-5.0f, 45.0f);
+        for (int t = 0; t < 5000; ++t)
+        {
+            float x = distRandom(gen), y = t % 10 ? ammoRandom(gen) : static_cast<float>(t % 50);
+            built.fuzzify(dist, x);
+            loaded.fuzzify(dist, x);
+            built.fuzzify(ammo, y);
+            loaded.fuzzify(ammo, y);
+            FuzzyModule::DefuzzifyMethod method = static_cast<FuzzyModule::DefuzzifyMethod>(t % 3);
+            float expected = built.deFuzzify(desire, method), result = loaded.deFuzzify(desire, method);
+            if (std::memcmp(&expected, &result, sizeof(float)) != 0)
+                return false;
+        }
+        return true;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Checks that defuzzifying both outputs of the large module after firing its rules once gives the same bits
+        as defuzzifying them one call at a time, for the object module, the compiled module and a context, with
+        every method.
+    \return
+        True if every output matches.
+    *******************************************************************************/
+    bool checkOutputs()
+    {
+        FuzzyModule fm;
+        makeLarge(fm);
+        FlatFuzzyModule module(fm);
+        FuzzyContext context(module);
+        const std::vector<std::string> names{ "out0", "out1" };
+        std::vector<std::uint32_t> inputs, outputs;
+        for (int v = 0; v < 5; ++v)
+            inputs.push_back(module.getVariableIndex("in" + std::to_string(v)));
+        for (const std::string& name : names)
+            outputs.push_back(module.getVariableIndex(name));
+
+        std::mt19937 gen(6);
+        std::uniform_real_distribution<float> random(-5.0f, 105.0f);
+        for (int t = 0; t < 2000; ++t)
+        {
+            for (int v = 0; v < 5; ++v)
+            {
+                float x = random(gen);
+                fm.fuzzify("in" + std::to_string(v), x);
+                module.fuzzify(inputs[v], x);
+                module.fuzzify(context, inputs[v], x);
+            }
+            FuzzyModule::DefuzzifyMethod method = static_cast<FuzzyModule::DefuzzifyMethod>(t % 3);
+            float object[2], flat[2], contexted[2];
+            fm.deFuzzify(names, method, object);
+            module.deFuzzify(outputs, method, flat);
+            module.deFuzzify(context, outputs, method, contexted);
+            for (std::size_t o = 0; o < outputs.size(); ++o)
+            {
+                float single = fm.deFuzzify(names[o], method);
+                if (std::memcmp(&single, &object[o], sizeof(float)) != 0
+                    || std::memcmp(&single, &flat[o], sizeof(float)) != 0
+                    || std::memcmp(&single, &contexted[o], sizeof(float)) != 0)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Calculates the centroid of a fired variable by the midpoint rule in double, aggregating the clipped sets by
+        sum as the centroid method does.
+    \param module
+        The compiled module.
+    \param context
+        The fired DOMs.
+    \param variable
+        Index of the variable.
+    \param samples
+        Number of cross-sections.
+    \return
+        The centroid, or 0 if the sum has no area.
+    *******************************************************************************/
+    double denseCentroid(const FlatFuzzyModule& module, const FuzzyContext& context, std::uint32_t variable,
+        int samples)
+    {
+        const FlatFuzzyModule::FlatVariable& v = module.getVariables()[variable];
+        double step = (static_cast<double>(v.maxRange) - v.minRange) / samples;
+        double area = 0.0, moment = 0.0;
+        for (int i = 0; i < samples; ++i)
+        {
+            double x = v.minRange + (i + 0.5) * step;
+            double sum = 0.0;
+            for (std::uint32_t s = v.first; s < v.first + v.count; ++s)
+                sum += std::min(calculateDOM(module.getSets()[s], static_cast<float>(x)), context.getDOM(s));
+            area += sum;
+            moment += x * sum;
+        }
+        return area > 0.0 ? moment / area : 0.0;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Checks exact centroid defuzzification against a dense midpoint sum of the same clipped sets, with the sets
+        aggregated by sum like the centroid method, on the weapon module and both outputs of the large module at
+        random inputs. The sets of both modules overlap, so aggregating by maximum would stray by whole units.
+    \return
+        True if every output is within 0.001 of the dense sum.
+    *******************************************************************************/
+    bool checkExact()
+    {
+        FuzzyModule weaponModule, largeModule;
+        makeWeapon(weaponModule);
+        makeLarge(largeModule);
+        const FlatFuzzyModule weapon(weaponModule), large(largeModule);
+        FuzzyContext weaponContext(weapon), largeContext(large);
+        std::mt19937 gen(10);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        for (int t = 0; t < 200; ++t)
+        {
+            weapon.fuzzify(weaponContext, weapon.getVariableIndex("DistToTarget"), 1000.0f * unit(gen));
+            weapon.fuzzify(weaponContext, weapon.getVariableIndex("AmmoStatus"), 40.0f * unit(gen));
+            std::uint32_t desire = weapon.getVariableIndex("Desirability");
+            float exact = weapon.deFuzzify(weaponContext, desire, FuzzyModule::exact_centroid);
+            if (std::fabs(exact - denseCentroid(weapon, weaponContext, desire, 20000)) > 0.001)
+                return false;
+
+            for (int v = 0; v < 5; ++v)
+                large.fuzzify(largeContext, large.getVariableIndex("in" + std::to_string(v)), 100.0f * unit(gen));
+            for (const char* name : { "out0", "out1" })
+            {
+                std::uint32_t output = large.getVariableIndex(name);
+                exact = large.deFuzzify(largeContext, output, FuzzyModule::exact_centroid);
+                if (std::fabs(exact - denseCentroid(large, largeContext, output, 20000)) > 0.001)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Prints the decisions per second of the weapon module for 100k agents with random inputs, for every method:
+        BatchFuzzyModule on the whole batch against FlatFuzzyModule one agent at a time in a context.
+    \return
+        True.
+    *******************************************************************************/
+    bool benchThroughput()
+    {
+        FuzzyModule fm;
+        makeWeapon(fm);
+        FlatFuzzyModule module(fm);
+        BatchFuzzyModule batch(module);
+        const FuzzyContext frozen(module);
+        std::uint32_t dist = module.getVariableIndex("DistToTarget"), ammo = module.getVariableIndex("AmmoStatus");
+        std::uint32_t desire = module.getVariableIndex("Desirability");
+
+        const std::size_t count = 100000;
+        std::mt19937 gen(9);
+        std::uniform_real_distribution<float> distRandom(0.0f, 1000.0f), ammoRandom(0.0f, 40.0f);
+        std::vector<float> dists(count), ammos(count), results(count);
+        for (std::size_t a = 0; a < count; ++a)
+        {
+            dists[a] = distRandom(gen);
+            ammos[a] = ammoRandom(gen);
+        }
+
+        const std::pair<FuzzyModule::DefuzzifyMethod, const char*> methods[] = { { FuzzyModule::max_av, "max_av" },
+            { FuzzyModule::centroid, "centroid" }, { FuzzyModule::exact_centroid, "exact_centroid" } };
+        for (const auto& method : methods)
+        {
+            batch.resetStats();
+            for (int pass = 0; pass < 3; ++pass)
+                batch.deFuzzify(frozen, { { dist, dists.data() }, { ammo, ammos.data() } }, count, desire,
+                    method.first, results.data());
+
+            FuzzyContext context(module);
+            auto start = std::chrono::steady_clock::now();
+            for (int pass = 0; pass < 3; ++pass)
+                for (std::size_t a = 0; a < count; ++a)
+                {
+                    module.fuzzify(context, dist, dists[a]);
+                    module.fuzzify(context, ammo, ammos[a]);
+                    results[a] = module.deFuzzify(context, desire, method.first);
+                }
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            double single = seconds > 0.0 ? 3.0 * count / seconds : 0.0;
+
+            std::cout << "  " << method.second << ": batch "
+                << static_cast<std::uint64_t>(batch.getDecisionsPerSecond()) << " decisions/s, per agent "
+                << static_cast<std::uint64_t>(single) << " decisions/s\n";
+        }
+        return true;
+    }
+
+    // A check or benchmark of the driver
+    struct Test
+    {
+        const char* name;
+        bool (*run)();
+        bool benchmark;	// Only run when named
+    };
+
+    const Test TESTS[] = {
+        { "flat", &checkFlat, false },
+        { "batch", &checkBatch, false },
+        { "contexts", &checkContexts, false },
+        { "incremental", &checkIncremental, false },
+        { "fixed", &checkFixed, false },
+        { "surface", &checkSurface, false },
+        { "loader", &checkLoader, false },
+        { "outputs", &checkOutputs, false },
+        { "exact", &checkExact, false },
+        { "throughput", &benchThroughput, true },
+    };
+}
+
+/*!*****************************************************************************
+\brief
+    Runs every check, or the checks and benchmarks named on the command line, and prints the result of every check.
+\param argc
+    Number of arguments.
+\param argv
+    The arguments.
+\return
+    Number of failed checks.
+*******************************************************************************/
+int main(int argc, char* argv[])
+{
+    int failed = 0;
+    for (const Test& test : TESTS)
+    {
+        bool named = argc == 1 && !test.benchmark;
+        for (int a = 1; a < argc; ++a)
+            named = named || std::strcmp(argv[a], test.name) == 0;
+        if (!named)
+            continue;
+        bool passed = test.run();
+        if (!test.benchmark)
+            std::cout << test.name << ": " << (passed ? "passed" : "FAILED") << "\n";
+        failed += passed ? 0 : 1;
+    }
+    return failed;
+}
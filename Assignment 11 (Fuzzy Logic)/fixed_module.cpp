@@ -0,0 +1,417 @@
+/*!*****************************************************************************
+\file      fixed_module.cpp
+\author    Jie Le Jet Ang
+\par       DP email: jielejet.ang@digipen.edu.sg
+\par       Course: CS3183
+\par       Section: A
+\par       Programming Assignment 11
+\date      10-18-2026
+
+\brief
+    Implements FixedFuzzyModule: converting a compiled module to Q16.16
+    trapezoids and evaluating it with integer operations.
+*******************************************************************************/
+#include "fixed_module.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace AI
+{
+    namespace
+    {
+        const std::int64_t SCALE_ONE = std::int64_t{ 1 } << 48;	// 1 in the 2^-48 units of riseScale and fallScale
+
+        /*!*****************************************************************************
+        \brief
+            Returns the first fixed-point value at or past a vertical edge of a set, as the float path sees it: the
+            smallest x with toFloat(x) >= edge. Rounding the edge instead would flip the membership of the values
+            between the edge and its rounded value.
+        \param edge
+            The edge.
+        \return
+            The fixed-point edge.
+        *******************************************************************************/
+        std::int64_t lowEdge(float edge)
+        {
+            std::int64_t x = static_cast<std::int64_t>(std::ceil(static_cast<double>(edge) * FixedFuzzyModule::ONE));
+            while (FixedFuzzyModule::toFloat(static_cast<FixedFuzzyModule::Fixed>(x - 1)) >= edge)
+                --x;
+            while (FixedFuzzyModule::toFloat(static_cast<FixedFuzzyModule::Fixed>(x)) < edge)
+                ++x;
+            return x;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Returns the last fixed-point value at or before a vertical edge of a set, as the float path sees it: the
+            largest x with toFloat(x) <= edge.
+        \param edge
+            The edge.
+        \return
+            The fixed-point edge.
+        *******************************************************************************/
+        std::int64_t highEdge(float edge)
+        {
+            std::int64_t x = static_cast<std::int64_t>(std::floor(static_cast<double>(edge) * FixedFuzzyModule::ONE));
+            while (FixedFuzzyModule::toFloat(static_cast<FixedFuzzyModule::Fixed>(x + 1)) <= edge)
+                ++x;
+            while (FixedFuzzyModule::toFloat(static_cast<FixedFuzzyModule::Fixed>(x)) > edge)
+                --x;
+            return x;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Tells if a value lies within the range fixed-point modules accept.
+        \param value
+            The value.
+        \return
+            True if the magnitude is at most RANGE_MAX; false for NaN.
+        *******************************************************************************/
+        bool inRange(float value)
+        {
+            return std::fabs(value) <= FixedFuzzyModule::RANGE_MAX;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Tells if a module can be evaluated in fixed point without overflow: every range, set edge and
+            representative value lies within RANGE_MAX, and no variable has more than SAMPLES_MAX sets times centroid
+            samples (or sets, with no samples).
+        \param module
+            The compiled module.
+        \return
+            True if the module fits.
+        *******************************************************************************/
+        bool fits(const FlatFuzzyModule& module)
+        {
+            for (const FlatFuzzyModule::FlatSet& set : module.getSets())
+                if (!inRange(set.leftEdge) || !inRange(set.peak) || !inRange(set.rightEdge)
+                    || !inRange(set.representative))
+                    return false;
+            std::int64_t samples = std::max(module.getNumSamples(), 1);
+            for (const FlatFuzzyModule::FlatVariable& v : module.getVariables())
+                if (!inRange(v.minRange) || !inRange(v.maxRange) || v.count * samples > FixedFuzzyModule::SAMPLES_MAX)
+                    return false;
+            return true;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Returns the scale that turns a distance along a slope into a DOM.
+        \param width
+            Width of the slope.
+        \return
+            ceil(2^48 / width), so the end of the slope reaches a DOM of exactly 1;
+            0 for a slope of no width.
+        *******************************************************************************/
+        std::int64_t slopeScale(std::int64_t width)
+        {
+            return width > 0 ? (SCALE_ONE + width - 1) / width : 0;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Calculates the DOM of a trapezoid with integer selects only.
+            Distances are clamped to the slope before they are scaled, so the
+            products stay below 2^49 and every shift is of a value that is not
+            negative.
+        \param x
+            The value.
+        \param left
+            Start of the rise.
+        \param top
+            End of the rise.
+        \param shoulder
+            Start of the fall.
+        \param right
+            End of the fall.
+        \param riseScale
+            Scale of the rise.
+        \param fallScale
+            Scale of the fall.
+        \return
+            The DOM.
+        *******************************************************************************/
+        inline std::int64_t trapezoid(std::int64_t x, std::int64_t left, std::int64_t top, std::int64_t shoulder,
+            std::int64_t right, std::int64_t riseScale, std::int64_t fallScale)
+        {
+            const std::int64_t one = FixedFuzzyModule::ONE;
+
+            std::int64_t risen = x - left;
+            risen = risen < 0 ? 0 : risen;
+            risen = risen > top - left ? top - left : risen;
+            std::int64_t up = (risen * riseScale) >> 32;
+            up = up > one ? one : up;
+            up = x >= top ? one : up;
+            up = x < left ? 0 : up;
+
+            std::int64_t fallen = x - shoulder;
+            fallen = fallen < 0 ? 0 : fallen;
+            fallen = fallen > right - shoulder ? right - shoulder : fallen;
+            std::int64_t drop = (fallen * fallScale) >> 32;
+            drop = drop > one ? one : drop;
+            std::int64_t down = one - drop;
+            down = x > right ? 0 : down;
+
+            return up < down ? up : down;
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Converts a float to Q16.16. Scaling by 2^16 is exact in double, so the only rounding is to the nearest step,
+        halves away from 0, which does not depend on the rounding mode.
+    \param value
+        The float.
+    \return
+        The fixed-point value.
+    *******************************************************************************/
+    FixedFuzzyModule::Fixed FixedFuzzyModule::toFixed(float value)
+    {
+        double scaled = static_cast<double>(value) * ONE;
+        if (!(scaled > std::numeric_limits<Fixed>::min()))
+            return std::numeric_limits<Fixed>::min();
+        if (scaled > std::numeric_limits<Fixed>::max())
+            return std::numeric_limits<Fixed>::max();
+        return static_cast<Fixed>(std::llround(scaled));
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Compiles a module into fixed point. Every shape becomes a trapezoid with the edges the float calculateDOM
+        tests: a triangle has no plateau, a left shoulder no rise, a right shoulder no fall and a singleton neither.
+        Vertical edges are placed where the float comparison flips; the ends of slopes are rounded.
+        A set of no shape starts after it ends, so it is 0 everywhere. A set with an offset of 0 gets a plateau as
+        wide as the tolerance of isEqual around its peak, as calculateDOM treats it. The centroid sample points step
+        across the range converted to fixed point once, each one truncated from an exact integer product, and their
+        memberships come from the same trapezoids fuzzify uses, so the table is built with integer operations only
+        and no compiler can contract or reorder it differently. A module that does not fit the limits compiles to no
+        variables.
+    \param module
+        The compiled module.
+    *******************************************************************************/
+    FixedFuzzyModule::FixedFuzzyModule(const FlatFuzzyModule& module)
+        : left{}, top{}, shoulder{}, right{}, riseScale{}, fallScale{}, representative{}, variables{}, rules{},
+        terms{}, consequents{}, doms{}, sampleDOMs{}, sampleX{}, numSamples{ module.getNumSamples() },
+        valid{ fits(module) }
+    {
+        if (!valid)
+            return;
+        rules = module.getRules();
+        terms = module.getTerms();
+
+        const std::vector<FlatFuzzyModule::FlatSet>& sets = module.getSets();
+        for (std::uint32_t s = 0; s < sets.size(); ++s)
+        {
+            const FlatFuzzyModule::FlatSet& set = sets[s];
+            std::int64_t l = toFixed(set.leftEdge), p = toFixed(set.peak), r = toFixed(set.rightEdge);
+            std::int64_t t = p, h = p;
+            switch (set.shape)
+            {
+            case FuzzyShape::LeftShoulder:
+                l = t = lowEdge(set.leftEdge);
+                break;
+            case FuzzyShape::RightShoulder:
+                h = r = highEdge(set.rightEdge);
+                break;
+            case FuzzyShape::Singleton:
+                l = t = lowEdge(set.leftEdge);
+                h = r = highEdge(set.rightEdge);
+                break;
+            case FuzzyShape::Triangle:
+                break;
+            default:
+                l = t = h = 1;
+                r = 0;
+                break;
+            }
+            if (set.degenerate && set.shape != FuzzyShape::Singleton)
+            {
+                // The float path gives 1 within isEqual's tolerance of the peak of such a set
+                std::int64_t d = toFixed(2 * 128 * FLT_EPSILON * std::fabs(set.peak));
+                l = std::min(l, p - d);
+                t = std::min(t, p - d);
+                h = std::max(h, p + d);
+                r = std::max(r, p + d);
+            }
+            left.push_back(l);
+            top.push_back(t);
+            shoulder.push_back(h);
+            right.push_back(r);
+            riseScale.push_back(slopeScale(t - l));
+            fallScale.push_back(slopeScale(r - h));
+            representative.push_back(toFixed(set.representative));
+            doms.push_back(toFixed(module.getDOM(s)));
+        }
+
+        for (const FlatFuzzyModule::FlatRule& rule : rules)
+            consequents.push_back(rule.consequent);
+
+        sampleDOMs.resize(sets.size() * static_cast<std::size_t>(numSamples));
+        for (const FlatFuzzyModule::FlatVariable& v : module.getVariables())
+        {
+            std::int64_t minRange = lowEdge(v.minRange), width = highEdge(v.maxRange) - minRange;
+            std::size_t base = sampleX.size();
+            sampleX.resize(base + numSamples);
+            Fixed* x = sampleX.data() + base;
+            for (int samp = 0; samp < numSamples; ++samp)
+            {
+                x[samp] = static_cast<Fixed>(minRange + width * (samp + 1) / numSamples);
+                for (std::uint32_t s = v.first; s < v.first + v.count; ++s)
+                    sampleDOMs[static_cast<std::size_t>(s) * numSamples + samp] = static_cast<Fixed>(
+                        trapezoid(x[samp], left[s], top[s], shoulder[s], right[s], riseScale[s], fallScale[s]));
+            }
+            variables.push_back(FixedVariable{ v.first, v.count, toFixed(v.minRange), toFixed(v.maxRange) });
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Calculates the DOMs of all sets of a variable for a crisp value, in one loop without branches across the
+        variable's sets.
+    \param variable
+        Index of the variable.
+    \param val
+        Value to fuzzify.
+    *******************************************************************************/
+    void FixedFuzzyModule::fuzzify(std::uint32_t variable, Fixed val)
+    {
+        if (variable >= variables.size())
+            return;
+        const FixedVariable& v = variables[variable];
+        const std::int64_t* __restrict l = left.data() + v.first;
+        const std::int64_t* __restrict t = top.data() + v.first;
+        const std::int64_t* __restrict h = shoulder.data() + v.first;
+        const std::int64_t* __restrict r = right.data() + v.first;
+        const std::int64_t* __restrict rise = riseScale.data() + v.first;
+        const std::int64_t* __restrict fall = fallScale.data() + v.first;
+        Fixed* __restrict dom = doms.data() + v.first;
+        std::uint32_t count = v.count;
+        for (std::uint32_t s = 0; s < count; ++s)
+            dom[s] = static_cast<Fixed>(trapezoid(val, l[s], t[s], h[s], r[s], rise[s], fall[s]));
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Fires every rule on the current DOMs, like FlatFuzzyModule::fire; AND is the smallest DOM and OR the
+        largest, which are exact in fixed point.
+    *******************************************************************************/
+    void FixedFuzzyModule::fire()
+    {
+        for (std::uint32_t c : consequents)
+            doms[c] = 0;
+
+        for (const FlatFuzzyModule::FlatRule& rule : rules)
+        {
+            const std::uint32_t* term = terms.data() + rule.first;
+            Fixed dom = 0;
+            if (rule.count && rule.logic == FuzzyLogic::AND)
+            {
+                dom = ONE;
+                for (std::uint32_t t = 0; t < rule.count; ++t)
+                    dom = doms[term[t]] < dom ? doms[term[t]] : dom;
+            }
+            else if (rule.count && rule.logic == FuzzyLogic::OR)
+            {
+                dom = 0;
+                for (std::uint32_t t = 0; t < rule.count; ++t)
+                    dom = doms[term[t]] > dom ? doms[term[t]] : dom;
+            }
+
+            if (dom > doms[rule.consequent])
+                doms[rule.consequent] = dom;
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Fires every rule and defuzzifies a variable. Exact centroid has no fixed-point form, so asking for it is a
+        mistake of the caller, caught by an assertion in debug builds.
+    \param variable
+        Index of the variable.
+    \param method
+        max_av or centroid.
+    \return
+        Defuzzified crisp value; 0 for another method.
+    *******************************************************************************/
+    FixedFuzzyModule::Fixed FixedFuzzyModule::deFuzzify(std::uint32_t variable, FuzzyModule::DefuzzifyMethod method)
+    {
+        assert(supports(method) && "FixedFuzzyModule only defuzzifies with max_av or centroid");
+        if (variable >= variables.size() || !supports(method))
+            return 0;
+        fire();
+        switch (method)
+        {
+        case FuzzyModule::centroid:
+            return deFuzzifyCentroid(variable);
+        case FuzzyModule::max_av:
+            return deFuzzifyMaxAv(variable);
+        default:
+            return 0;
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Defuzzifies a variable with the maximum average method. The numerator sums Q32.32 products in 64 bits, and
+        the one division truncates toward 0.
+    \param variable
+        Index of the variable.
+    \return
+        Defuzzified crisp value.
+    *******************************************************************************/
+    FixedFuzzyModule::Fixed FixedFuzzyModule::deFuzzifyMaxAv(std::uint32_t variable) const
+    {
+        if (variable >= variables.size())
+            return 0;
+        const FixedVariable& v = variables[variable];
+        const Fixed* __restrict rep = representative.data() + v.first;
+        const Fixed* __restrict dom = doms.data() + v.first;
+        std::int64_t numerator = 0, denominator = 0;
+        for (std::uint32_t s = 0; s < v.count; ++s)
+        {
+            numerator += static_cast<std::int64_t>(rep[s]) * dom[s];
+            denominator += dom[s];
+        }
+        if (denominator == 0)
+            return 0;
+        return static_cast<Fixed>(numerator / denominator);
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Defuzzifies a variable with the centroid method over the same sample points as the float path. The clipped
+        membership of every sample is the smaller of its precomputed membership and the set's DOM, summed across the
+        samples of one set at a time, which vectorizes.
+    \param variable
+        Index of the variable.
+    \return
+        Defuzzified crisp value.
+    *******************************************************************************/
+    FixedFuzzyModule::Fixed FixedFuzzyModule::deFuzzifyCentroid(std::uint32_t variable) const
+    {
+        if (variable >= variables.size())
+            return 0;
+        const FixedVariable& v = variables[variable];
+        const Fixed* __restrict x = sampleX.data() + static_cast<std::size_t>(variable) * numSamples;
+        std::int64_t totalArea = 0, sumOfMoments = 0;
+        for (std::uint32_t s = v.first; s < v.first + v.count; ++s)
+        {
+            const Fixed* __restrict member = sampleDOMs.data() + static_cast<std::size_t>(s) * numSamples;
+            Fixed dom = doms[s];
+            for (int samp = 0; samp < numSamples; ++samp)
+            {
+                Fixed contribution = member[samp] < dom ? member[samp] : dom;
+                totalArea += contribution;
+                sumOfMoments += static_cast<std::int64_t>(x[samp]) * contribution;
+            }
+        }
+        if (totalArea == 0)
+            return 0;
+        return static_cast<Fixed>(sumOfMoments / totalArea);
+    }
+} // end namespace
@@ -0,0 +1,605 @@
+/*!*****************************************************************************
+\file      flat_module.cpp
+\author    Jie Le Jet Ang
+\par       DP email: jielejet.ang@digipen.edu.sg
+\par       Course: CS3183
+\par       Section: A
+\par       Programming Assignment 11
+\date      10-18-2026
+
+\brief
+    Implements FlatFuzzyModule: compiling a FuzzyModule into arrays and
+    evaluating the rules and both defuzzification methods by index, either
+    on the module's own DOMs or incrementally in a FuzzyContext.
+*******************************************************************************/
+#include "flat_module.h"
+
+#include <unordered_map>
+#include <algorithm>
+#include <utility>
+
+namespace AI
+{
+    namespace
+    {
+        /*!*****************************************************************************
+        \brief
+            Compiles one set from its parameters.
+        \param shape
+            Shape of the set.
+        \param peak
+            Peak point.
+        \param left
+            Left offset.
+        \param right
+            Right offset.
+        \param representative
+            Representative value.
+        \return
+            The compiled set.
+        *******************************************************************************/
+        FlatFuzzyModule::FlatSet compileSet(FuzzyShape shape, float peak, float left, float right, float representative)
+        {
+            FlatFuzzyModule::FlatSet flat;
+            flat.shape = shape;
+            flat.degenerate = isEqual(left, 0.0f) || isEqual(right, 0.0f);
+            flat.peak = peak;
+            flat.leftEdge = peak - left;
+            flat.rightEdge = peak + right;
+            flat.rise = 1.0f / left;
+            flat.fall = 1.0f / -right;
+            flat.representative = representative;
+            return flat;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Compiles one set.
+        \param set
+            The set.
+        \return
+            The compiled set.
+        *******************************************************************************/
+        FlatFuzzyModule::FlatSet compileSet(const FuzzySet& set)
+        {
+            return compileSet(set.getShape(), set.getPeakPoint(), set.getLeftOffset(), set.getRightOffset(),
+                set.getRepresentativeValue());
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Adds the bytes of a value to an FNV-1a hash. Fields are hashed one by
+            one, so the padding of the compiled structs never reaches the hash.
+        \param hash
+            The hash.
+        \param value
+            The value.
+        *******************************************************************************/
+        template<typename T>
+        void hashValue(std::uint64_t& hash, T value)
+        {
+            const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+            for (std::size_t i = 0; i < sizeof(T); ++i)
+                hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Builds a table from every set to the rules that refer to it, stored
+            as one list of rules with the first entry of every set.
+        \param setCount
+            Number of sets.
+        \param pairs
+            Every (set, rule) reference, in rule order.
+        \param first
+            Receives the first entry of every set, plus the end.
+        \param list
+            Receives the rules.
+        *******************************************************************************/
+        void buildTable(std::size_t setCount, const std::vector<std::pair<std::uint32_t, std::uint32_t>>& pairs,
+            std::vector<std::uint32_t>& first, std::vector<std::uint32_t>& list)
+        {
+            first.assign(setCount + 1, 0);
+            for (const auto& pair : pairs)
+                ++first[pair.first + 1];
+            for (std::size_t s = 0; s < setCount; ++s)
+                first[s + 1] += first[s];
+            list.resize(pairs.size());
+            std::vector<std::uint32_t> next{ first.begin(), first.end() - 1 };
+            for (const auto& pair : pairs)
+                list[next[pair.first]++] = pair.second;
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Compiles a finished module. Sets are numbered through a table keyed by their address, so a set shared by a
+        variable and several rules keeps one index and one DOM. Null sets, which getSet leaves for unknown names, are
+        skipped, and so are rules without a consequence.
+    \param module
+        The module.
+    *******************************************************************************/
+    FlatFuzzyModule::FlatFuzzyModule(const FuzzyModule& module)
+        : sets{}, variables{}, names{}, rules{}, terms{}, consequents{}, compiledDOMs{}, usedFirst{}, usedBy{},
+        firedFirst{}, firedBy{}, chained{ false }, numSamples{ module.getNumSamples() }, own{ *this }
+    {
+        std::unordered_map<const FuzzySet*, std::uint32_t> index;
+        auto add = [&](const FuzzySet& set)
+            {
+                auto found = index.find(&set);
+                if (found != index.end())
+                    return found->second;
+                std::uint32_t i = static_cast<std::uint32_t>(sets.size());
+                sets.push_back(compileSet(set));
+                compiledDOMs.push_back(set.getDOM());
+                index.emplace(&set, i);
+                return i;
+            };
+
+        for (const auto& variable : module.getVariables())
+        {
+            FlatVariable flat{ static_cast<std::uint32_t>(sets.size()), 0,
+                variable.second.getMinRange(), variable.second.getMaxRange() };
+            for (const auto& set : variable.second.getSets())
+                if (set.second)
+                {
+                    add(*set.second);
+                    ++flat.count;
+                }
+            variables.push_back(flat);
+            names.push_back(variable.first);
+        }
+
+        for (const FuzzyRule& rule : module.getRules())
+        {
+            if (!rule.getConsequence())
+                continue;
+            FlatRule flat{ FuzzyLogic::None, static_cast<std::uint32_t>(terms.size()), 0, 0 };
+            if (const FuzzyOperator* antecedent = rule.getAntecedent().get())
+            {
+                flat.logic = antecedent->getLogic();
+                for (const std::shared_ptr<FuzzySet>& set : antecedent->getSets())
+                    if (set)
+                    {
+                        terms.push_back(add(*set));
+                        ++flat.count;
+                    }
+            }
+            flat.consequent = add(*rule.getConsequence());
+            rules.push_back(flat);
+            consequents.push_back(flat.consequent);
+        }
+
+        link();
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Creates an empty module.
+    *******************************************************************************/
+    FlatFuzzyModule::FlatFuzzyModule()
+        : sets{}, variables{}, names{}, rules{}, terms{}, consequents{}, compiledDOMs{}, usedFirst{}, usedBy{},
+        firedFirst{}, firedBy{}, chained{ false }, numSamples{ 15 }, own{ *this }
+    {
+        link();
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Compiles a set the way the FuzzyVariable add functions make it: the offsets are the distances from the peak
+        to the bounds, and the representative value is the middle of a shoulder's plateau or the peak.
+    \param shape
+        Shape of the set.
+    \param minBound
+        Minimum bound of the set.
+    \param peak
+        Peak value.
+    \param maxBound
+        Maximum bound of the set.
+    \return
+        The compiled set.
+    *******************************************************************************/
+    FlatFuzzyModule::FlatSet FlatFuzzyModule::makeSet(FuzzyShape shape, float minBound, float peak, float maxBound)
+    {
+        float left = peak - minBound, right = maxBound - peak;
+        float representative = peak;
+        if (shape == FuzzyShape::LeftShoulder)
+            representative = peak - left / 2;
+        else if (shape == FuzzyShape::RightShoulder)
+            representative = peak + right / 2;
+        return compileSet(shape, peak, left, right, representative);
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Tabulates the rules that use and fire every set, for incremental firing, and starts the module's own context
+        from the compiled DOMs, now that the sets and rules are in place.
+    *******************************************************************************/
+    void FlatFuzzyModule::link()
+    {
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> used, fired;
+        for (std::uint32_t r = 0; r < rules.size(); ++r)
+        {
+            for (std::uint32_t t = rules[r].first; t < rules[r].first + rules[r].count; ++t)
+                used.emplace_back(terms[t], r);
+            fired.emplace_back(rules[r].consequent, r);
+        }
+        buildTable(sets.size(), used, usedFirst, usedBy);
+        buildTable(sets.size(), fired, firedFirst, firedBy);
+        chained = false;
+        for (std::uint32_t term : terms)
+            if (firedFirst[term + 1] > firedFirst[term])
+                chained = true;
+        own = FuzzyContext{ *this };
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Creates a context for a module, starting from the compiled DOMs, so sets of variables that are never fuzzified
+        in the context keep the DOM they had when the module was compiled, whatever the module's own context holds.
+    \param module
+        The compiled module.
+    *******************************************************************************/
+    FuzzyContext::FuzzyContext(const FlatFuzzyModule& module)
+        : doms{ module.compiledDOMs }, strengths(module.rules.size(), 0.0f), changedRules{}, changedSets{},
+        ruleChanged(module.rules.size(), 0), setChanged(module.sets.size(), 0), fired{ false }, rulesFired{ 0 }
+    {
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Returns the index of a variable.
+    \param name
+        Name of the variable.
+    \return
+        Index of the variable, or -1 if the module has none by that name.
+    *******************************************************************************/
+    int FlatFuzzyModule::getVariableIndex(const std::string& name) const
+    {
+        for (std::size_t i = 0; i < names.size(); ++i)
+            if (names[i] == name)
+                return static_cast<int>(i);
+        return -1;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Calculates the DOMs of all sets of a variable for a crisp value.
+    \param doms
+        DOM of every set.
+    \param variable
+        Index of the variable.
+    \param val
+        Value to fuzzify.
+    *******************************************************************************/
+    void FlatFuzzyModule::fuzzify(float* doms, std::uint32_t variable, float val) const
+    {
+        const FlatVariable& v = variables[variable];
+        for (std::uint32_t s = v.first; s < v.first + v.count; ++s)
+            doms[s] = calculateDOM(sets[s], val);
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Fires every rule on the current DOMs. As in FuzzyModule, all consequents are cleared before any rule fires,
+        rules fire in the order they were added, and AND and OR of no terms give 0.
+    \param doms
+        DOM of every set.
+    *******************************************************************************/
+    void FlatFuzzyModule::fire(float* doms) const
+    {
+        for (std::uint32_t c : consequents)
+            doms[c] = 0.0f;
+
+        for (const FlatRule& rule : rules)
+        {
+            float dom = strength(doms, rule);
+            if (dom > doms[rule.consequent])
+                doms[rule.consequent] = dom;
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Calculates the firing strength of a rule. AND and OR of no terms give 0.
+    \param doms
+        DOM of every set.
+    \param rule
+        The rule.
+    \return
+        The firing strength.
+    *******************************************************************************/
+    float FlatFuzzyModule::strength(const float* doms, const FlatRule& rule) const
+    {
+        const std::uint32_t* term = terms.data() + rule.first;
+        if (rule.logic == FuzzyLogic::AND)
+        {
+            float smallest = std::numeric_limits<float>::max();
+            for (std::uint32_t t = 0; t < rule.count; ++t)
+                if (doms[term[t]] < smallest)
+                    smallest = doms[term[t]];
+            return smallest == std::numeric_limits<float>::max() ? 0.0f : smallest;
+        }
+        if (rule.logic == FuzzyLogic::OR)
+        {
+            float largest = std::numeric_limits<float>::lowest();
+            for (std::uint32_t t = 0; t < rule.count; ++t)
+                if (doms[term[t]] > largest)
+                    largest = doms[term[t]];
+            return largest == std::numeric_limits<float>::lowest() ? 0.0f : largest;
+        }
+        return 0.0f;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Calculates the DOMs of all sets of a variable in a context. Only a DOM that differs from the one the context
+        holds marks its rules, so a variable that moves within the flat part of its sets fires nothing again.
+    \param context
+        The evaluation's DOMs.
+    \param variable
+        Index of the variable.
+    \param val
+        Value to fuzzify.
+    *******************************************************************************/
+    void FlatFuzzyModule::fuzzify(FuzzyContext& context, std::uint32_t variable, float val) const
+    {
+        const FlatVariable& v = variables[variable];
+        for (std::uint32_t s = v.first; s < v.first + v.count; ++s)
+        {
+            float dom = calculateDOM(sets[s], val);
+            if (dom != context.doms[s])
+            {
+                context.doms[s] = dom;
+                markChanged(context, s);
+            }
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Marks the rules that use a set to be fired again. A consequent whose DOM was overwritten is gathered again
+        too, since fire would clear and refill it.
+    \param context
+        The evaluation's DOMs.
+    \param set
+        Index of the set whose DOM changed.
+    *******************************************************************************/
+    void FlatFuzzyModule::markChanged(FuzzyContext& context, std::uint32_t set) const
+    {
+        for (std::uint32_t i = usedFirst[set]; i < usedFirst[set + 1]; ++i)
+        {
+            std::uint32_t r = usedBy[i];
+            if (!context.ruleChanged[r])
+            {
+                context.ruleChanged[r] = 1;
+                context.changedRules.push_back(r);
+            }
+        }
+        if (firedFirst[set + 1] > firedFirst[set] && !context.setChanged[set])
+        {
+            context.setChanged[set] = 1;
+            context.changedSets.push_back(set);
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Fires the changed rules of a context. Every consequent is the largest strength of the rules that fire it: a
+        rule that grows stronger only raises it, and it is gathered again from the strengths kept for all its rules
+        only when the rule that held the largest strength grew weaker. The result is the same as fire, because the largest of a set of
+        floats does not depend on the order they are compared in. The first firing evaluates every rule, and so does
+        every firing of a module where an antecedent uses a consequent, since there the order rules fire in matters.
+    \param context
+        The evaluation's DOMs.
+    *******************************************************************************/
+    void FlatFuzzyModule::fire(FuzzyContext& context) const
+    {
+        float* d = context.doms.data();
+        if (!context.fired || chained)
+        {
+            for (std::uint32_t c : consequents)
+                d[c] = 0.0f;
+            for (std::uint32_t r = 0; r < rules.size(); ++r)
+            {
+                float dom = context.strengths[r] = strength(d, rules[r]);
+                if (dom > d[rules[r].consequent])
+                    d[rules[r].consequent] = dom;
+            }
+            context.rulesFired += rules.size();
+            context.fired = true;
+            for (std::uint32_t r : context.changedRules)
+                context.ruleChanged[r] = 0;
+            for (std::uint32_t s : context.changedSets)
+                context.setChanged[s] = 0;
+            context.changedRules.clear();
+            context.changedSets.clear();
+            return;
+        }
+
+        for (std::size_t i = 0; i < context.changedRules.size(); ++i)
+        {
+            std::uint32_t r = context.changedRules[i];
+            context.ruleChanged[r] = 0;
+            float dom = strength(d, rules[r]);
+            float old = context.strengths[r];
+            context.strengths[r] = dom;
+            std::uint32_t c = rules[r].consequent;
+            if (dom > d[c])
+                d[c] = dom;
+            else if (dom < old && old == d[c] && !context.setChanged[c])
+            {
+                context.setChanged[c] = 1;
+                context.changedSets.push_back(c);
+            }
+        }
+        context.rulesFired += context.changedRules.size();
+        context.changedRules.clear();
+
+        for (std::uint32_t c : context.changedSets)
+        {
+            context.setChanged[c] = 0;
+            float dom = 0.0f;
+            for (std::uint32_t i = firedFirst[c]; i < firedFirst[c + 1]; ++i)
+                if (context.strengths[firedBy[i]] > dom)
+                    dom = context.strengths[firedBy[i]];
+            d[c] = dom;
+        }
+        context.changedSets.clear();
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Defuzzifies a variable of fired DOMs.
+    \param doms
+        DOM of every set.
+    \param variable
+        Index of the variable.
+    \param method
+        Defuzzification method to use.
+    \return
+        Defuzzified crisp value.
+    *******************************************************************************/
+    float FlatFuzzyModule::deFuzzify(const float* doms, std::uint32_t variable,
+        FuzzyModule::DefuzzifyMethod method) const
+    {
+        switch (method)
+        {
+        case FuzzyModule::centroid:
+            return deFuzzifyCentroid(doms, variable);
+        case FuzzyModule::max_av:
+            return deFuzzifyMaxAv(doms, variable);
+        case FuzzyModule::exact_centroid:
+            return deFuzzifyExactCentroid(doms, variable);
+        default:
+            return 0.0f;
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Defuzzifies a variable with the maximum average method: sum(maxima*DOM) / sum(DOM), summed in the same order
+        as FuzzyVariable::deFuzzifyMaxAv.
+    \param doms
+        DOM of every set.
+    \param variable
+        Index of the variable.
+    \return
+        Defuzzified crisp value.
+    *******************************************************************************/
+    float FlatFuzzyModule::deFuzzifyMaxAv(const float* doms, std::uint32_t variable) const
+    {
+        const FlatVariable& v = variables[variable];
+        float numerator = 0.0f, denominator = 0.0f;
+        for (std::uint32_t s = v.first; s < v.first + v.count; ++s)
+        {
+            numerator += sets[s].representative * doms[s];
+            denominator += doms[s];
+        }
+        if (isEqual(0.0f, denominator))
+            return 0.0f;
+        return numerator / denominator;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Defuzzifies a variable with the centroid method, sampling the same points in the same order as
+        FuzzyVariable::deFuzzifyCentroid.
+    \param doms
+        DOM of every set.
+    \param variable
+        Index of the variable.
+    \return
+        Defuzzified crisp value.
+    *******************************************************************************/
+    float FlatFuzzyModule::deFuzzifyCentroid(const float* doms, std::uint32_t variable) const
+    {
+        const FlatVariable& v = variables[variable];
+        float stepSize = (v.maxRange - v.minRange) / numSamples;
+        float totalArea = 0.0f;
+        float sumOfMoments = 0.0f;
+
+        for (int samp = 1; samp <= numSamples; ++samp)
+        {
+            float x = v.minRange + samp * stepSize;
+            for (std::uint32_t s = v.first; s < v.first + v.count; ++s)
+            {
+                float contribution = std::min(calculateDOM(sets[s], x), doms[s]);
+                totalArea += contribution;
+                sumOfMoments += x * contribution;
+            }
+        }
+        if (isEqual(0.0f, totalArea))
+            return 0.0f;
+        return sumOfMoments / totalArea;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Defuzzifies a variable with the exact centroid of its clipped sets. The clipped sets of variables with up to
+        16 sets are gathered on the stack.
+    \param doms
+        DOM of every set.
+    \param variable
+        Index of the variable.
+    \return
+        Defuzzified crisp value.
+    *******************************************************************************/
+    float FlatFuzzyModule::deFuzzifyExactCentroid(const float* doms, std::uint32_t variable) const
+    {
+        const FlatVariable& v = variables[variable];
+        ClippedSet small[16];
+        std::vector<ClippedSet> large;
+        ClippedSet* clipped = small;
+        if (v.count > 16)
+        {
+            large.resize(v.count);
+            clipped = large.data();
+        }
+        for (std::uint32_t s = 0; s < v.count; ++s)
+            clipped[s] = clip(sets[v.first + s], doms[v.first + s]);
+        return exactCentroid(clipped, v.count, v.minRange, v.maxRange);
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Computes a 64-bit FNV-1a hash of the rule base. The names of the variables are hashed too, so two modules
+        that only differ in which variable is which do not share a hash. A hash of 0 is mapped to 1, so 0 can mean
+        "no hash".
+    \return
+        The hash.
+    *******************************************************************************/
+    std::uint64_t FlatFuzzyModule::getHash() const
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+        hashValue(hash, numSamples);
+        for (const FlatSet& set : sets)
+        {
+            hashValue(hash, static_cast<int>(set.shape));
+            hashValue(hash, set.peak);
+            hashValue(hash, set.leftEdge);
+            hashValue(hash, set.rightEdge);
+            hashValue(hash, set.representative);
+        }
+        for (std::size_t v = 0; v < variables.size(); ++v)
+        {
+            hashValue(hash, variables[v].first);
+            hashValue(hash, variables[v].count);
+            hashValue(hash, variables[v].minRange);
+            hashValue(hash, variables[v].maxRange);
+            for (char c : names[v])
+                hashValue(hash, c);
+            hashValue(hash, '\0');
+        }
+        for (const FlatRule& rule : rules)
+        {
+            hashValue(hash, static_cast<int>(rule.logic));
+            hashValue(hash, rule.first);
+            hashValue(hash, rule.count);
+            hashValue(hash, rule.consequent);
+        }
+        for (std::uint32_t term : terms)
+            hashValue(hash, term);
+        return hash ? hash : 1;
+    }
+} // end namespace
@@ -0,0 +1,667 @@
+/*!*****************************************************************************
+\file      flat_module.h
+\author    Jie Le Jet Ang
+\par       DP email: jielejet.ang@digipen.edu.sg
+\par       Course: CS3183
+\par       Section: A
+\par       Programming Assignment 11
+\date      10-18-2026
+
+\brief
+	Declares FlatFuzzyModule, which compiles a finished FuzzyModule into
+	contiguous arrays of set parameters, rule terms and consequent indices,
+	and evaluates it by index with switches on the set shape and operator
+	kind instead of map lookups, virtual calls and shared_ptr copies. Crisp
+	outputs are identical to the FuzzyModule it was compiled from. The
+	compiled arrays never change once built: every evaluation keeps its DOMs
+	in a FuzzyContext, so many threads can evaluate one module at once, and
+	the calls without a context use one the module keeps for them.
+*******************************************************************************/
+#ifndef FLAT_MODULE_H
+#define FLAT_MODULE_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "functions.h"
+
+namespace AI
+{
+	class FlatFuzzyModule;
+
+	// DOMs of one evaluation of a FlatFuzzyModule
+	//     The module itself is only read when it evaluates in a context, so
+	//     every thread keeps a context of its own and shares the module
+	//     without locks. A context also keeps the firing strength of every
+	//     rule, so firing again only recalculates the rules whose antecedent
+	//     sets changed DOM since the last firing.
+	class FuzzyContext
+	{
+		friend class FlatFuzzyModule;
+
+		std::vector<float> doms;					// DOM of every set, indexed like the module's sets
+		std::vector<float> strengths;				// Firing strength of every rule at the last firing
+		std::vector<std::uint32_t> changedRules;	// Rules to fire again
+		std::vector<std::uint32_t> changedSets;		// Consequents to gather again from their rules
+		std::vector<unsigned char> ruleChanged;		// Whether a rule is in changedRules
+		std::vector<unsigned char> setChanged;		// Whether a set is in changedSets
+		bool fired;									// Whether strengths holds every rule
+		std::uint64_t rulesFired;					// Rules evaluated since the last resetStats
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Creates a context for a module, starting from the DOMs the module was
+			compiled with.
+		\param module
+			The compiled module.
+		*******************************************************************************/
+		explicit FuzzyContext(const FlatFuzzyModule& module);
+
+		/*!*****************************************************************************
+		\brief
+			Returns the DOM of a set.
+		\param set
+			Index of the set.
+		\return
+			The DOM.
+		*******************************************************************************/
+		float getDOM(std::uint32_t set) const
+		{
+			return doms[set];
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the number of rules evaluated by firings in the context.
+		\return
+			Rules evaluated since the last resetStats.
+		*******************************************************************************/
+		std::uint64_t getRulesFired() const
+		{
+			return rulesFired;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Sets the count of rules evaluated back to 0.
+		*******************************************************************************/
+		void resetStats()
+		{
+			rulesFired = 0;
+		}
+	};
+
+	// Fuzzy module compiled into arrays
+	//     The sets of every variable are stored next to each other in the
+	//     order of the variable's map, so a variable refers to them by the
+	//     index of its first set and a count. Sets used by rules that belong
+	//     to no variable are kept after them. DOMs live in a FuzzyContext, in
+	//     one array indexed like the sets; the calls without a context read
+	//     and write the module's own context, and only they change the module.
+	class FlatFuzzyModule
+	{
+		friend class FuzzyContext;
+		friend class RuleLoader;
+
+	public:
+		// A compiled set; edges and slopes are computed once with the same
+		// float operations calculateDOM uses, so memberships are identical
+		struct FlatSet
+		{
+			FuzzyShape shape;
+			bool degenerate;		// An offset is 0, so the peak itself has membership 1
+			float peak;
+			float leftEdge;			// peakPoint - leftOffset
+			float rightEdge;		// peakPoint + rightOffset
+			float rise;				// 1 / leftOffset
+			float fall;				// 1 / -rightOffset
+			float representative;	// Value used by max average defuzzification
+		};
+
+		// A compiled variable
+		struct FlatVariable
+		{
+			std::uint32_t first;	// Index of the first set
+			std::uint32_t count;	// Number of sets
+			float minRange;
+			float maxRange;
+		};
+
+		// A compiled rule: IF logic(terms) THEN consequent
+		struct FlatRule
+		{
+			FuzzyLogic logic;			// How the terms are combined
+			std::uint32_t first;		// Index of the first term in terms
+			std::uint32_t count;		// Number of terms
+			std::uint32_t consequent;	// Index of the consequent set
+		};
+
+	private:
+		std::vector<FlatSet> sets;
+		std::vector<FlatVariable> variables;	// In the order of the module's map
+		std::vector<std::string> names;			// Name of every variable
+		std::vector<FlatRule> rules;			// In the order they were added
+		std::vector<std::uint32_t> terms;		// Set indices of every rule's antecedent
+		std::vector<std::uint32_t> consequents;	// Consequent sets of every rule, in rule order
+		std::vector<float> compiledDOMs;		// DOM of every set when compiled, where every context starts
+		std::vector<std::uint32_t> usedFirst;	// Rules whose antecedent uses set s are
+		std::vector<std::uint32_t> usedBy;		//     usedBy[usedFirst[s]] to usedBy[usedFirst[s + 1] - 1]
+		std::vector<std::uint32_t> firedFirst;	// Rules whose consequent is set s are
+		std::vector<std::uint32_t> firedBy;		//     firedBy[firedFirst[s]] to firedBy[firedFirst[s + 1] - 1]
+		bool chained;							// An antecedent uses a consequent, so rules fire in order
+		int numSamples;							// Cross-sections of centroid defuzzification
+		FuzzyContext own;						// DOMs of the calls without a context, which fire every rule
+
+		/*!*****************************************************************************
+		\brief
+			Tabulates the rules that use and fire every set, once the rules are
+			in place, and resets the module's own context.
+		*******************************************************************************/
+		void link();
+
+		/*!*****************************************************************************
+		\brief
+			Calculates the DOMs of all sets of a variable for a crisp value.
+		\param doms
+			DOM of every set.
+		\param variable
+			Index of the variable.
+		\param val
+			Value to fuzzify.
+		*******************************************************************************/
+		void fuzzify(float* doms, std::uint32_t variable, float val) const;
+
+		/*!*****************************************************************************
+		\brief
+			Fires every rule, after clearing the consequents.
+		\param doms
+			DOM of every set.
+		*******************************************************************************/
+		void fire(float* doms) const;
+
+		/*!*****************************************************************************
+		\brief
+			Calculates the firing strength of a rule: the AND or OR of the DOMs of
+			its antecedent sets.
+		\param doms
+			DOM of every set.
+		\param rule
+			The rule.
+		\return
+			The firing strength.
+		*******************************************************************************/
+		float strength(const float* doms, const FlatRule& rule) const;
+
+		/*!*****************************************************************************
+		\brief
+			Marks the rules that use a set, and the set itself if it is a
+			consequent, to be fired again in a context.
+		\param context
+			The evaluation's DOMs.
+		\param set
+			Index of the set whose DOM changed.
+		*******************************************************************************/
+		void markChanged(FuzzyContext& context, std::uint32_t set) const;
+
+		/*!*****************************************************************************
+		\brief
+			Defuzzifies a variable of fired DOMs.
+		\param doms
+			DOM of every set.
+		\param variable
+			Index of the variable.
+		\param method
+			Defuzzification method to use.
+		\return
+			Defuzzified crisp value.
+		*******************************************************************************/
+		float deFuzzify(const float* doms, std::uint32_t variable, FuzzyModule::DefuzzifyMethod method) const;
+
+		/*!*****************************************************************************
+		\brief
+			Defuzzifies a variable with the maximum average method.
+		\param doms
+			DOM of every set.
+		\param variable
+			Index of the variable.
+		\return
+			Defuzzified crisp value.
+		*******************************************************************************/
+		float deFuzzifyMaxAv(const float* doms, std::uint32_t variable) const;
+
+		/*!*****************************************************************************
+		\brief
+			Defuzzifies a variable with the centroid method.
+		\param doms
+			DOM of every set.
+		\param variable
+			Index of the variable.
+		\return
+			Defuzzified crisp value.
+		*******************************************************************************/
+		float deFuzzifyCentroid(const float* doms, std::uint32_t variable) const;
+
+		/*!*****************************************************************************
+		\brief
+			Defuzzifies a variable with the exact centroid of its clipped sets.
+		\param doms
+			DOM of every set.
+		\param variable
+			Index of the variable.
+		\return
+			Defuzzified crisp value.
+		*******************************************************************************/
+		float deFuzzifyExactCentroid(const float* doms, std::uint32_t variable) const;
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Compiles a finished module. Later changes to the module are not seen.
+		\param module
+			The module; its current DOMs are copied as the compiled DOMs.
+		*******************************************************************************/
+		explicit FlatFuzzyModule(const FuzzyModule& module);
+
+		/*!*****************************************************************************
+		\brief
+			Creates an empty module, to be filled by RuleLoader.
+		*******************************************************************************/
+		FlatFuzzyModule();
+
+		/*!*****************************************************************************
+		\brief
+			Compiles a set from the bounds and peak the FuzzyVariable add
+			functions take, with the same float operations.
+		\param shape
+			Shape of the set.
+		\param minBound
+			Minimum bound of the set.
+		\param peak
+			Peak value.
+		\param maxBound
+			Maximum bound of the set.
+		\return
+			The compiled set.
+		*******************************************************************************/
+		static FlatSet makeSet(FuzzyShape shape, float minBound, float peak, float maxBound);
+
+		/*!*****************************************************************************
+		\brief
+			Returns the index of a variable, to be looked up once and kept.
+		\param name
+			Name of the variable.
+		\return
+			Index of the variable, or -1 if the module has none by that name.
+		*******************************************************************************/
+		int getVariableIndex(const std::string& name) const;
+
+		/*!*****************************************************************************
+		\brief
+			Calculates the DOMs of all sets of a variable for a crisp value in the
+			module's own context.
+		\param variable
+			Index of the variable.
+		\param val
+			Value to fuzzify.
+		*******************************************************************************/
+		void fuzzify(std::uint32_t variable, float val)
+		{
+			fuzzify(own.doms.data(), variable, val);
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Calculates the DOMs of all sets of a variable for a crisp value in a
+			context, and marks the rules that use a set whose DOM changed; the
+			module is not changed.
+		\param context
+			The evaluation's DOMs.
+		\param variable
+			Index of the variable.
+		\param val
+			Value to fuzzify.
+		*******************************************************************************/
+		void fuzzify(FuzzyContext& context, std::uint32_t variable, float val) const;
+
+		/*!*****************************************************************************
+		\brief
+			Fires every rule in the module's own context, after clearing the
+			consequents.
+		*******************************************************************************/
+		void fire()
+		{
+			fire(own.doms.data());
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Fires the rules of a context whose antecedents changed since its last
+			firing, the first time every rule; the module is not changed. The
+			consequents end up as they would after fire.
+		\param context
+			The evaluation's DOMs.
+		*******************************************************************************/
+		void fire(FuzzyContext& context) const;
+
+		/*!*****************************************************************************
+		\brief
+			Fires every rule and defuzzifies a variable in the module's own
+			context, like FuzzyModule::deFuzzify.
+		\param variable
+			Index of the variable.
+		\param method
+			Defuzzification method to use.
+		\return
+			Defuzzified crisp value.
+		*******************************************************************************/
+		float deFuzzify(std::uint32_t variable, FuzzyModule::DefuzzifyMethod method)
+		{
+			fire();
+			return deFuzzify(own.doms.data(), variable, method);
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Fires the changed rules and defuzzifies a variable in a context; the
+			module is not changed.
+		\param context
+			The evaluation's DOMs.
+		\param variable
+			Index of the variable.
+		\param method
+			Defuzzification method to use.
+		\return
+			Defuzzified crisp value.
+		*******************************************************************************/
+		float deFuzzify(FuzzyContext& context, std::uint32_t variable, FuzzyModule::DefuzzifyMethod method) const
+		{
+			fire(context);
+			return deFuzzify(context.doms.data(), variable, method);
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Fires every rule once in the module's own context and defuzzifies
+			several variables from the same consequents.
+		\param outputs
+			Indices of the variables.
+		\param method
+			Defuzzification method to use.
+		\param results
+			Receives the crisp value of every variable, in the order of outputs.
+		*******************************************************************************/
+		void deFuzzify(const std::vector<std::uint32_t>& outputs, FuzzyModule::DefuzzifyMethod method, float* results)
+		{
+			fire();
+			for (std::size_t i = 0; i < outputs.size(); ++i)
+				results[i] = deFuzzify(own.doms.data(), outputs[i], method);
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Fires the changed rules of a context once and defuzzifies several
+			variables from the same consequents; the module is not changed.
+		\param context
+			The evaluation's DOMs.
+		\param outputs
+			Indices of the variables.
+		\param method
+			Defuzzification method to use.
+		\param results
+			Receives the crisp value of every variable, in the order of outputs.
+		*******************************************************************************/
+		void deFuzzify(FuzzyContext& context, const std::vector<std::uint32_t>& outputs,
+			FuzzyModule::DefuzzifyMethod method, float* results) const
+		{
+			fire(context);
+			for (std::size_t i = 0; i < outputs.size(); ++i)
+				results[i] = deFuzzify(context.doms.data(), outputs[i], method);
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Defuzzifies a variable with the maximum average method in the module's
+			own context, without firing the rules.
+		\param variable
+			Index of the variable.
+		\return
+			Defuzzified crisp value.
+		*******************************************************************************/
+		float deFuzzifyMaxAv(std::uint32_t variable) const
+		{
+			return deFuzzifyMaxAv(own.doms.data(), variable);
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Defuzzifies a variable of a context, without firing the rules.
+		\param context
+			The evaluation's DOMs.
+		\param variable
+			Index of the variable.
+		\return
+			Defuzzified crisp value.
+		*******************************************************************************/
+		float deFuzzifyMaxAv(const FuzzyContext& context, std::uint32_t variable) const
+		{
+			return deFuzzifyMaxAv(context.doms.data(), variable);
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Defuzzifies a variable with the centroid method in the module's own
+			context, without firing the rules.
+		\param variable
+			Index of the variable.
+		\return
+			Defuzzified crisp value.
+		*******************************************************************************/
+		float deFuzzifyCentroid(std::uint32_t variable) const
+		{
+			return deFuzzifyCentroid(own.doms.data(), variable);
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Defuzzifies a variable of a context, without firing the rules.
+		\param context
+			The evaluation's DOMs.
+		\param variable
+			Index of the variable.
+		\return
+			Defuzzified crisp value.
+		*******************************************************************************/
+		float deFuzzifyCentroid(const FuzzyContext& context, std::uint32_t variable) const
+		{
+			return deFuzzifyCentroid(context.doms.data(), variable);
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Defuzzifies a variable with the exact centroid of its sets clipped at
+			their DOMs in the module's own context, without firing the rules.
+		\param variable
+			Index of the variable.
+		\return
+			Defuzzified crisp value.
+		*******************************************************************************/
+		float deFuzzifyExactCentroid(std::uint32_t variable) const
+		{
+			return deFuzzifyExactCentroid(own.doms.data(), variable);
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Defuzzifies a variable of a context, without firing the rules.
+		\param context
+			The evaluation's DOMs.
+		\param variable
+			Index of the variable.
+		\return
+			Defuzzified crisp value.
+		*******************************************************************************/
+		float deFuzzifyExactCentroid(const FuzzyContext& context, std::uint32_t variable) const
+		{
+			return deFuzzifyExactCentroid(context.doms.data(), variable);
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Computes a 64-bit FNV-1a hash of the rule base: every set, variable
+			range and rule, and the centroid sample count, but not the DOMs.
+		\return
+			The hash, never 0.
+		*******************************************************************************/
+		std::uint64_t getHash() const;
+
+		/*!*****************************************************************************
+		\brief
+			Returns the DOM of a set in the module's own context.
+		\param set
+			Index of the set.
+		\return
+			The DOM.
+		*******************************************************************************/
+		float getDOM(std::uint32_t set) const
+		{
+			return own.doms[set];
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the module's own context, the DOMs of the calls without one,
+			to freeze the variables a batch or table does not fuzzify.
+		\return
+			Reference to the context.
+		*******************************************************************************/
+		const FuzzyContext& getContext() const
+		{
+			return own;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the compiled sets.
+		\return
+			Reference to the sets.
+		*******************************************************************************/
+		const std::vector<FlatSet>& getSets() const
+		{
+			return sets;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the compiled variables.
+		\return
+			Reference to the variables.
+		*******************************************************************************/
+		const std::vector<FlatVariable>& getVariables() const
+		{
+			return variables;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the compiled rules.
+		\return
+			Reference to the rules.
+		*******************************************************************************/
+		const std::vector<FlatRule>& getRules() const
+		{
+			return rules;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the set indices of all antecedents.
+		\return
+			Reference to the terms.
+		*******************************************************************************/
+		const std::vector<std::uint32_t>& getTerms() const
+		{
+			return terms;
+		}
+
+		/*!*****************************************************************************
+		\brief
+			Returns the number of cross-sections sampled by centroid defuzzification.
+		\return
+			The sample count.
+		*******************************************************************************/
+		int getNumSamples() const
+		{
+			return numSamples;
+		}
+	};
+
+	/*!*****************************************************************************
+	\brief
+		Calculates the degree of membership of a value in a compiled set, with
+		the same comparisons and float operations as the set's calculateDOM.
+	\param set
+		The set.
+	\param val
+		Value to evaluate.
+	\return
+		Degree of membership in [0, 1].
+	*******************************************************************************/
+	inline float calculateDOM(const FlatFuzzyModule::FlatSet& set, float val)
+	{
+		switch (set.shape)
+		{
+		case FuzzyShape::LeftShoulder:
+			if (set.degenerate && isEqual(set.peak, val))
+				return 1.0f;
+			if (val < set.peak && val >= set.leftEdge)
+				return 1.0f;
+			if (val >= set.peak && val < set.rightEdge)
+				return set.fall * (val - set.peak) + 1.0f;
+			return 0.0f;
+
+		case FuzzyShape::RightShoulder:
+			if (set.degenerate && isEqual(set.peak, val))
+				return 1.0f;
+			if (val <= set.peak && val > set.leftEdge)
+				return set.rise * (val - set.leftEdge);
+			if (val > set.peak && val <= set.rightEdge)
+				return 1.0f;
+			return 0.0f;
+
+		case FuzzyShape::Singleton:
+			return val >= set.leftEdge && val <= set.rightEdge ? 1.0f : 0.0f;
+
+		case FuzzyShape::Triangle:
+			if (set.degenerate && isEqual(set.peak, val))
+				return 1.0f;
+			if (val <= set.peak && val >= set.leftEdge)
+				return set.rise * (val - set.leftEdge);
+			if (val > set.peak && val < set.rightEdge)
+				return set.fall * (val - set.peak) + 1.0f;
+			return 0.0f;
+
+		default:
+			return 0.0f;
+		}
+	}
+
+	/*!*****************************************************************************
+	\brief
+		Returns a compiled set clipped at a confidence, for exact centroid
+		defuzzification.
+	\param set
+		The set.
+	\param confidence
+		DOM the set is clipped at.
+	\return
+		The clipped set.
+	*******************************************************************************/
+	inline ClippedSet clip(const FlatFuzzyModule::FlatSet& set, float confidence)
+	{
+		return ClippedSet{ set.shape, set.leftEdge, set.peak, set.rightEdge, confidence };
+	}
+
+} // end namespace
+
+#endif
@@ -1,21 +1,186 @@
-/*!*****************************************************************************
-\file      functions.cpp
-\author    Vadim Surov, Jie Le Jet Ang
-\par       DP email: jielejet.ang@digipen.edu.sg
-\par       Course: CS3183
-\par       Section: A
-\par       Programming Assignment 11
-\date      07-16-2025
-
-\brief
-    This file is part of the Fuzzy Logic Assignment. Currently, all
-    implementations are located in functions.h. This source file is
-    reserved for any future logic if required.
-*******************************************************************************/
-#include "functions.h"
-
-namespace AI
-{
-
-
-} // end namespace
\ No newline at end of file
+/*!*****************************************************************************
+\file      functions.cpp
+\author    Vadim Surov, Jie Le Jet Ang
+\par       DP email: jielejet.ang@digipen.edu.sg
+\par       Course: CS3183
+\par       Section: A
+\par       Programming Assignment 11
+\date      07-16-2025
+
+\brief
+    This file is part of the Fuzzy Logic Assignment. Most implementations are
+    located in functions.h; this source file holds the exact centroid
+    defuzzification, which integrates the sum of the clipped sets instead of
+    sampling it.
+*******************************************************************************/
+#include "functions.h"
+
+#include <algorithm>
+
+namespace AI
+{
+    namespace
+    {
+        // Most variables have a handful of sets, so their breakpoints fit on the stack
+        const std::size_t SMALL_POINTS = 64;
+
+        /*!*****************************************************************************
+        \brief
+            Returns the line a clipped set follows between two neighbouring
+            breakpoints, from the region the middle of the interval lies in.
+        \param set
+            The clipped set.
+        \param mid
+            Middle of the interval.
+        \param value
+            Receives the value of the line at mid.
+        \param slope
+            Receives the slope of the line.
+        *******************************************************************************/
+        void linePiece(const ClippedSet& set, double mid, double& value, double& slope)
+        {
+            double left = set.leftEdge, peak = set.peak, right = set.rightEdge;
+            value = 0.0;
+            slope = 0.0;
+
+            bool rises = set.shape == FuzzyShape::RightShoulder || set.shape == FuzzyShape::Triangle;
+            bool falls = set.shape == FuzzyShape::LeftShoulder || set.shape == FuzzyShape::Triangle;
+            if (set.shape == FuzzyShape::Singleton)
+            {
+                if (mid >= left && mid <= right)
+                    value = 1.0;
+            }
+            else if (mid > left && mid < peak)
+            {
+                if (rises)
+                {
+                    slope = 1.0 / (peak - left);
+                    value = (mid - left) * slope;
+                }
+                else if (set.shape == FuzzyShape::LeftShoulder)
+                    value = 1.0;
+            }
+            else if (mid > peak && mid < right)
+            {
+                if (falls)
+                {
+                    slope = -1.0 / (right - peak);
+                    value = 1.0 + (mid - peak) * slope;
+                }
+                else if (set.shape == FuzzyShape::RightShoulder)
+                    value = 1.0;
+            }
+
+            if (value >= set.confidence)
+            {
+                value = set.confidence;
+                slope = 0.0;
+            }
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Adds the area and moment under a straight segment.
+        \param x0
+            Start of the segment.
+        \param y0
+            Height at the start.
+        \param x1
+            End of the segment.
+        \param y1
+            Height at the end.
+        \param area
+            Receives the added area.
+        \param moment
+            Receives the added moment about 0.
+        *******************************************************************************/
+        void addSegment(double x0, double y0, double x1, double y1, double& area, double& moment)
+        {
+            double width = x1 - x0;
+            area += 0.5 * (y0 + y1) * width;
+            moment += width / 6.0 * (x0 * (2.0 * y0 + y1) + x1 * (y0 + 2.0 * y1));
+        }
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Calculates the exact centroid of clipped sets aggregated by sum, as the centroid method samples them: the
+        curve integrated is the sum of every set's membership clipped at its confidence. Every set is straight between
+        its edges, its peak and the points where it crosses its confidence, so between two neighbouring breakpoints of
+        all sets the sum is one line, whose area and moment are exact. The cost is O(sets x breakpoints); the sums are
+        kept in double.
+    \param sets
+        The clipped sets.
+    \param count
+        Number of sets.
+    \param minRange
+        Lower end of the range.
+    \param maxRange
+        Upper end of the range.
+    \return
+        The centroid, or 0 if the sum has no area.
+    *******************************************************************************/
+    float exactCentroid(const ClippedSet* sets, std::size_t count, float minRange, float maxRange)
+    {
+        double smallPoints[SMALL_POINTS];
+        std::vector<double> largePoints;
+        double* points = smallPoints;
+        if (count * 5 + 2 > SMALL_POINTS)
+        {
+            largePoints.resize(count * 5 + 2);
+            points = largePoints.data();
+        }
+
+        std::size_t n = 0;
+        auto addPoint = [&](double x)
+            {
+                if (x > minRange && x < maxRange)
+                    points[n++] = x;
+            };
+        points[n++] = minRange;
+        points[n++] = maxRange;
+        for (std::size_t s = 0; s < count; ++s)
+        {
+            const ClippedSet& set = sets[s];
+            if (set.confidence <= 0.0f || set.shape == FuzzyShape::None)
+                continue;
+            addPoint(set.leftEdge);
+            addPoint(set.peak);
+            addPoint(set.rightEdge);
+            if (set.confidence < 1.0f)
+            {
+                double c = set.confidence;
+                if (set.shape == FuzzyShape::RightShoulder || set.shape == FuzzyShape::Triangle)
+                    addPoint(set.leftEdge + c * (static_cast<double>(set.peak) - set.leftEdge));
+                if (set.shape == FuzzyShape::LeftShoulder || set.shape == FuzzyShape::Triangle)
+                    addPoint(set.peak + (1.0 - c) * (static_cast<double>(set.rightEdge) - set.peak));
+            }
+        }
+        std::sort(points, points + n);
+
+        double area = 0.0, moment = 0.0;
+        for (std::size_t p = 0; p + 1 < n; ++p)
+        {
+            double a = points[p], b = points[p + 1];
+            if (!(b > a))
+                continue;
+
+            // Value at the middle and slope of the sum of every set's line on (a, b)
+            double mid = 0.5 * (a + b);
+            double value = 0.0, slope = 0.0;
+            for (std::size_t s = 0; s < count; ++s)
+                if (sets[s].confidence > 0.0f && mid >= sets[s].leftEdge && mid <= sets[s].rightEdge)
+                {
+                    double setValue = 0.0, setSlope = 0.0;
+                    linePiece(sets[s], mid, setValue, setSlope);
+                    value += setValue;
+                    slope += setSlope;
+                }
+            addSegment(a, value + slope * (a - mid), b, value + slope * (b - mid), area, moment);
+        }
+
+        if (isEqual(0.0f, static_cast<float>(area)))
+            return 0.0f;
+        return static_cast<float>(moment / area);
+    }
+} // end namespace
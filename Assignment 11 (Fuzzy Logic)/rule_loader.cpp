@@ -0,0 +1,488 @@
+/*!*****************************************************************************
+\file      rule_loader.cpp
+\author    Jie Le Jet Ang
+\par       DP email: jielejet.ang@digipen.edu.sg
+\par       Course: CS3183
+\par       Section: A
+\par       Programming Assignment 11
+\date      10-18-2026
+
+\brief
+    Implements RuleLoader: a single pass over the text that keeps names as
+    views into it, then the layout of the compiled module.
+*******************************************************************************/
+#include "rule_loader.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string_view>
+#include <unordered_map>
+
+namespace AI
+{
+    // Recursive descent parser over the text of a definition
+    struct RuleLoader::Parser
+    {
+        // A set as written
+        struct SetSpec
+        {
+            std::string_view name;
+            FuzzyShape shape;
+            float minBound;
+            float peak;
+            float maxBound;
+        };
+
+        // A variable as written; its range grows from 0 to fit every set, as in FuzzyVariable
+        struct VariableSpec
+        {
+            std::string_view name;
+            std::vector<SetSpec> sets;
+            float minRange;
+            float maxRange;
+        };
+
+        // A set named by a rule
+        struct TermSpec
+        {
+            std::uint32_t variable;
+            std::uint32_t set;
+        };
+
+        // A rule as written
+        struct RuleSpec
+        {
+            FuzzyLogic logic;
+            std::uint32_t first;	// Index of the first term in terms
+            std::uint32_t count;
+            TermSpec consequent;
+        };
+
+        RuleLoader& loader;
+        const char* p;
+        const char* end;
+        int line;
+        int samples;
+        std::vector<VariableSpec> variables;
+        std::unordered_map<std::string_view, std::uint32_t> variableIndex;
+        std::vector<TermSpec> terms;
+        std::vector<RuleSpec> rules;
+
+        /*!*****************************************************************************
+        \brief
+            Records a parse error at the current line.
+        \param message
+            What is wrong.
+        \return
+            False.
+        *******************************************************************************/
+        bool fail(const std::string& message)
+        {
+            loader.error = "line " + std::to_string(line) + ": " + message;
+            return false;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Describes what the parser stopped at, for error messages.
+        \return
+            The next word or character in quotes, or "end of file".
+        *******************************************************************************/
+        std::string found()
+        {
+            if (p == end)
+                return "end of file";
+            const char* b = p;
+            while (b < end && (std::isalnum(static_cast<unsigned char>(*b)) || *b == '_'))
+                ++b;
+            return "'" + std::string(p, b > p ? b : p + 1) + "'";
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Skips spaces, line breaks and comments (# or // to the end of the line).
+        *******************************************************************************/
+        void skip()
+        {
+            while (p < end)
+            {
+                if (*p == '\n')
+                    ++line;
+                if (*p == '#' || (*p == '/' && p + 1 < end && p[1] == '/'))
+                    while (p < end && *p != '\n')
+                        ++p;
+                else if (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')
+                    ++p;
+                else
+                    break;
+            }
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Reads a name made of letters, digits and underscores.
+        \param out
+            Receives a view of the name in the text.
+        \return
+            True if a name was read.
+        *******************************************************************************/
+        bool name(std::string_view& out)
+        {
+            skip();
+            const char* b = p;
+            while (p < end && (std::isalnum(static_cast<unsigned char>(*p)) || *p == '_'))
+                ++p;
+            out = std::string_view(b, static_cast<std::size_t>(p - b));
+            return p > b;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Reads a keyword if it is the next word, ignoring case.
+        \param word
+            The keyword in upper case.
+        \return
+            True if the keyword was read.
+        *******************************************************************************/
+        bool keyword(const char* word)
+        {
+            skip();
+            const char* q = p;
+            for (; *word; ++word, ++q)
+                if (q == end || std::toupper(static_cast<unsigned char>(*q)) != *word)
+                    return false;
+            if (q < end && (std::isalnum(static_cast<unsigned char>(*q)) || *q == '_'))
+                return false;
+            p = q;
+            return true;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Reads a character if it is the next one.
+        \param c
+            The character.
+        \return
+            True if the character was read.
+        *******************************************************************************/
+        bool symbol(char c)
+        {
+            skip();
+            if (p == end || *p != c)
+                return false;
+            ++p;
+            return true;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Reads a number.
+        \param out
+            Receives the number.
+        \return
+            True if a number was read.
+        *******************************************************************************/
+        bool number(float& out)
+        {
+            skip();
+            char* after = nullptr;
+            out = std::strtof(p, &after);
+            if (after == p || after > end)
+                return false;
+            p = after;
+            return true;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Reads "Name = Shape(min, peak, max)" inside a variable.
+        \param variable
+            The variable the set belongs to.
+        \return
+            True on success.
+        *******************************************************************************/
+        bool set(VariableSpec& variable)
+        {
+            SetSpec spec{};
+            std::string_view shape;
+            if (!name(spec.name))
+                return fail("expected a set name or '}', found " + found());
+            for (const SetSpec& other : variable.sets)
+                if (other.name == spec.name)
+                    return fail("set '" + std::string(spec.name) + "' of " + std::string(variable.name)
+                        + " is defined twice");
+            if (!symbol('='))
+                return fail("expected '=' after set " + std::string(spec.name));
+            if (!name(shape))
+                return fail("expected the shape of set " + std::string(spec.name));
+            if (shape == "LeftShoulder")
+                spec.shape = FuzzyShape::LeftShoulder;
+            else if (shape == "RightShoulder")
+                spec.shape = FuzzyShape::RightShoulder;
+            else if (shape == "Triangle")
+                spec.shape = FuzzyShape::Triangle;
+            else if (shape == "Singleton")
+                spec.shape = FuzzyShape::Singleton;
+            else
+                return fail("unknown shape '" + std::string(shape) + "'");
+
+            if (!symbol('(') || !number(spec.minBound) || !symbol(',') || !number(spec.peak) || !symbol(',')
+                || !number(spec.maxBound) || !symbol(')'))
+                return fail(std::string(shape) + " takes (minimum, peak, maximum)");
+            if (!(spec.minBound <= spec.peak && spec.peak <= spec.maxBound))
+                return fail("set " + std::string(spec.name) + " needs minimum <= peak <= maximum");
+
+            variable.minRange = std::min(variable.minRange, spec.minBound);
+            variable.maxRange = std::max(variable.maxRange, spec.maxBound);
+            variable.sets.push_back(spec);
+            return true;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Reads "variable Name { sets }", after the keyword.
+        \return
+            True on success.
+        *******************************************************************************/
+        bool variable()
+        {
+            VariableSpec spec{ {}, {}, 0.0f, 0.0f };
+            if (!name(spec.name))
+                return fail("expected a variable name, found " + found());
+            if (variableIndex.count(spec.name))
+                return fail("variable '" + std::string(spec.name) + "' is defined twice");
+            if (!symbol('{'))
+                return fail("expected '{' after variable " + std::string(spec.name));
+            int at = line;
+            while (!symbol('}'))
+            {
+                if (p == end)
+                {
+                    line = at;
+                    return fail("missing '}' of variable " + std::string(spec.name));
+                }
+                if (!set(spec))
+                    return false;
+            }
+            variableIndex.emplace(spec.name, static_cast<std::uint32_t>(variables.size()));
+            variables.push_back(std::move(spec));
+            return true;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Reads "Variable IS Set".
+        \param term
+            Receives the variable and set.
+        \return
+            True on success.
+        *******************************************************************************/
+        bool term(TermSpec& term)
+        {
+            std::string_view variableName, setName;
+            if (!name(variableName))
+                return fail("expected a variable name, found " + found());
+            auto index = variableIndex.find(variableName);
+            if (index == variableIndex.end())
+                return fail("unknown variable '" + std::string(variableName) + "'");
+            if (!keyword("IS"))
+                return fail("expected IS after " + std::string(variableName));
+            if (!name(setName))
+                return fail("expected a set of " + std::string(variableName));
+
+            const std::vector<SetSpec>& sets = variables[index->second].sets;
+            for (std::uint32_t s = 0; s < sets.size(); ++s)
+                if (sets[s].name == setName)
+                {
+                    term = TermSpec{ index->second, s };
+                    return true;
+                }
+            return fail(std::string(variableName) + " has no set '" + std::string(setName) + "'");
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Reads "IF term (AND|OR term)... THEN term", after the IF. A rule of
+            one term is an AND of that term.
+        \return
+            True on success.
+        *******************************************************************************/
+        bool rule()
+        {
+            RuleSpec spec{ FuzzyLogic::AND, static_cast<std::uint32_t>(terms.size()), 0, {} };
+            bool joined = false;
+            for (;;)
+            {
+                TermSpec t{};
+                if (!term(t))
+                    return false;
+                terms.push_back(t);
+                ++spec.count;
+
+                FuzzyLogic logic = FuzzyLogic::None;
+                if (keyword("AND"))
+                    logic = FuzzyLogic::AND;
+                else if (keyword("OR"))
+                    logic = FuzzyLogic::OR;
+                else
+                    break;
+                if (joined && logic != spec.logic)
+                    return fail("a rule cannot mix AND and OR");
+                spec.logic = logic;
+                joined = true;
+            }
+            if (!keyword("THEN"))
+                return fail("expected AND, OR or THEN, found " + found());
+            if (!term(spec.consequent))
+                return false;
+            rules.push_back(spec);
+            return true;
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Reads every statement of the text.
+        \return
+            True on success.
+        *******************************************************************************/
+        bool file()
+        {
+            for (;;)
+            {
+                skip();
+                if (p == end)
+                    return true;
+
+                if (keyword("VARIABLE"))
+                {
+                    if (!variable())
+                        return false;
+                }
+                else if (keyword("IF"))
+                {
+                    if (!rule())
+                        return false;
+                }
+                else if (keyword("SAMPLES"))
+                {
+                    float count = 0.0f;
+                    if (!number(count) || count < 1.0f || count != static_cast<int>(count))
+                        return fail("samples takes a positive whole number");
+                    samples = static_cast<int>(count);
+                }
+                else
+                    return fail("expected variable, IF or samples, found " + found());
+            }
+        }
+
+        /*!*****************************************************************************
+        \brief
+            Lays out the module like one compiled from a FuzzyModule: variables
+            and the sets of every variable ordered by name, as in their maps,
+            and rules in the order they were written.
+        \param module
+            Receives the module.
+        *******************************************************************************/
+        void build(FlatFuzzyModule& module)
+        {
+            std::vector<std::uint32_t> order(variables.size());
+            for (std::uint32_t v = 0; v < order.size(); ++v)
+                order[v] = v;
+            std::sort(order.begin(), order.end(),
+                [&](std::uint32_t a, std::uint32_t b) { return variables[a].name < variables[b].name; });
+
+            // Index of every written set in the module, by variable as written
+            std::vector<std::vector<std::uint32_t>> setIndex(variables.size());
+            for (std::uint32_t v : order)
+            {
+                const VariableSpec& spec = variables[v];
+                std::vector<std::uint32_t> byName(spec.sets.size());
+                for (std::uint32_t s = 0; s < byName.size(); ++s)
+                    byName[s] = s;
+                std::sort(byName.begin(), byName.end(),
+                    [&](std::uint32_t a, std::uint32_t b) { return spec.sets[a].name < spec.sets[b].name; });
+
+                FlatFuzzyModule::FlatVariable flat{ static_cast<std::uint32_t>(module.sets.size()),
+                    static_cast<std::uint32_t>(spec.sets.size()), spec.minRange, spec.maxRange };
+                setIndex[v].resize(spec.sets.size());
+                for (std::uint32_t s : byName)
+                {
+                    const SetSpec& set = spec.sets[s];
+                    setIndex[v][s] = static_cast<std::uint32_t>(module.sets.size());
+                    module.sets.push_back(FlatFuzzyModule::makeSet(set.shape, set.minBound, set.peak, set.maxBound));
+                    module.compiledDOMs.push_back(0.0f);
+                }
+                module.variables.push_back(flat);
+                module.names.emplace_back(spec.name);
+            }
+
+            module.terms.reserve(terms.size());
+            for (const TermSpec& t : terms)
+                module.terms.push_back(setIndex[t.variable][t.set]);
+            module.rules.reserve(rules.size());
+            module.consequents.reserve(rules.size());
+            for (const RuleSpec& rule : rules)
+            {
+                std::uint32_t consequent = setIndex[rule.consequent.variable][rule.consequent.set];
+                module.rules.push_back(FlatFuzzyModule::FlatRule{ rule.logic, rule.first, rule.count, consequent });
+                module.consequents.push_back(consequent);
+            }
+            module.numSamples = samples;
+            module.link();
+        }
+    };
+
+    /*!*****************************************************************************
+    \brief
+        Builds a module from a text definition. The module is only replaced once the whole text has been read.
+    \param text
+        The definition.
+    \param module
+        Receives the module.
+    \return
+        True on success.
+    *******************************************************************************/
+    bool RuleLoader::parse(const std::string& text, FlatFuzzyModule& module)
+    {
+        error.clear();
+        Parser parser{ *this, text.data(), text.data() + text.size(), 1, 15, {}, {}, {}, {} };
+        if (!parser.file())
+            return false;
+
+        FlatFuzzyModule built;
+        parser.build(built);
+        module = std::move(built);
+        return true;
+    }
+
+    /*!*****************************************************************************
+    \brief
+        Builds a module from a definition file.
+    \param path
+        Path of the definition file.
+    \param module
+        Receives the module.
+    \return
+        True on success.
+    *******************************************************************************/
+    bool RuleLoader::load(const std::string& path, FlatFuzzyModule& module)
+    {
+        std::ifstream source(path, std::ios::binary);
+        if (!source)
+        {
+            error = "cannot read " + path;
+            return false;
+        }
+        std::ostringstream text;
+        text << source.rdbuf();
+        if (!parse(text.str(), module))
+        {
+            error = path + ", " + error;
+            return false;
+        }
+        return true;
+    }
+} // end namespace
@@ -0,0 +1,87 @@
+/*!*****************************************************************************
+\file      rule_loader.h
+\author    Jie Le Jet Ang
+\par       DP email: jielejet.ang@digipen.edu.sg
+\par       Course: CS3183
+\par       Section: A
+\par       Programming Assignment 11
+\date      10-18-2026
+
+\brief
+	Declares RuleLoader, which reads a fuzzy rule base from text straight
+	into a FlatFuzzyModule, instead of building it in C++ out of nested
+	make_shared calls. The module gets the same sets, variables and rules, in
+	the same order, as a FuzzyModule built from the same definitions and
+	compiled, so it evaluates to the same crisp outputs. A definition looks
+	like
+
+		# Comments run to the end of the line
+		samples 15
+		variable DistToTarget
+		{
+			Close = LeftShoulder(0, 25, 150)
+			Medium = Triangle(25, 150, 300)
+			Far = RightShoulder(150, 300, 1000)
+		}
+		IF DistToTarget IS Close AND AmmoStatus IS Low THEN Desirability IS Undesirable
+
+	Set shapes take their minimum bound, peak and maximum bound, like the
+	FuzzyVariable add functions; Singleton is the fourth shape. A rule joins
+	its terms with AND or OR, not both, and names only variables and sets
+	defined above it. Keywords are not case sensitive.
+*******************************************************************************/
+#ifndef RULE_LOADER_H
+#define RULE_LOADER_H
+
+#include <string>
+#include "flat_module.h"
+
+namespace AI
+{
+	// Loader of text fuzzy rule bases
+	class RuleLoader
+	{
+		std::string error;
+
+		struct Parser;
+
+	public:
+		/*!*****************************************************************************
+		\brief
+			Builds a module from a text definition.
+		\param text
+			The definition.
+		\param module
+			Receives the module; left unchanged on failure.
+		\return
+			True on success; otherwise getError() tells the line and the problem.
+		*******************************************************************************/
+		bool parse(const std::string& text, FlatFuzzyModule& module);
+
+		/*!*****************************************************************************
+		\brief
+			Builds a module from a definition file.
+		\param path
+			Path of the definition file.
+		\param module
+			Receives the module; left unchanged on failure.
+		\return
+			True on success; otherwise getError() tells the problem.
+		*******************************************************************************/
+		bool load(const std::string& path, FlatFuzzyModule& module);
+
+		/*!*****************************************************************************
+		\brief
+			Returns the message of the last failure.
+		\return
+			Reference to the message.
+		*******************************************************************************/
+		const std::string& getError() const
+		{
+			return error;
+		}
+	};
+
+} // end namespace
+
+#endif